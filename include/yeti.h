@@ -60,6 +60,8 @@
 #include "yeti/task.h"
 #include "yeti/task_scheduler.h"
 
+#include "yeti/parallel.h"
+
 namespace yeti {
 
 struct Config {
@@ -98,11 +98,20 @@ class YETI_PUBLIC TimeStepPolicy {
   u32 steps() const;
   f32 delta_time_per_step() const;
 
+  /// \brief Fraction of a step that is yet to be simulated.
+  ///
+  /// \detail Used to blend between the last two steps for presentation. For
+  /// fixed time-steps this is the accumulated remainder over the delta time
+  /// per step, otherwise steps cover all elapsed time and this is one.
+  ///
+  f32 alpha() const;
+
  private:
   Description desc_;
   State state_;
   u32 steps_;
   f32 delta_time_per_step_;
+  f32 alpha_;
 };
 
 YETI_INLINE const TimeStepPolicy::Description &TimeStepPolicy::desc() const {
@@ -117,6 +126,10 @@ YETI_INLINE f32 TimeStepPolicy::delta_time_per_step() const {
   return delta_time_per_step_;
 }
 
+YETI_INLINE f32 TimeStepPolicy::alpha() const {
+  return alpha_;
+}
+
 } // yeti
 
 #endif // _YETI_APPLICATION_TIME_STEP_POLICY_H_
@@ -192,6 +192,10 @@ namespace component_registry {
   extern YETI_PUBLIC void register_during_boot(const Component *component);
 
   /// Derives a component's identifier from its name.
+  ///
+  /// \note Identifiers of components known ahead of time can be derived at
+  /// compile time with `YETI_HASH`.
+  ///
   extern YETI_PUBLIC Component::Id id_from_name(const char *name);
 
   /// Looks up a component by identifier.
@@ -22,13 +22,16 @@
 #include "yeti/component.h"
 #include "yeti/system.h"
 
+#include "yeti/math.h"
+
 namespace yeti {
 
 struct Camera {
   /// Opaque handle to a camera component.
-  struct Handle {
-    u32 instance;
-  };
+  typedef Component::Handle Handle;
+
+  /// Transient handle to a camera component.
+  typedef Component::Instance Instance;
 
   /// Type of projection.
   enum Type {
@@ -63,6 +66,17 @@ struct Camera {
 namespace camera {
   extern YETI_PUBLIC Camera::Type type_from_string(const char *string);
   extern YETI_PUBLIC const char *type_to_string(const Camera::Type type);
+
+  /// \brief Builds the world-space viewing volume of @camera positioned and
+  /// oriented by @pose.
+  ///
+  /// \param @aspect Aspect ratio of the viewport, used by perspective cameras.
+  ///
+  /// \note Cameras look down negative z.
+  ///
+  extern YETI_PUBLIC Frustum frustum(const Camera &camera,
+                                     const Mat4 &pose,
+                                     const f32 aspect);
 }
 
 class YETI_PUBLIC CameraSystem : public System {
@@ -79,13 +93,19 @@ class YETI_PUBLIC CameraSystem : public System {
   /// \brief Destroys a particular camera.
   void destroy(Camera::Handle handle);
 
-  /// \brief Destroys all cameras associated with @entity.
+  /// \brief Destroys camera associated with @entity.
   void destroy(Entity entity);
 
-  /// \brief Returns a handle to a camera component associated with @entity.
-  Camera::Handle lookup(Entity entity, unsigned instance = 0);
+  /// \brief Returns a handle to the camera associated with @entity.
+  Camera::Handle lookup(Entity entity) const;
 
-  /// \brief Determines whether or not @entity has any associated cameras.
+  /// \brief Resolves an opaque @handle to a transient handle.
+  ///
+  /// \warning The resolved handle is only valid until a camera is destroyed.
+  ///
+  Camera::Instance resolve(Camera::Handle handle) const;
+
+  /// \brief Determines whether or not @entity has an associated camera.
   bool has(Entity entity) const;
 
   /// \brief Returns the type of projection used by a camera.
@@ -121,6 +141,11 @@ class YETI_PUBLIC CameraSystem : public System {
   /// \brief Returns a complete description of a camera.
   Camera describe(Camera::Handle handle) const;
 
+ private:
+  /// \internal Glue that ensures any associated cameras are destroyed when an
+  /// entity is destroyed.
+  void destroyed(Entity entity);
+
  public:
   /// \internal Description of this component.
   static const Component *component();
@@ -135,19 +160,43 @@ class YETI_PUBLIC CameraSystem : public System {
  private:
   EntityManager *entities_;
 
-  // As there are only a handful of cameras at any point in time, a map results
-  // in drastically less overhead at the cost of marginally more expensive
-  // lookups.
-  core::Map<Entity, u32> entity_to_instance_;
+  const unsigned limit_;
+
+  // Indexed by entity, so lookups are a single indirection.
+  core::Array<Camera::Instance> entity_to_instance_;
 
   // Used for reverse lookups.
   core::Array<Entity> instance_to_entity_;
 
-  core::Array<Camera> cameras_;
+  struct Box {
+    f32 top;
+    f32 left;
+    f32 bottom;
+    f32 right;
+  };
 
-  core::Array<u32> siblings_;
+  // Packed, so there are no holes.
+  core::Array<Camera::Type> types_;
+  core::Array<f32> fields_of_view_;
+  core::Array<Box> boxes_;
+  core::Array<f32> near_planes_;
+  core::Array<f32> far_planes_;
 };
 
+// Inlined to reduce cost of indirections.
+
+YETI_INLINE Camera::Handle CameraSystem::lookup(Entity entity) const {
+  return { entity.index() };
+}
+
+YETI_INLINE Camera::Instance CameraSystem::resolve(Camera::Handle handle) const {
+  return entity_to_instance_[handle.opaque];
+}
+
+YETI_INLINE bool CameraSystem::has(Entity entity) const {
+  return (entity_to_instance_[entity.index()].index != u32(-1));
+}
+
 } // yeti
 
 #endif // _YETI_COMPONENTS_CAMERA_H_
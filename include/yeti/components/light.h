@@ -74,9 +74,10 @@ struct SpotLight {
 /// A light source.
 struct Light {
   /// Opaque handle to a light component.
-  struct Handle {
-    u32 instance;
-  };
+  typedef Component::Handle Handle;
+
+  /// Transient handle to a light component.
+  typedef Component::Instance Instance;
 
   enum Type {
     UNKNOWN     = 0,
@@ -148,13 +149,19 @@ class YETI_PUBLIC LightSystem : public System {
   /// \brief Destroys a particular light.
   void destroy(Light::Handle handle);
 
-  /// \brief Destroys all lights associated with @entity.
+  /// \brief Destroys light associated with @entity.
   void destroy(Entity entity);
 
-  /// \brief Returns a handle to a light component associated with @entity.
-  Light::Handle lookup(Entity entity, unsigned instance = 0);
+  /// \brief Returns a handle to the light associated with @entity.
+  Light::Handle lookup(Entity entity) const;
+
+  /// \brief Resolves an opaque @handle to a transient handle.
+  ///
+  /// \warning The resolved handle is only valid until a light is destroyed.
+  ///
+  Light::Instance resolve(Light::Handle handle) const;
 
-  /// \brief Determines whether or not @entity has any associated lights.
+  /// \brief Determines whether or not @entity has an associated light.
   bool has(Entity entity) const;
 
   /// \brief Returns the type of a light.
@@ -223,6 +230,15 @@ class YETI_PUBLIC LightSystem : public System {
   /// \brief Returns a complete description of a light.
   Light describe(Light::Handle handle) const;
 
+  /// \brief Fills @entities with entities that have lights with all @flags
+  /// set.
+  void filter(u32 flags, core::Array<Entity> &entities) const;
+
+ private:
+  /// \internal Glue that ensures any associated lights are destroyed when an
+  /// entity is destroyed.
+  void destroyed(Entity entity);
+
  public:
   /// \internal Description of this component.
   static const Component *component();
@@ -237,19 +253,37 @@ class YETI_PUBLIC LightSystem : public System {
  private:
   EntityManager *entities_;
 
-  // As there are magnitudes less light than entities at any point in time, a
-  // map results in drastically less overhead at the cost of marginally more
-  // expensive lookups.
-  core::Map<Entity, u32> entity_to_instance_;
+  const unsigned limit_;
+
+  // Indexed by entity, so lookups are a single indirection.
+  core::Array<Light::Instance> entity_to_instance_;
 
   // Used for reverse lookups.
   core::Array<Entity> instance_to_entity_;
 
-  core::Array<Light> lights_;
-
-  core::Array<u32> siblings_;
+  // Packed, so there are no holes.
+  core::Array<Light::Type> types_;
+  core::Array<f32> radii_;
+  core::Array<f32> angles_;
+  core::Array<Color> colors_;
+  core::Array<f32> intensities_;
+  core::Array<u32> flags_;
 };
 
+// Inlined to reduce cost of indirections.
+
+YETI_INLINE Light::Handle LightSystem::lookup(Entity entity) const {
+  return { entity.index() };
+}
+
+YETI_INLINE Light::Instance LightSystem::resolve(Light::Handle handle) const {
+  return entity_to_instance_[handle.opaque];
+}
+
+YETI_INLINE bool LightSystem::has(Entity entity) const {
+  return (entity_to_instance_[entity.index()].index != u32(-1));
+}
+
 } // yeti
 
 #endif // _YETI_COMPONENTS_LIGHT_H_
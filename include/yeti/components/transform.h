@@ -192,6 +192,15 @@ class YETI_PUBLIC TransformSystem : public System {
   ///
   Mat4 get_world_pose(Transform::Instance instance);
 
+  /// \brief Gets the world-space pose of an transform, blended between the
+  /// last two updates.
+  ///
+  /// \note Only reflects the last call to `interpolate`.
+  ///
+  /// \see yeti::TransformSystem::interpolate
+  ///
+  Mat4 get_interpolated_world_pose(Transform::Instance instance);
+
  private:
   /// \internal Marks an instance and descendants as dirty and changed.
   void modified(Transform::Instance instance);
@@ -212,8 +221,24 @@ class YETI_PUBLIC TransformSystem : public System {
   ///
   void recompute(Transform::Instance instance);
 
+  /// \brief Blends world poses prior to and after the last update by @alpha
+  /// for presentation.
+  ///
+  /// \detail Translation and scale are linearly interpolated while rotation is
+  /// normalized-linearly interpolated. This lets simulation run at a lower
+  /// rate than presentation without judder.
+  ///
+  /// \param @alpha Zero for the pose prior and one for the pose after.
+  ///
+  void interpolate(const f32 alpha);
+
  private:
   /// \internal Destroys instances and recompacts.
+  ///
+  /// \detail Dead instances are swap-removed from the tail, and links are
+  /// fixed up to account for moved instances. This is deferred until enough
+  /// instances are dead, so dead instances may linger for a few frames.
+  ///
   void gc();
 
  public:
@@ -257,11 +282,17 @@ class YETI_PUBLIC TransformSystem : public System {
   core::Array<Mat4> local_poses_;
   core::Array<Mat4> world_poses_;
 
-  // PERF(mtwilliams): MEM(mtwilliams): Use bitsets.
-  core::Array<bool> dirty_;
-  core::Array<bool> changed_;
+  // World poses prior to the last update, and blended for presentation.
+  core::Array<Mat4> previous_world_poses_;
+  core::Array<Mat4> interpolated_world_poses_;
+
+  core::Bitset dirty_;
+  core::Bitset changed_;
+
+  // Created since the last update, so without a previous world pose.
+  core::Bitset fresh_;
 
-  // We defer destruction until the next frame.
+  // We defer destruction until enough instances are dead.
   core::Array<Transform::Instance> dead_;
 };
 
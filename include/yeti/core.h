@@ -46,20 +46,30 @@
 #include "yeti/core/allocators/global_page_allocator.h"
 #include "yeti/core/allocators/proxy_allocator.h"
 #include "yeti/core/allocators/bump_allocator.h"
+#include "yeti/core/allocators/frame_allocator.h"
 #include "yeti/core/allocators/buddy_allocator.h"
+#include "yeti/core/allocators/pool_allocator.h"
 #include "yeti/core/allocators/thread_safe/bump_allocator.h"
 #include "yeti/core/allocators/thread_safe/scratch_allocator.h"
+#include "yeti/core/allocators/thread_safe/pool_allocator.h"
 
 #include "yeti/core/algorithms/hash.h"
 #include "yeti/core/algorithms/digest.h"
 #include "yeti/core/algorithms/random.h"
+#include "yeti/core/algorithms/sort.h"
 
 #include "yeti/core/containers/list.h"
 #include "yeti/core/containers/array.h"
+#include "yeti/core/containers/small_array.h"
 #include "yeti/core/containers/stack.h"
 #include "yeti/core/containers/queue.h"
+#include "yeti/core/containers/spsc_queue.h"
+#include "yeti/core/containers/mpmc_queue.h"
 #include "yeti/core/containers/dequeue.h"
 #include "yeti/core/containers/map.h"
+#include "yeti/core/containers/flat_map.h"
+#include "yeti/core/containers/slot_map.h"
+#include "yeti/core/containers/bitset.h"
 
 #include "yeti/core/platform/info.h"
 #include "yeti/core/platform/environment.h"
@@ -82,6 +92,7 @@
 #include "yeti/core/misc/json.h"
 
 #include "yeti/core/misc/uuid.h"
+#include "yeti/core/misc/interned_strings.h"
 
 #include "yeti/core/misc/pattern_file_parser.h"
 
@@ -22,6 +22,9 @@
 
 #include "yeti/core/types.h"
 
+// To force evaluation at compile time.
+#include <type_traits>
+
 namespace yeti {
 namespace core {
 
@@ -55,7 +58,90 @@ extern YETI_PUBLIC u64 murmur_hash_64(const char *buf, u64 seed = 0);
 /// Calculates the 64-bit murmur hash of @buf with the @seed.
 extern YETI_PUBLIC u64 murmur_hash_64(const void *buf, u64 buf_len, u64 seed = 0);
 
+/// \namespace ::yeti::core::static_hash
+/// \brief Hash functions that can be evaluated at compile time.
+///
+/// \details Each produces exactly the same hash as its runtime counterpart,
+/// so hashes computed at compile time can be compared against hashes of
+/// strings computed at runtime. Written as single expressions so they're
+/// usable with compilers that only support C++11 `constexpr`.
+///
+namespace static_hash {
+  /// \internal Length of @s, excluding the terminator.
+  constexpr u32 length(const char *s, u32 n = 0) {
+    return *s ? length(s + 1, n + 1) : n;
+  }
+
+  /// \internal Calculates FNV1A hash of @s, continuing from @hash.
+  constexpr u32 fnv1a_32(const char *s, u32 hash) {
+    return *s ? fnv1a_32(s + 1, (hash ^ (u8)*s) * 16777619ul) : hash;
+  }
+
+  /// \internal Calculates FNV1A hash of @s, continuing from @hash.
+  constexpr u64 fnv1a_64(const char *s, u64 hash) {
+    return *s ? fnv1a_64(s + 1, (hash ^ (u8)*s) * 1099511628211ull) : hash;
+  }
+
+  namespace murmur {
+    static constexpr u32 M = 0x5bd1e995ul;
+    static constexpr u32 R = 24ul;
+
+    /// \internal Reads four bytes starting at @s as a little-endian word.
+    constexpr u32 word(const char *s) {
+      return (u32)(u8)s[0]
+           | ((u32)(u8)s[1] << 8)
+           | ((u32)(u8)s[2] << 16)
+           | ((u32)(u8)s[3] << 24);
+    }
+
+    constexpr u32 mix(u32 k) {
+      return ((k * M) ^ ((k * M) >> R)) * M;
+    }
+
+    constexpr u32 stragglers(const char *s, u32 len, u32 h) {
+      return (len == 3) ? (h ^ ((u32)(u8)s[2] << 16) ^ ((u32)(u8)s[1] << 8) ^ (u32)(u8)s[0]) * M
+           : (len == 2) ? (h ^ ((u32)(u8)s[1] << 8) ^ (u32)(u8)s[0]) * M
+           : (len == 1) ? (h ^ (u32)(u8)s[0]) * M
+           : h;
+    }
+
+    constexpr u32 body(const char *s, u32 len, u32 h) {
+      return (len >= 4) ? body(s + 4, len - 4, (h * M) ^ mix(word(s)))
+                        : stragglers(s, len, h);
+    }
+
+    constexpr u32 finalize(u32 h) {
+      return ((h ^ (h >> 13)) * M) ^ (((h ^ (h >> 13)) * M) >> 15);
+    }
+  }
+
+  /// Calculates the 32-bit FNV1A hash of @s.
+  constexpr u32 fnv1a_hash_32(const char *s) {
+    return fnv1a_32(s, 2166136261ul);
+  }
+
+  /// Calculates the 64-bit FNV1A hash of @s.
+  constexpr u64 fnv1a_hash_64(const char *s) {
+    return fnv1a_64(s, 14695981039346656037ull);
+  }
+
+  /// Calculates the 32-bit murmur hash of @s with the @seed.
+  constexpr u32 murmur_hash_32(const char *s, u32 seed = 0) {
+    return murmur::finalize(murmur::body(s, length(s), seed ^ length(s)));
+  }
+}
+
 } // core
 } // yeti
 
+/// \def YETI_HASH
+/// \brief Hashes the string literal @_Literal at compile time.
+///
+/// \details Matches `::yeti::core::murmur_hash_32`, which is used to hash
+/// names of entities, components, and resources. Use it to turn lookups by
+/// name into integer comparisons.
+///
+#define YETI_HASH(_Literal) \
+  (::std::integral_constant< ::yeti::u32, ::yeti::core::static_hash::murmur_hash_32(_Literal)>::value)
+
 #endif // _YETI_CORE_ALGORITHMS_HASH_H_
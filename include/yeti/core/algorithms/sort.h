@@ -0,0 +1,140 @@
+//===-- yeti/core/algorithms/sort.h ---------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Sorting.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_ALGORITHMS_SORT_H_
+#define _YETI_CORE_ALGORITHMS_SORT_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+namespace yeti {
+namespace core {
+
+/// \brief Sorts @n @keys in ascending order, reordering @values alongside.
+///
+/// \details A stable, least significant digit first radix sort over bytes.
+/// Passes over bytes that are the same for every key are skipped, so keys
+/// that only use their lower bits sort faster.
+///
+/// \param @keys_scratch Space for @n keys, clobbered while sorting.
+/// \param @values_scratch Space for @n values, clobbered while sorting.
+///
+/// \note @values and @values_scratch may be `NULL` to sort keys alone.
+///
+/// @{
+extern YETI_PUBLIC void radix_sort(u32 *keys,
+                                   u32 *values,
+                                   u32 *keys_scratch,
+                                   u32 *values_scratch,
+                                   size_t n);
+
+extern YETI_PUBLIC void radix_sort(u64 *keys,
+                                   u32 *values,
+                                   u64 *keys_scratch,
+                                   u32 *values_scratch,
+                                   size_t n);
+/// @}
+
+/// \namespace ::yeti::core::radix
+/// \internal Building blocks of radix sorts, shared with parallel sorts.
+namespace radix {
+  /// \internal Number of distinct values of a digit.
+  static const unsigned RADIX = 256;
+
+  /// \internal Extracts digit @pass of @key.
+  template <typename K>
+  YETI_INLINE unsigned digit(const K key, const unsigned pass) {
+    return (unsigned)((key >> (pass * 8)) & 0xFF);
+  }
+
+  /// \internal Counts occurrences of every digit of @n @keys.
+  template <typename K>
+  YETI_INLINE void count(const K *keys, size_t n, u32 histograms[sizeof(K)][RADIX]) {
+    for (size_t i = 0; i < n; ++i)
+      for (unsigned pass = 0; pass < sizeof(K); ++pass)
+        histograms[pass][digit(keys[i], pass)] += 1;
+  }
+
+  /// \internal Counts occurrences of digit @pass of @n @keys.
+  template <typename K>
+  YETI_INLINE void count(const K *keys, size_t n, unsigned pass, u32 histogram[RADIX]) {
+    for (size_t i = 0; i < n; ++i)
+      histogram[digit(keys[i], pass)] += 1;
+  }
+
+  /// \internal Determines if every one of @n keys has the same digit, going
+  /// by its @histogram.
+  YETI_INLINE bool trivial(const u32 histogram[RADIX], size_t n) {
+    for (unsigned d = 0; d < RADIX; ++d)
+      if (histogram[d])
+        return (histogram[d] == n);
+    return true;
+  }
+
+  /// \internal Moves @n @keys and @values to where @offsets say, by digit
+  /// @pass. Advances @offsets past the elements moved.
+  ///
+  /// \details Destinations are prefetched a little ahead, since consecutive
+  /// keys tend to scatter to different cache lines.
+  ///
+  template <typename K, bool Values>
+  YETI_INLINE void scatter(const K *keys,
+                           const u32 *values,
+                           K *sorted_keys,
+                           u32 *sorted_values,
+                           size_t n,
+                           unsigned pass,
+                           u32 offsets[RADIX]) {
+    static const size_t DISTANCE = 16;
+
+    size_t i = 0;
+
+    if (n > DISTANCE) {
+      for (; i < n - DISTANCE; ++i) {
+        const u32 ahead = offsets[digit(keys[i + DISTANCE], pass)];
+
+        YETI_PREFETCH((const void *)&sorted_keys[ahead], YETI_PREFETCH_L1);
+
+        if (Values)
+          YETI_PREFETCH((const void *)&sorted_values[ahead], YETI_PREFETCH_L1);
+
+        const u32 position = offsets[digit(keys[i], pass)]++;
+
+        sorted_keys[position] = keys[i];
+
+        if (Values)
+          sorted_values[position] = values[i];
+      }
+    }
+
+    for (; i < n; ++i) {
+      const u32 position = offsets[digit(keys[i], pass)]++;
+
+      sorted_keys[position] = keys[i];
+
+      if (Values)
+        sorted_values[position] = values[i];
+    }
+  }
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_ALGORITHMS_SORT_H_
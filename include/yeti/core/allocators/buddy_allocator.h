@@ -9,7 +9,8 @@
 //
 //===----------------------------------------------------------------------===//
 //
-// TODO(mtwilliams): Document the purpose of this file.
+/// \file
+/// \brief Buddy allocators.
 //
 //===----------------------------------------------------------------------===//
 
@@ -18,11 +19,142 @@
 
 #include "yeti/core/allocator.h"
 
+// Tracks which blocks are split and which buddies are free.
+#include "yeti/core/containers/bitset.h"
+
 namespace yeti {
 namespace core {
 
-// TODO(mtwilliams): Implement a buddy allocator with minimal overhead.
-class YETI_PUBLIC BuddyAllocator : public Allocator {};
+namespace buddy_allocator {
+  /// Default size of smallest blocks handed out, in bytes.
+  static const size_t DEFAULT_MINIMUM_SIZE_OF_BLOCKS = 32;
+
+  /// \internal Arenas can be split at most this many times, plus one.
+  static const unsigned MAXIMUM_NUM_OF_LEVELS = 48;
+
+  /// \internal Free blocks are linked by their level.
+  struct Block {
+    Block *prev;
+    Block *next;
+  };
+}
+
+/// \brief Hands out blocks of an arena by repeatedly halving it.
+///
+/// \details Allocations are rounded up to a power of two no smaller than the
+/// minimum block size, then served from a free block of that size, or by
+/// splitting a larger one. Freed blocks are merged with their buddy, the
+/// other half of the block they were split from, whenever it is also free.
+/// Both are O(log n) in the number of minimum sized blocks.
+///
+/// Rounding bounds wasted space to half of each allocation, and merging
+/// bounds fragmentation, making it well suited for long-lived allocations of
+/// varying size inside a fixed budget.
+///
+/// Bookkeeping is kept outside of the arena, in two bits per minimum sized
+/// block. Free blocks are linked through their own memory.
+///
+/// \warning Not thread-safe.
+///
+class YETI_PUBLIC BuddyAllocator : public Allocator {
+ YETI_DISALLOW_COPYING(BuddyAllocator)
+
+ public:
+  /// \brief Describes usage and fragmentation.
+  ///
+  /// \details External fragmentation is given by the proportion of free space
+  /// not in the largest free block, i.e. `1 - largest_free_block / free`.
+  /// Internal fragmentation is at most half of `allocated`.
+  ///
+  struct Statistics {
+    /// Size of arena, in bytes.
+    size_t size;
+
+    /// Bytes in blocks handed out, including rounding.
+    size_t allocated;
+
+    /// Bytes in free blocks.
+    size_t free;
+
+    /// Size of the largest free block, in bytes. Nothing larger can be
+    /// allocated.
+    size_t largest_free_block;
+
+    /// Number of blocks handed out.
+    size_t num_of_allocations;
+
+    /// Number of free blocks.
+    size_t num_of_free_blocks;
+  };
+
+ public:
+  /// \param @size Size of arena, rounded down to a power of two.
+  /// \param @minimum Size of smallest blocks, a power of two.
+  /// @{
+  BuddyAllocator(Allocator *allocator, size_t size, size_t minimum = buddy_allocator::DEFAULT_MINIMUM_SIZE_OF_BLOCKS);
+  BuddyAllocator(Allocator &allocator, size_t size, size_t minimum = buddy_allocator::DEFAULT_MINIMUM_SIZE_OF_BLOCKS);
+  /// @}
+
+  /// \brief Hands out blocks of @memory.
+  ///
+  /// \note Bookkeeping is allocated from the global heap allocator.
+  ///
+  BuddyAllocator(void *memory, size_t size, size_t minimum = buddy_allocator::DEFAULT_MINIMUM_SIZE_OF_BLOCKS);
+
+  ~BuddyAllocator();
+
+ public:
+  /// \return `NULL` if there is no free block large enough.
+  void *allocate(size_t size, size_t alignment = 16);
+
+  /// \details Returns @ptr as is if still rounded up to same size of block.
+  void *reallocate(void *ptr, size_t size, size_t alignment = 16);
+
+  void deallocate(void *ptr);
+
+ public:
+  /// Gathers statistics about usage and fragmentation.
+  void statistics(Statistics *statistics) const;
+
+ private:
+  void initialize();
+
+  // Index of node for block at @offset, at @level.
+  size_t node(unsigned level, size_t offset) const;
+
+  // Level of block handed out at @offset.
+  unsigned level(size_t offset) const;
+
+  void push(unsigned level, buddy_allocator::Block *block);
+  void remove(unsigned level, buddy_allocator::Block *block);
+
+ private:
+  Allocator *backing_;
+
+  const size_t size_;
+  const size_t minimum_;
+
+  const uintptr_t base_;
+
+  // Whether each block that can be split is.
+  Bitset split_;
+
+  // Whether only one of each pair of buddies is free.
+  Bitset buddies_;
+
+  // Strictest alignment we can satisfy, based on alignment of arena.
+  size_t alignment_;
+
+  unsigned log2_of_size_;
+  unsigned num_of_levels_;
+
+  // Free blocks by level, largest first.
+  buddy_allocator::Block *free_[buddy_allocator::MAXIMUM_NUM_OF_LEVELS];
+  size_t num_of_free_blocks_[buddy_allocator::MAXIMUM_NUM_OF_LEVELS];
+
+  size_t allocated_;
+  size_t num_of_allocations_;
+};
 
 } // core
 } // yeti
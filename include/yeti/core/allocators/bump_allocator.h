@@ -9,7 +9,8 @@
 //
 //===----------------------------------------------------------------------===//
 //
-// TODO(mtwilliams): Document the purpose of this file.
+/// \file
+/// \brief Bump allocators.
 //
 //===----------------------------------------------------------------------===//
 
@@ -21,10 +22,85 @@
 namespace yeti {
 namespace core {
 
-// TODO(mtwilliams): Implement a bump allocator.
-// TODO(mtwilliams): Allow bookmarking.
+/// \brief Hands out memory by bumping a pointer through an arena.
+///
+/// \details Allocating is little more than an addition and a comparison.
+/// Memory is reclaimed en masse by rewinding to a marker or resetting,
+/// rather than by deallocating. The exception is the last allocation, which
+/// can be deallocated or reallocated in place.
+///
+/// \warning Not thread-safe. See `thread_safe::BumpAllocator`.
+///
+class YETI_PUBLIC BumpAllocator : public Allocator {
+ YETI_DISALLOW_COPYING(BumpAllocator)
 
-class YETI_PUBLIC BumpAllocator : public Allocator {};
+ public:
+  /// \brief Position in an arena to rewind to.
+  typedef uintptr_t Marker;
+
+  /// \brief Rewinds to where it was constructed when it goes out of scope.
+  class Scope {
+   YETI_DISALLOW_COPYING(Scope)
+
+   public:
+    explicit Scope(BumpAllocator *allocator) : allocator_(allocator), marker_(allocator->mark()) {}
+    explicit Scope(BumpAllocator &allocator) : allocator_(&allocator), marker_(allocator.mark()) {}
+    ~Scope() { allocator_->rewind(marker_); }
+
+   private:
+    BumpAllocator *allocator_;
+    const Marker marker_;
+  };
+
+ public:
+  BumpAllocator(Allocator *allocator, size_t size);
+  BumpAllocator(Allocator &allocator, size_t size);
+  BumpAllocator(void *memory, size_t size);
+
+  ~BumpAllocator();
+
+ public:
+  /// \return `NULL` if there's not enough space left.
+  void *allocate(size_t size, size_t alignment = 16);
+
+  /// \details Grows or shrinks in place if @ptr is the last allocation.
+  /// Otherwise allocates anew and copies.
+  void *reallocate(void *ptr, size_t size, size_t alignment = 16);
+
+  /// \details Only reclaims memory if @ptr is the last allocation.
+  void deallocate(void *ptr);
+
+ public:
+  /// Returns a marker that can be rewound to.
+  Marker mark() const;
+
+  /// Reclaims everything allocated since @marker.
+  void rewind(Marker marker);
+
+  /// Reclaims everything.
+  void reset();
+
+ public:
+  /// Determines if @ptr was handed out by this allocator.
+  bool owns(const void *ptr) const;
+
+  /// Returns the number of bytes handed out, including padding.
+  size_t used() const;
+
+  /// Returns the number of bytes left.
+  size_t remaining() const;
+
+ private:
+  Allocator *backing_;
+
+  const uintptr_t lower_;
+  const uintptr_t upper_;
+
+  uintptr_t unallocated_;
+
+  // Start of last allocation, so it can be resized or undone in place.
+  uintptr_t last_;
+};
 
 } // core
 } // yeti
@@ -0,0 +1,89 @@
+//===-- yeti/core/allocators/frame_allocator.h ----------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Double-buffered, per-frame scratch allocators.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_ALLOCATORS_FRAME_ALLOCATOR_H_
+#define _YETI_CORE_ALLOCATORS_FRAME_ALLOCATOR_H_
+
+#include "yeti/core/allocator.h"
+
+// Each frame is bump allocated.
+#include "yeti/core/allocators/bump_allocator.h"
+
+namespace yeti {
+namespace core {
+
+namespace frame_allocator {
+  /// Default size of each buffer of the global frame allocator.
+  static const size_t DEFAULT_SIZE_OF_BUFFERS = 4 * 1024 * 1024;
+}
+
+/// \brief Hands out memory that lives until the end of the next frame.
+///
+/// \details Alternates between two bump allocated buffers, one per frame, so
+/// memory allocated one frame can still be read the next. Flipping reclaims
+/// everything allocated the frame before last. Never falls back to another
+/// allocator when a buffer is exhausted.
+///
+/// \warning Not thread-safe.
+///
+class YETI_PUBLIC FrameAllocator : public Allocator {
+ YETI_DISALLOW_COPYING(FrameAllocator)
+
+ public:
+  /// \param @size Size of each buffer.
+  /// @{
+  FrameAllocator(Allocator *allocator, size_t size);
+  FrameAllocator(Allocator &allocator, size_t size);
+  /// @}
+
+  ~FrameAllocator();
+
+ public:
+  void *allocate(size_t size, size_t alignment = 16);
+  void *reallocate(void *ptr, size_t size, size_t alignment = 16);
+  void deallocate(void *ptr);
+
+ public:
+  /// Starts a new frame, reclaiming everything allocated the frame before
+  /// last.
+  void flip();
+
+  /// Returns the bump allocator for the current frame, to mark and rewind.
+  BumpAllocator &current();
+
+ private:
+  Allocator *backing_;
+
+  const uintptr_t memory_;
+
+  BumpAllocator even_;
+  BumpAllocator odd_;
+
+  BumpAllocator *current_;
+  BumpAllocator *previous_;
+};
+
+/// \brief Returns the global frame allocator, flipped by `Application::run`
+/// every frame.
+///
+/// \note Only use from the main thread.
+///
+extern YETI_PUBLIC FrameAllocator &global_frame_allocator();
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_ALLOCATORS_FRAME_ALLOCATOR_H_
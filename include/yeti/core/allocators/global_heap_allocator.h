@@ -25,6 +25,38 @@ namespace core {
 /// \deprecated Use the global page allocator instead.
 extern YETI_PUBLIC Allocator &global_heap_allocator();
 
+namespace heap {
+
+/// \brief Describes usage of the global heap allocator.
+struct Statistics {
+  /// Number of allocations made.
+  u64 allocations;
+
+  /// Number of allocations freed.
+  u64 deallocations;
+
+  /// Number of allocations freed by a thread other than the one that made
+  /// them.
+  u64 remote_deallocations;
+
+  /// Number of bytes mapped from the system, including overhead.
+  u64 mapped;
+
+  /// Number of per-thread heaps, including those waiting for reuse.
+  u32 heaps;
+};
+
+/// \brief Gathers statistics about the global heap allocator.
+///
+/// \details Statistics are kept per thread and summed without synchronizing,
+/// so they're approximate while other threads are allocating.
+///
+/// \note Only maintained on Linux and Mac.
+///
+extern YETI_PUBLIC void statistics(Statistics *statistics);
+
+} // heap
+
 } // core
 } // yeti
 
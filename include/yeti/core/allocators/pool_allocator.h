@@ -0,0 +1,117 @@
+//===-- yeti/core/allocators/pool_allocator.h -----------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Pools of fixed-size blocks.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_ALLOCATORS_POOL_ALLOCATOR_H_
+#define _YETI_CORE_ALLOCATORS_POOL_ALLOCATOR_H_
+
+#include "yeti/core/allocator.h"
+
+namespace yeti {
+namespace core {
+
+namespace pool_allocator {
+  /// Default size of slabs blocks are carved from, in bytes.
+  static const size_t DEFAULT_SIZE_OF_SLABS = 65536;
+
+  /// \internal Links slabs, so they can be released.
+  struct Slab {
+    Slab *next;
+  };
+
+  /// \internal Links free blocks.
+  struct Block {
+    Block *next;
+  };
+}
+
+/// \brief Hands out blocks of a single size.
+///
+/// \details Blocks are carved from slabs allocated from a backing allocator,
+/// typically the page allocator, as they're needed. Freed blocks are kept on
+/// a free list for reuse, so allocating and freeing are a handful of
+/// instructions and never touch the backing allocator in steady state.
+/// Slabs are only released when the pool is destroyed.
+///
+/// Use a pool per type, or size class, of object that is created and
+/// destroyed often.
+///
+/// \warning Not thread-safe. See `thread_safe::PoolAllocator`.
+///
+class YETI_PUBLIC PoolAllocator : public Allocator {
+ YETI_DISALLOW_COPYING(PoolAllocator)
+
+ public:
+  /// \param @size Size of blocks.
+  /// \param @alignment Alignment of blocks.
+  /// \param @size_of_slabs Size of slabs blocks are carved from.
+  /// @{
+  PoolAllocator(Allocator *allocator,
+                size_t size,
+                size_t alignment = 16,
+                size_t size_of_slabs = pool_allocator::DEFAULT_SIZE_OF_SLABS);
+
+  PoolAllocator(Allocator &allocator,
+                size_t size,
+                size_t alignment = 16,
+                size_t size_of_slabs = pool_allocator::DEFAULT_SIZE_OF_SLABS);
+  /// @}
+
+  ~PoolAllocator();
+
+ public:
+  /// \details Allocations must fit in a block.
+  void *allocate(size_t size, size_t alignment = 16);
+
+  /// \details Returns @ptr as is, since blocks can't grow.
+  void *reallocate(void *ptr, size_t size, size_t alignment = 16);
+
+  void deallocate(void *ptr);
+
+ public:
+  /// Returns the size of blocks.
+  size_t size_of_blocks() const;
+
+  /// Returns the number of blocks handed out.
+  size_t num_of_allocations() const;
+
+ private:
+  void initialize();
+
+  // Carves a block from a new slab.
+  void *grow();
+
+ private:
+  Allocator *backing_;
+
+  const size_t size_;
+  const size_t alignment_;
+  const size_t size_of_slabs_;
+
+  pool_allocator::Slab *slabs_;
+
+  pool_allocator::Block *free_;
+
+  // Blocks in most recent slab yet to be handed out.
+  uintptr_t unused_;
+  uintptr_t end_;
+
+  size_t num_of_allocations_;
+};
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_ALLOCATORS_POOL_ALLOCATOR_H_
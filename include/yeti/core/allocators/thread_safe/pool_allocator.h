@@ -0,0 +1,80 @@
+//===-- yeti/core/allocators/thread_safe/pool_allocator.h -----------------===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Pools of fixed-size blocks that can be shared between threads.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_ALLOCATORS_THREAD_SAFE_POOL_ALLOCATOR_H_
+#define _YETI_CORE_ALLOCATORS_THREAD_SAFE_POOL_ALLOCATOR_H_
+
+#include "yeti/core/allocator.h"
+
+// Wraps a single-threaded pool.
+#include "yeti/core/allocators/pool_allocator.h"
+
+namespace yeti {
+namespace core {
+namespace thread_safe {
+
+/// \brief Hands out blocks of a single size to any thread.
+///
+/// \details Freeing is lock-free: blocks are pushed onto a list of returned
+/// blocks, so threads that only free, like those unloading resources, never
+/// wait. Allocating holds a spin lock just long enough to reclaim returned
+/// blocks and pop one.
+///
+class YETI_PUBLIC PoolAllocator : public Allocator {
+ YETI_DISALLOW_COPYING(PoolAllocator)
+
+ public:
+  /// \copydoc ::yeti::core::PoolAllocator::PoolAllocator
+  /// @{
+  PoolAllocator(Allocator *allocator,
+                size_t size,
+                size_t alignment = 16,
+                size_t size_of_slabs = pool_allocator::DEFAULT_SIZE_OF_SLABS);
+
+  PoolAllocator(Allocator &allocator,
+                size_t size,
+                size_t alignment = 16,
+                size_t size_of_slabs = pool_allocator::DEFAULT_SIZE_OF_SLABS);
+  /// @}
+
+  ~PoolAllocator();
+
+ public:
+  void *allocate(size_t size, size_t alignment = 16);
+  void *reallocate(void *ptr, size_t size, size_t alignment = 16);
+  void deallocate(void *ptr);
+
+ private:
+  void acquire();
+  void release();
+
+  // Moves returned blocks back into pool.
+  void reclaim();
+
+ private:
+  core::PoolAllocator pool_;
+
+  volatile u32 lock_;
+
+  // Blocks freed since last reclaimed.
+  void *volatile returned_;
+};
+
+} // thread_safe
+} // core
+} // yeti
+
+#endif // _YETI_CORE_ALLOCATORS_THREAD_SAFE_POOL_ALLOCATOR_H_
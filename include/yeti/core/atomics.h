@@ -43,6 +43,8 @@
 
     #pragma intrinsic(_InterlockedCompareExchange64)
   #endif
+
+  #pragma intrinsic(_ReadWriteBarrier)
 #elif (YETI_COMPILER == YETI_COMPILER_GCC) || \
       (YETI_COMPILER == YETI_COMPILER_CLANG)
   // No header file for intrinsics.
@@ -104,6 +106,15 @@ namespace atomic {
   static void *cmp_and_xchg(void *volatile *v, void *expected, void *desired);
   /// @}
 
+  /// \brief Prevents the compiler from reordering memory accesses across
+  /// this point.
+  ///
+  /// \details Combined with atomic loads and stores this provides acquire
+  /// and release semantics on x86 and x86_64, which never reorder loads with
+  /// loads or stores with stores.
+  ///
+  static void barrier();
+
   /// \brief Atomically sets @a to lesser of @a and @b.
   /// \return Lesser of @a and @b.
   template <typename T>
@@ -436,7 +447,16 @@ static void *atomic::cmp_and_xchg(void *volatile *v, void *expected, void *desir
   return _InterlockedCompareExchangePointer(v, desired, expected);
 #elif (YETI_COMPILER == YETI_COMPILER_GCC) || \
       (YETI_COMPILER == YETI_COMPILER_CLANG)
-  return __sync_val_compare_and_swap(v, desired, expected);
+  return __sync_val_compare_and_swap(v, expected, desired);
+#endif
+}
+
+static void atomic::barrier() {
+#if YETI_COMPILER == YETI_COMPILER_MSVC
+  _ReadWriteBarrier();
+#elif (YETI_COMPILER == YETI_COMPILER_GCC) || \
+      (YETI_COMPILER == YETI_COMPILER_CLANG)
+  asm volatile("" ::: "memory");
 #endif
 }
 
@@ -143,7 +143,7 @@ YETI_INLINE unsigned bit::clz(const u32 v) {
   return _BitScanReverse((unsigned long *)&bit, v) ? (31 - bit) : 32;
 #elif (YETI_COMPILER == YETI_COMPILER_GCC) || \
       (YETI_COMPILER == YETI_COMPILER_CLANG)
-  return v ? __builtin_clzl(v) : 32;
+  return v ? __builtin_clz(v) : 32;
 #endif
 }
 
@@ -158,7 +158,7 @@ YETI_INLINE unsigned bit::clz(const u64 v) {
   #endif
 #elif (YETI_COMPILER == YETI_COMPILER_GCC) || \
       (YETI_COMPILER == YETI_COMPILER_CLANG)
-  return v ? __builtin_ctzll(v) : 64;
+  return v ? __builtin_clzll(v) : 64;
 #endif
 }
 
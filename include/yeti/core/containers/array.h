@@ -29,17 +29,75 @@
 // For bounds checking in debug builds.
 #include "yeti/core/debug/assert.h"
 
+// To avoid constructing, destructing, and moving elements one-by-one when
+// they're plain old data.
+#include <type_traits>
+#include <utility>
+
 namespace yeti {
 namespace core {
 
+namespace array {
+
+/// \internal Minimum number of elements to reserve when growing.
+static const size_t MINIMUM_GROWTH = 4;
+
+/// \internal Constructs elements that need to be constructed.
+///
+/// \details Plain old data is left uninitialized, like it always has been,
+/// as are trivially destructible types that can't be default constructed.
+/// The latter must be assigned to before use.
+///
+template <typename T,
+          bool Construct = std::is_default_constructible<T>::value &&
+                           !std::is_trivially_default_constructible<T>::value>
+struct Constructor {
+  static void construct(T *first, T *last) {
+    for (T *I = first; I < last; ++I)
+      new ((void *)I) T();
+  }
+};
+
+template <typename T>
+struct Constructor<T, false> {
+  // Otherwise we'd later destruct elements that were never constructed.
+  static_assert(std::is_default_constructible<T>::value ||
+                std::is_trivially_destructible<T>::value,
+                "Elements can't be default constructed, so push them instead.");
+
+  static void construct(T *, T *) {}
+};
+
+}
+
 /// \brief A dynamically resizeable array.
+///
+/// \details Grows geometrically, doubling the space reserved whenever it runs
+/// out, so appending is amortized constant time. Never shrinks unless asked
+/// to by `shrink_to_fit`.
+///
+/// Elements are constructed, copied, moved, and destructed properly. Plain
+/// old data is left uninitialized when added, and is moved with the
+/// allocator's `reallocate`.
+///
 template <typename T>
 class Array {
  public:
   Array();
 
-  explicit Array(Allocator *allocator, size_t size = 0);
-  explicit Array(Allocator &allocator, size_t size = 0);
+  /// @{
+  explicit Array(Allocator *allocator);
+  explicit Array(Allocator &allocator);
+  /// @}
+
+  /// \param @size Initial number of elements.
+  ///
+  /// \copydetails resize
+  ///
+  /// @{
+  Array(Allocator *allocator, size_t size);
+  Array(Allocator &allocator, size_t size);
+  /// @}
 
   Array(const Array<T> &array);
   Array<T> &operator=(const Array<T> &array);
@@ -59,7 +117,7 @@ class Array {
   const T *pointer_from_index(size_t index) const;
 
  public:
-  /// Reserves space for an element at the back of the array.
+  /// Constructs an element at the back of the array.
   T &emplace();
 
   /// Pushes @element to the back of the array.
@@ -87,15 +145,25 @@ class Array {
   /// @}
 
   /// Resizes the array to store @size elements.
+  ///
+  /// \note Elements are default constructed, so types that can't be default
+  /// constructed and aren't trivially destructible can only be pushed.
+  ///
   void resize(size_t size);
 
   /// Grows the array to store @amount additional elements.
+  ///
+  /// \copydetails resize
+  ///
   void grow(size_t amount);
 
-  /// Reserves spaces to hold @additional elements.
+  /// Reserves space to hold @additional elements without reallocating.
   void reserve(size_t additional);
 
-  /// Empties the array.
+  /// Releases any space reserved beyond what is needed for elements.
+  void shrink_to_fit();
+
+  /// Empties the array, keeping space reserved for reuse.
   void clear();
 
   /// Returns the number of elements in the array.
@@ -122,6 +190,20 @@ class Array {
   T *raw() { return (T *)first_; }
   const T *raw() const { return (const T *)first_; }
 
+ private:
+  // Constructs elements in [@first, @last).
+  static void construct(T *first, T *last);
+
+  // Destructs elements in [@first, @last).
+  static void destruct(T *first, T *last);
+
+  // Reallocates to hold exactly @capacity elements.
+  void relocate(size_t capacity);
+
+  // Reallocates, if necessary, to hold at least @size elements. Grows
+  // geometrically to amortize the cost of reallocation.
+  void ensure(size_t size);
+
  private:
   Allocator *allocator_;
 
@@ -136,31 +218,42 @@ Array<T>::Array() {
   first_ = last_ = end_ = NULL;
 }
 
+template <typename T>
+Array<T>::Array(Allocator *allocator) {
+  allocator_ = allocator;
+  first_ = last_ = end_ = NULL;
+}
+
+template <typename T>
+Array<T>::Array(Allocator &allocator) {
+  allocator_ = &allocator;
+  first_ = last_ = end_ = NULL;
+}
+
 template <typename T>
 Array<T>::Array(Allocator *allocator, size_t size) {
   allocator_ = allocator;
-  first_     = size ? (uintptr_t)allocator_->allocate(size * sizeof(T), alignof(T)) : NULL;
-  last_      = first_ + size * sizeof(T);
-  end_       = last_;
+  first_ = last_ = end_ = NULL;
+
+  if (size)
+    this->resize(size);
 }
 
 template <typename T>
 Array<T>::Array(Allocator &allocator, size_t size) {
   allocator_ = &allocator;
-  first_     = size ? (uintptr_t)allocator_->allocate(size * sizeof(T), alignof(T)) : NULL;
-  last_      = first_ + size * sizeof(T);
-  end_       = last_;
+  first_ = last_ = end_ = NULL;
+
+  if (size)
+    this->resize(size);
 }
 
 template <typename T>
 Array<T>::Array(const Array<T> &array) {
   allocator_ = array.allocator_;
+  first_ = last_ = end_ = NULL;
 
-  first_     = size ? (uintptr_t)allocator_->allocate(array.last_ - array.first_, alignof(T)) : NULL;
-  last_      = first_ + (array.last_ - array.first_);
-  end_       = last_;
-
-  memcpy((void *)first_, (const void *)array.first_, array.last_ - array.first_);
+  *this = array;
 }
 
 template <typename T>
@@ -168,23 +261,41 @@ Array<T> &Array<T>::operator=(const Array<T> &array) {
   if (&array == this)
     return *this;
 
-  if (allocator_)
-    allocator_->deallocate((void *)first_);
+  destruct(this->begin(), this->end());
+  last_ = first_;
 
-  allocator_ = array.allocator_;
+  if (allocator_ != array.allocator_) {
+    // Memory has to come from the same allocator as the array we're copying.
+    if (allocator_ && first_)
+      allocator_->deallocate((void *)first_);
+
+    allocator_ = array.allocator_;
+    first_ = last_ = end_ = NULL;
+  }
 
-  first_     = (uintptr_t)allocator_->allocate(array.last_ - array.first_, alignof(T));
-  last_      = first_ + (array.last_ - array.first_);
-  end_       = last_;
+  const size_t size = array.size();
 
-  memcpy((void *)first_, (const void *)array.first_, array.last_ - array.first_);
+  if (size > this->reserved())
+    this->relocate(size);
+
+  if (std::is_trivially_copyable<T>::value) {
+    if (size)
+      memory::copy((const void *)array.first_, (void *)first_, size * sizeof(T));
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      new (&((T *)first_)[i]) T(array[i]);
+  }
+
+  last_ = first_ + size * sizeof(T);
 
   return *this;
 }
 
 template <typename T>
 Array<T>::~Array() {
-  if (allocator_)
+  destruct(this->begin(), this->end());
+
+  if (allocator_ && first_)
     allocator_->deallocate((void *)first_);
 }
 
@@ -218,28 +329,40 @@ const T *Array<T>::pointer_from_index(size_t index) const {
 
 template <typename T>
 T &Array<T>::emplace() {
-  // TODO(mtwilliams): Grow logarithmically.
   this->resize(this->size() + 1);
   return ((T *)last_)[-1];
 }
 
 template <typename T>
 size_t Array<T>::push(const T &element) {
-  this->emplace() = element;
-  return (this->size() - 1);
+  const size_t size = this->size();
+
+  if (size + 1 > this->reserved()) {
+    // Copy first, as @element may live in the array.
+    const T copy(element);
+    this->ensure(size + 1);
+    new ((void *)last_) T(std::move(copy));
+  } else {
+    new ((void *)last_) T(element);
+  }
+
+  last_ += sizeof(T);
+
+  return size;
 }
 
 template <typename T>
 void Array<T>::pop(T *element) {
-  // TODO(mtwilliams): Shrink logarithmically.
-  *element = ((T *)last_)[-1];
-  this->resize(this->size() - 1);
+  yeti_assert_debug(!this->empty());
+  *element = std::move(((T *)last_)[-1]);
+  this->pop();
 }
 
 template <typename T>
 void Array<T>::pop() {
-  // TODO(mtwilliams): Shrink logarithmically.
-  this->resize(this->size() - 1);
+  yeti_assert_debug(!this->empty());
+  last_ -= sizeof(T);
+  destruct((T *)last_, (T *)last_ + 1);
 }
 
 template <typename T>
@@ -264,65 +387,41 @@ const T *Array<T>::end() const {
 
 template <typename T>
 void Array<T>::resize(size_t size) {
-  // Requested size in bytes.
-  const size_t size_in_bytes = size * sizeof(T);
-
-  // Current size in bytes.
-  const size_t current_in_bytes = (last_ - first_);
-
-  if (size_in_bytes > current_in_bytes) {
-    if ((first_ + size_in_bytes) <= end_) {
-      // Grow into reserved.
-      last_ = first_ + size_in_bytes;
-    } else {
-      // Grow.
-      first_ = (uintptr_t)allocator_->reallocate((void *)first_, size_in_bytes, alignof(T));
-      last_  = first_ + size_in_bytes;
-      end_   = last_;
-    }
-  } else if (size < current_in_bytes) {
-    // TODO(mtwilliams): Shrink.
-    last_ = first_ + size_in_bytes;
+  const size_t current = this->size();
+
+  if (size > current) {
+    this->ensure(size);
+    construct((T *)last_, (T *)first_ + size);
+  } else if (size < current) {
+    destruct((T *)first_ + size, (T *)last_);
   }
+
+  last_ = first_ + size * sizeof(T);
 }
 
 template <typename T>
 void Array<T>::grow(size_t amount) {
-  // Requested amount in bytes.
-  const size_t amount_in_bytes = amount * sizeof(T);
-
-  if ((last_ + amount_in_bytes) <= end_) {
-    // Grow into reserved.
-    last_ = first_ + amount_in_bytes;
-  } else {
-    // Calculate new size.
-    const size_t size_in_bytes = last_ - first_ + amount_in_bytes;
-
-    // Grow.
-    first_ = (uintptr_t)allocator_->reallocate((void *)first_, size_in_bytes, alignof(T));
-    last_  = first_ + size_in_bytes;
-    end_   = last_;
-  }
+  this->resize(this->size() + amount);
 }
 
 template <typename T>
 void Array<T>::reserve(size_t additional) {
-  // Current size in bytes.
-  const size_t size_in_bytes = (last_ - first_);
-  const size_t reserved_in_bytes = (end_ - first_);
+  const size_t required = this->size() + additional;
 
-  // Reserve in bytes.
-  const size_t additional_in_bytes = additional * sizeof(T);
+  if (required > this->reserved())
+    this->relocate(required);
+}
 
-  first_ = (uintptr_t)allocator_->reallocate((void *)first_, reserved_in_bytes + additional_in_bytes, alignof(T));
-  last_  = first_ + size_in_bytes;
-  end_   = first_ + reserved_in_bytes + additional_in_bytes;
+template <typename T>
+void Array<T>::shrink_to_fit() {
+  if (this->reserved() > this->size())
+    this->relocate(this->size());
 }
 
 template <typename T>
 void Array<T>::clear() {
-  allocator_->deallocate((void *)first_);
-  first_ = last_ = end_ = NULL;
+  destruct(this->begin(), this->end());
+  last_ = first_;
 }
 
 template <typename T>
@@ -342,7 +441,7 @@ bool Array<T>::empty() const {
 
 template <typename T>
 T *Array<T>::find(const T &value) {
-  for (T *I = this->begin(); I <= this->end(); ++I)
+  for (T *I = this->begin(); I < this->end(); ++I)
     if (*I == value)
       return I;
 
@@ -351,7 +450,7 @@ T *Array<T>::find(const T &value) {
 
 template <typename T>
 const T *Array<T>::find(const T &value) const {
-  for (const T *I = this->begin(); I <= this->end(); ++I)
+  for (const T *I = this->begin(); I < this->end(); ++I)
     if (*I == value)
       return I;
 
@@ -365,6 +464,73 @@ size_t Array<T>::position(const T &value) const {
   return ~(size_t)0;
 }
 
+template <typename T>
+void Array<T>::construct(T *first, T *last) {
+  array::Constructor<T>::construct(first, last);
+}
+
+template <typename T>
+void Array<T>::destruct(T *first, T *last) {
+  if (std::is_trivially_destructible<T>::value)
+    return;
+
+  for (T *I = first; I < last; ++I)
+    I->~T();
+}
+
+template <typename T>
+void Array<T>::relocate(size_t capacity) {
+  yeti_assert_debug(allocator_ != NULL);
+
+  const size_t size = this->size();
+
+  yeti_assert_debug(capacity >= size);
+
+  if (capacity == 0) {
+    if (first_)
+      allocator_->deallocate((void *)first_);
+    first_ = last_ = end_ = NULL;
+    return;
+  }
+
+  if (std::is_trivially_copyable<T>::value) {
+    first_ = (uintptr_t)allocator_->reallocate((void *)first_, capacity * sizeof(T), alignof(T));
+  } else {
+    T *elements = (T *)allocator_->allocate(capacity * sizeof(T), alignof(T));
+
+    for (size_t i = 0; i < size; ++i) {
+      new ((void *)&elements[i]) T(std::move(((T *)first_)[i]));
+      ((T *)first_)[i].~T();
+    }
+
+    if (first_)
+      allocator_->deallocate((void *)first_);
+
+    first_ = (uintptr_t)elements;
+  }
+
+  last_ = first_ + size * sizeof(T);
+  end_  = first_ + capacity * sizeof(T);
+}
+
+template <typename T>
+void Array<T>::ensure(size_t size) {
+  const size_t reserved = this->reserved();
+
+  if (size <= reserved)
+    return;
+
+  size_t capacity = reserved * 2;
+
+  if (capacity < array::MINIMUM_GROWTH)
+    capacity = array::MINIMUM_GROWTH;
+
+  if (capacity < size)
+    capacity = size;
+
+  this->relocate(capacity);
+}
+
 } // core
 } // yeti
 
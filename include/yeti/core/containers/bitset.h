@@ -0,0 +1,396 @@
+//===-- yeti/core/containers/bitset.h -------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Fixed size sets of bits.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_BITSET_H_
+#define _YETI_CORE_CONTAINERS_BITSET_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+
+// For population counts and scanning.
+#include "yeti/core/bits.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  #include <emmintrin.h>
+#endif
+
+namespace yeti {
+namespace core {
+
+namespace bitset {
+
+/// \internal Bits are stored in words of this type.
+typedef u64 Word;
+
+/// \internal Number of bits per word.
+static const size_t BITS_PER_WORD = 64;
+
+/// \internal Words are processed in blocks of this many at a time, and
+/// storage is padded to a multiple of it.
+static const size_t WORDS_PER_BLOCK = 2;
+
+/// Returned by searches when no bit is found.
+static const size_t NONE = ~(size_t)0;
+
+}
+
+/// \brief A fixed size set of bits.
+///
+/// \details Bits are packed into 64-bit words, so counting, searching and
+/// set algebra operate on 64 bits at a time. Storage is padded to whole
+/// 128-bit blocks and bits past the end are kept clear, so bulk operations
+/// process blocks without masking or tails.
+///
+class Bitset {
+ YETI_DISALLOW_COPYING(Bitset)
+
+ public:
+  typedef bitset::Word Word;
+
+ public:
+  /// \param @size Number of bits. All bits start clear.
+  /// @{
+  explicit Bitset(Allocator *allocator, size_t size);
+  explicit Bitset(Allocator &allocator, size_t size);
+  /// @}
+
+  ~Bitset();
+
+ public:
+  /// Sets @bit.
+  void set(size_t bit);
+
+  /// Clears @bit.
+  void reset(size_t bit);
+
+  /// Sets or clears @bit depending on @value.
+  void assign(size_t bit, bool value);
+
+  /// Determines if @bit is set.
+  bool test(size_t bit) const;
+
+  bool operator[](size_t bit) const;
+
+ public:
+  /// Sets all bits.
+  void set_all();
+
+  /// Clears all bits.
+  void reset_all();
+
+  /// Clears bits in [@first, @last).
+  void reset_range(size_t first, size_t last);
+
+ public:
+  /// Counts the number of set bits.
+  size_t count() const;
+
+  /// Determines if any bit is set.
+  bool any() const;
+
+  /// Determines if no bit is set.
+  bool none() const;
+
+  /// Finds the first set bit at or after @from.
+  /// \return Index of the bit, or `bitset::NONE` if there is none.
+  size_t find_next_set(size_t from = 0) const;
+
+  /// Writes the indices of all set bits in ascending order to @indices,
+  /// which must have room for `count()` indices.
+  /// \return Number of indices written.
+  size_t scan(u32 *indices) const;
+
+ public:
+  /// Clears bits not set in @other.
+  void and_with(const Bitset &other);
+
+  /// Sets bits set in @other.
+  void or_with(const Bitset &other);
+
+  /// Clears bits set in @other.
+  void and_not_with(const Bitset &other);
+
+ public:
+  /// Returns the number of bits.
+  size_t size() const;
+
+  /// Returns the number of words backing the bits, including padding.
+  size_t words() const;
+
+  /// Returns a pointer to the words backing the bits.
+  /// @{
+  Word *raw();
+  const Word *raw() const;
+  /// @}
+
+ private:
+  void initialize(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  Word *words_;
+
+  size_t size_;
+  size_t num_of_words_;
+};
+
+YETI_INLINE Bitset::Bitset(Allocator *allocator, size_t size) {
+  allocator_ = allocator;
+  this->initialize(size);
+}
+
+YETI_INLINE Bitset::Bitset(Allocator &allocator, size_t size) {
+  allocator_ = &allocator;
+  this->initialize(size);
+}
+
+YETI_INLINE void Bitset::initialize(size_t size) {
+  static const size_t BITS_PER_BLOCK = bitset::BITS_PER_WORD * bitset::WORDS_PER_BLOCK;
+
+  const size_t blocks = (size + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+
+  size_ = size;
+  num_of_words_ = blocks * bitset::WORDS_PER_BLOCK;
+
+  if (num_of_words_) {
+    words_ = (Word *)allocator_->allocate(num_of_words_ * sizeof(Word), 16);
+    memory::zero((void *)words_, num_of_words_ * sizeof(Word));
+  } else {
+    words_ = NULL;
+  }
+}
+
+YETI_INLINE Bitset::~Bitset() {
+  if (words_)
+    allocator_->deallocate((void *)words_);
+}
+
+YETI_INLINE void Bitset::set(size_t bit) {
+  yeti_assert_debug(bit < size_);
+  words_[bit / bitset::BITS_PER_WORD] |= (Word)1 << (bit % bitset::BITS_PER_WORD);
+}
+
+YETI_INLINE void Bitset::reset(size_t bit) {
+  yeti_assert_debug(bit < size_);
+  words_[bit / bitset::BITS_PER_WORD] &= ~((Word)1 << (bit % bitset::BITS_PER_WORD));
+}
+
+YETI_INLINE void Bitset::assign(size_t bit, bool value) {
+  if (value)
+    this->set(bit);
+  else
+    this->reset(bit);
+}
+
+YETI_INLINE bool Bitset::test(size_t bit) const {
+  yeti_assert_debug(bit < size_);
+  return !!((words_[bit / bitset::BITS_PER_WORD] >> (bit % bitset::BITS_PER_WORD)) & 1);
+}
+
+YETI_INLINE bool Bitset::operator[](size_t bit) const {
+  return this->test(bit);
+}
+
+YETI_INLINE void Bitset::set_all() {
+  if (!size_)
+    return;
+
+  memory::fill((void *)words_, num_of_words_ * sizeof(Word), 0xFF);
+
+  // Keep bits past the end clear.
+  const size_t last = (size_ - 1) / bitset::BITS_PER_WORD;
+
+  for (size_t word = last + 1; word < num_of_words_; ++word)
+    words_[word] = 0;
+
+  if (const size_t remainder = size_ % bitset::BITS_PER_WORD)
+    words_[last] = ((Word)1 << remainder) - 1;
+}
+
+YETI_INLINE void Bitset::reset_all() {
+  if (num_of_words_)
+    memory::zero((void *)words_, num_of_words_ * sizeof(Word));
+}
+
+YETI_INLINE void Bitset::reset_range(size_t first, size_t last) {
+  yeti_assert_debug(first <= last);
+  yeti_assert_debug(last <= size_);
+
+  if (first == last)
+    return;
+
+  const size_t first_word = first / bitset::BITS_PER_WORD;
+  const size_t last_word = (last - 1) / bitset::BITS_PER_WORD;
+
+  // Bits to keep in partially covered words at either end.
+  const Word below = ((Word)1 << (first % bitset::BITS_PER_WORD)) - 1;
+  const Word above = (last % bitset::BITS_PER_WORD) ? ~(((Word)1 << (last % bitset::BITS_PER_WORD)) - 1) : 0;
+
+  if (first_word == last_word) {
+    words_[first_word] &= (below | above);
+    return;
+  }
+
+  words_[first_word] &= below;
+
+  if (last_word - first_word > 1)
+    memory::zero((void *)&words_[first_word + 1],
+                 (last_word - first_word - 1) * sizeof(Word));
+
+  words_[last_word] &= above;
+}
+
+YETI_INLINE size_t Bitset::count() const {
+  size_t n = 0;
+  for (size_t word = 0; word < num_of_words_; ++word)
+    n += bit::count(words_[word]);
+  return n;
+}
+
+YETI_INLINE bool Bitset::any() const {
+  for (size_t word = 0; word < num_of_words_; ++word)
+    if (words_[word])
+      return true;
+  return false;
+}
+
+YETI_INLINE bool Bitset::none() const {
+  return !this->any();
+}
+
+YETI_INLINE size_t Bitset::find_next_set(size_t from) const {
+  if (from >= size_)
+    return bitset::NONE;
+
+  size_t word = from / bitset::BITS_PER_WORD;
+
+  // Ignore bits before @from in the first word.
+  Word bits = words_[word] & ~(((Word)1 << (from % bitset::BITS_PER_WORD)) - 1);
+
+  while (!bits) {
+    if (++word == num_of_words_)
+      return bitset::NONE;
+    bits = words_[word];
+  }
+
+  return word * bitset::BITS_PER_WORD + bit::ctz(bits);
+}
+
+YETI_INLINE size_t Bitset::scan(u32 *indices) const {
+  u32 *I = indices;
+
+  for (size_t block = 0; block < num_of_words_; block += bitset::WORDS_PER_BLOCK) {
+  #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+      YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+    // Skip empty blocks without touching each word, since sets we scan tend
+    // to be sparse.
+    const __m128i bits = _mm_load_si128((const __m128i *)&words_[block]);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) == 0xFFFF)
+      continue;
+  #endif
+
+    for (size_t word = block; word < block + bitset::WORDS_PER_BLOCK; ++word) {
+      const u32 base = (u32)(word * bitset::BITS_PER_WORD);
+
+      // Peel off the lowest set bit until none are left.
+      for (Word bits = words_[word]; bits; bits &= bits - 1)
+        *I++ = base + bit::ctz(bits);
+    }
+  }
+
+  return (size_t)(I - indices);
+}
+
+YETI_INLINE void Bitset::and_with(const Bitset &other) {
+  yeti_assert_debug(other.size_ == size_);
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  for (size_t block = 0; block < num_of_words_; block += bitset::WORDS_PER_BLOCK) {
+    __m128i *lhs = (__m128i *)&words_[block];
+    const __m128i rhs = _mm_load_si128((const __m128i *)&other.words_[block]);
+    _mm_store_si128(lhs, _mm_and_si128(_mm_load_si128(lhs), rhs));
+  }
+#else
+  for (size_t word = 0; word < num_of_words_; ++word)
+    words_[word] &= other.words_[word];
+#endif
+}
+
+YETI_INLINE void Bitset::or_with(const Bitset &other) {
+  yeti_assert_debug(other.size_ == size_);
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  for (size_t block = 0; block < num_of_words_; block += bitset::WORDS_PER_BLOCK) {
+    __m128i *lhs = (__m128i *)&words_[block];
+    const __m128i rhs = _mm_load_si128((const __m128i *)&other.words_[block]);
+    _mm_store_si128(lhs, _mm_or_si128(_mm_load_si128(lhs), rhs));
+  }
+#else
+  for (size_t word = 0; word < num_of_words_; ++word)
+    words_[word] |= other.words_[word];
+#endif
+}
+
+YETI_INLINE void Bitset::and_not_with(const Bitset &other) {
+  yeti_assert_debug(other.size_ == size_);
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  for (size_t block = 0; block < num_of_words_; block += bitset::WORDS_PER_BLOCK) {
+    __m128i *lhs = (__m128i *)&words_[block];
+    const __m128i rhs = _mm_load_si128((const __m128i *)&other.words_[block]);
+    // Note that the first operand is the one negated.
+    _mm_store_si128(lhs, _mm_andnot_si128(rhs, _mm_load_si128(lhs)));
+  }
+#else
+  for (size_t word = 0; word < num_of_words_; ++word)
+    words_[word] &= ~other.words_[word];
+#endif
+}
+
+YETI_INLINE size_t Bitset::size() const {
+  return size_;
+}
+
+YETI_INLINE size_t Bitset::words() const {
+  return num_of_words_;
+}
+
+YETI_INLINE Bitset::Word *Bitset::raw() {
+  return words_;
+}
+
+YETI_INLINE const Bitset::Word *Bitset::raw() const {
+  return words_;
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_BITSET_H_
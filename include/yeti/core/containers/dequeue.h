@@ -1 +1,472 @@
-// TODO(mtwilliams): Implement a doubly-ended queue.
+//===-- yeti/core/containers/dequeue.h ------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Doubly-ended queues.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_DEQUEUE_H_
+#define _YETI_CORE_CONTAINERS_DEQUEUE_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+// To skip destruction of plain old data.
+#include <type_traits>
+
+// To move elements out.
+#include <utility>
+
+namespace yeti {
+namespace core {
+
+namespace dequeue {
+
+/// \internal Blocks are sized to hold roughly this many bytes of elements.
+static const size_t BYTES_PER_BLOCK = 1024;
+
+/// \internal Blocks hold at least this many elements, however large.
+static const size_t MINIMUM_ELEMENTS_PER_BLOCK = 8;
+
+/// \internal Maps refer to at least this many blocks.
+static const size_t MINIMUM_NUM_OF_BLOCKS = 4;
+
+/// \internal Largest power of two less than or equal to @n.
+constexpr size_t round_down_to_power_of_two(size_t n, size_t power = 1) {
+  return (power * 2 <= n) ? round_down_to_power_of_two(n, power * 2) : power;
+}
+
+/// \internal Number of elements of type @T per block. Always a power of two
+/// so positions split into blocks and offsets with shifts and masks.
+template <typename T>
+struct ElementsPerBlock {
+  static const size_t VALUE =
+    (BYTES_PER_BLOCK / sizeof(T) > MINIMUM_ELEMENTS_PER_BLOCK)
+      ? round_down_to_power_of_two(BYTES_PER_BLOCK / sizeof(T))
+      : MINIMUM_ELEMENTS_PER_BLOCK;
+};
+
+}
+
+/// \brief A doubly-ended queue.
+///
+/// \details Elements are stored in fixed size blocks, referred to by a
+/// circular map of blocks. Pushing and popping at either end is constant
+/// time, and never moves elements, so pointers to elements remain valid
+/// until they're popped. Only the map is reallocated as the queue grows.
+///
+/// Blocks are kept around once allocated, so a queue that has reached its
+/// steady state doesn't allocate.
+///
+template <typename T>
+class Dequeue {
+ YETI_DISALLOW_COPYING(Dequeue)
+
+ public:
+  static const size_t ELEMENTS_PER_BLOCK = dequeue::ElementsPerBlock<T>::VALUE;
+
+ public:
+  Dequeue();
+
+  /// \param @reserve Number of elements to reserve space for.
+  /// @{
+  explicit Dequeue(Allocator *allocator, size_t reserve = 0);
+  explicit Dequeue(Allocator &allocator, size_t reserve = 0);
+  /// @}
+
+  ~Dequeue();
+
+ public:
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+ public:
+  /// Constructs an element at the front.
+  T &emplace_front();
+
+  /// Constructs an element at the back.
+  T &emplace_back();
+
+  /// Pushes @element to the front.
+  void push_front(const T &element);
+
+  /// Pushes @element to the back.
+  void push_back(const T &element);
+
+  /// Pops the element at the front and moves it to @element.
+  /// \return If an element was popped.
+  bool pop_front(T *element);
+
+  /// Pops the element at the back and moves it to @element.
+  /// \return If an element was popped.
+  bool pop_back(T *element);
+
+  /// Pops the element at the front.
+  /// \return If an element was popped.
+  bool pop_front();
+
+  /// Pops the element at the back.
+  /// \return If an element was popped.
+  bool pop_back();
+
+  /// Returns the element at the front.
+  /// @{
+  T &front();
+  const T &front() const;
+  /// @}
+
+  /// Returns the element at the back.
+  /// @{
+  T &back();
+  const T &back() const;
+  /// @}
+
+ public:
+  /// Reserves space to push @additional elements without allocating.
+  void reserve(size_t additional);
+
+  /// Pops all elements, keeping blocks for reuse.
+  void clear();
+
+  /// Returns the number of elements.
+  size_t size() const;
+
+  /// Returns the number of elements that can be stored before the map of
+  /// blocks has to grow.
+  size_t reserved() const;
+
+  /// Determines if there are no elements.
+  bool empty() const;
+
+ private:
+  // Returns a pointer to the slot at @position, allocating its block if
+  // necessary.
+  T *slot(size_t position);
+
+  // Returns a pointer to the element at @position.
+  T *element(size_t position) const;
+
+  // Wraps @position around the end of the map of blocks.
+  size_t wrap(size_t position) const;
+
+  // Grows the map of blocks, if necessary, so @size elements fit.
+  void ensure(size_t size);
+
+  // Grows the map of blocks so @size elements fit.
+  void grow(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  // Circular. Blocks are allocated as they're first needed.
+  T **blocks_;
+  size_t num_of_blocks_;
+
+  // Number of slots in the map of blocks, less one.
+  size_t mask_;
+
+  // Position of the first element. Positions wrap around at the number of
+  // blocks multiplied by the number of elements per block.
+  size_t first_;
+
+  size_t size_;
+};
+
+template <typename T>
+Dequeue<T>::Dequeue() {
+  allocator_ = NULL;
+  blocks_ = NULL;
+  num_of_blocks_ = 0;
+  mask_ = 0;
+  first_ = 0;
+  size_ = 0;
+}
+
+template <typename T>
+Dequeue<T>::Dequeue(Allocator *allocator, size_t reserve) {
+  allocator_ = allocator;
+  blocks_ = NULL;
+  num_of_blocks_ = 0;
+  mask_ = 0;
+  first_ = 0;
+  size_ = 0;
+
+  if (reserve)
+    this->reserve(reserve);
+}
+
+template <typename T>
+Dequeue<T>::Dequeue(Allocator &allocator, size_t reserve) {
+  allocator_ = &allocator;
+  blocks_ = NULL;
+  num_of_blocks_ = 0;
+  mask_ = 0;
+  first_ = 0;
+  size_ = 0;
+
+  if (reserve)
+    this->reserve(reserve);
+}
+
+template <typename T>
+Dequeue<T>::~Dequeue() {
+  this->clear();
+
+  for (size_t block = 0; block < num_of_blocks_; ++block)
+    if (blocks_[block])
+      allocator_->deallocate((void *)blocks_[block]);
+
+  if (blocks_)
+    allocator_->deallocate((void *)blocks_);
+}
+
+template <typename T>
+T *Dequeue<T>::slot(size_t position) {
+  const size_t block = position / ELEMENTS_PER_BLOCK;
+
+  if (!blocks_[block])
+    blocks_[block] = (T *)allocator_->allocate(ELEMENTS_PER_BLOCK * sizeof(T), alignof(T));
+
+  return &blocks_[block][position % ELEMENTS_PER_BLOCK];
+}
+
+template <typename T>
+T *Dequeue<T>::element(size_t position) const {
+  return &blocks_[position / ELEMENTS_PER_BLOCK][position % ELEMENTS_PER_BLOCK];
+}
+
+template <typename T>
+size_t Dequeue<T>::wrap(size_t position) const {
+  // Both the number of blocks and elements per block are powers of two.
+  return position & mask_;
+}
+
+template <typename T>
+void Dequeue<T>::ensure(size_t size) {
+  // Kept separate from growth so this check is inlined.
+  if (size + ELEMENTS_PER_BLOCK > num_of_blocks_ * ELEMENTS_PER_BLOCK)
+    this->grow(size);
+}
+
+template <typename T>
+void Dequeue<T>::grow(size_t size) {
+  // We keep at least a block's worth of slots free, so that the first and
+  // last elements never share a block when wrapped around. Otherwise blocks
+  // couldn't be rearranged when growing.
+  size_t num_of_blocks = num_of_blocks_ ? num_of_blocks_ : dequeue::MINIMUM_NUM_OF_BLOCKS;
+
+  while (size + ELEMENTS_PER_BLOCK > num_of_blocks * ELEMENTS_PER_BLOCK)
+    num_of_blocks *= 2;
+
+  T **blocks = (T **)allocator_->allocate(num_of_blocks * sizeof(T *), alignof(T *));
+
+  // Unwrap so the block holding the first element is first. Elements stay
+  // where they are, only references to the blocks they're in move.
+  const size_t first_block = first_ / ELEMENTS_PER_BLOCK;
+
+  for (size_t block = 0; block < num_of_blocks_; ++block)
+    blocks[block] = blocks_[(first_block + block) % num_of_blocks_];
+
+  memory::zero((void *)&blocks[num_of_blocks_],
+               (num_of_blocks - num_of_blocks_) * sizeof(T *));
+
+  if (blocks_)
+    allocator_->deallocate((void *)blocks_);
+
+  blocks_ = blocks;
+  num_of_blocks_ = num_of_blocks;
+  mask_ = num_of_blocks * ELEMENTS_PER_BLOCK - 1;
+
+  first_ %= ELEMENTS_PER_BLOCK;
+}
+
+template <typename T>
+T &Dequeue<T>::operator[](size_t index) {
+  yeti_assert_debug(index < size_);
+  return *this->element(this->wrap(first_ + index));
+}
+
+template <typename T>
+const T &Dequeue<T>::operator[](size_t index) const {
+  yeti_assert_debug(index < size_);
+  return *this->element(this->wrap(first_ + index));
+}
+
+template <typename T>
+T &Dequeue<T>::emplace_front() {
+  this->ensure(size_ + 1);
+
+  first_ = this->wrap(first_ - 1);
+  size_ += 1;
+
+  return *(new ((void *)this->slot(first_)) T);
+}
+
+template <typename T>
+T &Dequeue<T>::emplace_back() {
+  this->ensure(size_ + 1);
+
+  const size_t position = this->wrap(first_ + size_);
+  size_ += 1;
+
+  return *(new ((void *)this->slot(position)) T);
+}
+
+template <typename T>
+void Dequeue<T>::push_front(const T &element) {
+  this->ensure(size_ + 1);
+
+  const size_t position = this->wrap(first_ - 1);
+  new ((void *)this->slot(position)) T(element);
+
+  first_ = position;
+  size_ += 1;
+}
+
+template <typename T>
+void Dequeue<T>::push_back(const T &element) {
+  this->ensure(size_ + 1);
+
+  const size_t position = this->wrap(first_ + size_);
+  new ((void *)this->slot(position)) T(element);
+
+  size_ += 1;
+}
+
+template <typename T>
+bool Dequeue<T>::pop_front(T *element) {
+  if (size_ == 0)
+    return false;
+
+  T *front = this->element(first_);
+  *element = std::move(*front);
+  front->~T();
+
+  first_ = this->wrap(first_ + 1);
+  size_ -= 1;
+
+  return true;
+}
+
+template <typename T>
+bool Dequeue<T>::pop_back(T *element) {
+  if (size_ == 0)
+    return false;
+
+  T *back = this->element(this->wrap(first_ + size_ - 1));
+  *element = std::move(*back);
+  back->~T();
+
+  size_ -= 1;
+
+  return true;
+}
+
+template <typename T>
+bool Dequeue<T>::pop_front() {
+  if (size_ == 0)
+    return false;
+
+  this->element(first_)->~T();
+
+  first_ = this->wrap(first_ + 1);
+  size_ -= 1;
+
+  return true;
+}
+
+template <typename T>
+bool Dequeue<T>::pop_back() {
+  if (size_ == 0)
+    return false;
+
+  this->element(this->wrap(first_ + size_ - 1))->~T();
+
+  size_ -= 1;
+
+  return true;
+}
+
+template <typename T>
+T &Dequeue<T>::front() {
+  yeti_assert_debug(!this->empty());
+  return *this->element(first_);
+}
+
+template <typename T>
+const T &Dequeue<T>::front() const {
+  yeti_assert_debug(!this->empty());
+  return *this->element(first_);
+}
+
+template <typename T>
+T &Dequeue<T>::back() {
+  yeti_assert_debug(!this->empty());
+  return *this->element(this->wrap(first_ + size_ - 1));
+}
+
+template <typename T>
+const T &Dequeue<T>::back() const {
+  yeti_assert_debug(!this->empty());
+  return *this->element(this->wrap(first_ + size_ - 1));
+}
+
+template <typename T>
+void Dequeue<T>::reserve(size_t additional) {
+  this->ensure(size_ + additional);
+
+  // Allocate blocks upfront so pushing doesn't.
+  for (size_t i = size_; i < size_ + additional; i += ELEMENTS_PER_BLOCK)
+    this->slot(this->wrap(first_ + i));
+
+  if (additional)
+    this->slot(this->wrap(first_ + size_ + additional - 1));
+}
+
+template <typename T>
+void Dequeue<T>::clear() {
+  if (!std::is_trivially_destructible<T>::value)
+    while (this->pop_back());
+
+  first_ = 0;
+  size_ = 0;
+}
+
+template <typename T>
+size_t Dequeue<T>::size() const {
+  return size_;
+}
+
+template <typename T>
+size_t Dequeue<T>::reserved() const {
+  // A block's worth of slots is always kept free.
+  return num_of_blocks_ ? (num_of_blocks_ - 1) * ELEMENTS_PER_BLOCK : 0;
+}
+
+template <typename T>
+bool Dequeue<T>::empty() const {
+  return (size_ == 0);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_DEQUEUE_H_
@@ -0,0 +1,494 @@
+//===-- yeti/core/containers/flat_map.h -----------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Hash maps that probe groups of entries at once.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_FLAT_MAP_H_
+#define _YETI_CORE_CONTAINERS_FLAT_MAP_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+
+// To iterate over matches.
+#include "yeti/core/bits.h"
+
+// Shares hash functions and key comparisons.
+#include "yeti/core/containers/map.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  #include <emmintrin.h>
+#endif
+
+namespace yeti {
+namespace core {
+
+namespace flat_map {
+
+/// \internal Number of entries probed at once.
+static const size_t GROUP = 16;
+
+/// \internal Minimum number of entries allocated.
+static const size_t MINIMUM_NUM_OF_ENTRIES = 16;
+
+/// \internal Control byte for an entry that has never been occupied.
+static const u8 EMPTY = 0x80;
+
+/// \internal Control byte for an entry that was occupied then removed.
+static const u8 DELETED = 0xFE;
+
+// Occupied entries store the lower seven bits of their key's hash as their
+// control byte, which leaves the top bit clear. Empty and deleted entries set
+// the top bit, and are distinguished by their lower bits.
+
+/// \internal Portion of @hash used to pick an entry.
+static YETI_INLINE map::Hash h1(const map::Hash hash) {
+  return hash >> 7;
+}
+
+/// \internal Portion of @hash stored in control bytes.
+static YETI_INLINE u8 h2(const map::Hash hash) {
+  return (u8)(hash & 0x7F);
+}
+
+/// \internal Control bytes of #GROUP consecutive entries.
+///
+/// \details Matches return a mask with a bit set for each matching entry,
+/// starting from the least significant bit.
+///
+struct Group {
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  __m128i control;
+
+  explicit Group(const u8 *control_bytes) {
+    control = _mm_loadu_si128((const __m128i *)control_bytes);
+  }
+
+  u32 match(const u8 tag) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)tag)));
+  }
+
+  u32 match_empty() const {
+    return this->match(EMPTY);
+  }
+
+  u32 match_empty_or_deleted() const {
+    // Only empty and deleted entries have their top bits set.
+    return _mm_movemask_epi8(control);
+  }
+#else
+  const u8 *control;
+
+  explicit Group(const u8 *control_bytes) {
+    control = control_bytes;
+  }
+
+  u32 match(const u8 tag) const {
+    u32 mask = 0;
+    for (size_t i = 0; i < GROUP; ++i)
+      if (control[i] == tag)
+        mask |= (1u << i);
+    return mask;
+  }
+
+  u32 match_empty() const {
+    return this->match(EMPTY);
+  }
+
+  u32 match_empty_or_deleted() const {
+    u32 mask = 0;
+    for (size_t i = 0; i < GROUP; ++i)
+      if (control[i] & 0x80)
+        mask |= (1u << i);
+    return mask;
+  }
+#endif
+};
+
+}
+
+/// \brief A dynamically resized hash map that probes many entries at once.
+///
+/// \details Keeps a control byte per entry, holding seven bits of its key's
+/// hash, apart from keys and values. Lookups compare a group of sixteen
+/// control bytes at a time, and only touch entries whose control bytes
+/// match. Most lookups touch a single cache line of control bytes and a
+/// single entry.
+///
+/// Removal leaves tombstones, which are purged whenever the map is rehashed.
+/// Rehashes when more than seven-eighths of entries are occupied or
+/// tombstones, doubling in size unless tombstones account for enough.
+///
+/// \warning Keys and values are copied bitwise when the map grows, and
+/// aren't constructed or destructed.
+///
+template <typename K, typename V,
+          typename map::HashFunctionSignature<K>::Type F =
+            map::DefaultHashFunction<K>::hash>
+class FlatMap {
+ // Copying a map does not make a lot of sense. If you find yourself needing to
+ // copy a map, rethink what you're trying to do.
+ YETI_DISALLOW_COPYING(FlatMap)
+
+ private:
+  typedef map::Hash Hash;
+
+  struct Entry {
+    K key;
+    V value;
+  };
+
+ public:
+  FlatMap();
+
+  /// \param @size Initial number of entries, rounded up to a power of two.
+  /// @{
+  explicit FlatMap(Allocator *allocator, size_t size = 0);
+  explicit FlatMap(Allocator &allocator, size_t size = 0);
+  /// @}
+
+  ~FlatMap();
+
+ public:
+  /// Returns a pointer to the value associated with @key.
+  /// @{
+  V *find(const K &key);
+  const V *find(const K &key) const;
+  /// @}
+
+  /// Returns a the value associated with @key.
+  /// @{
+  V &get(const K &key);
+  const V &get(const K &key) const;
+  /// @}
+
+  /// Associates @key with storage for a value.
+  V &emplace(const K &key);
+
+  /// Associates @key with @value.
+  void insert(const K &key, const V &value);
+
+  /// Deassociates a @key from its value, if it has one.
+  void remove(const K &key);
+
+  /// Deassociates all keys from all values.
+  void clear();
+
+  /// Determines if the map doesn't contain any associations.
+  bool empty() const;
+
+  /// Makes room for at least @n associations without growing.
+  void reserve(size_t n);
+
+ private:
+  // Returns index of entry associated with @key, or `size_` if none.
+  size_t locate(const K &key, const Hash hash_of_key) const;
+
+  // Returns index of first empty or deleted entry @key could occupy.
+  size_t vacancy(const Hash hash_of_key) const;
+
+  // Sets control byte of @entry, and its mirror if it has one.
+  void mark(size_t entry, u8 control);
+
+  // Reallocates to @size entries, reinserting all associations.
+  void rehash(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  // Control bytes are followed by a copy of the first group's, so groups can
+  // be loaded from any entry without wrapping around.
+  u8 *control_;
+  Entry *entries_;
+
+  // Total number of entries. Always zero or a power of two.
+  size_t size_;
+
+  // Number of occupied entries.
+  size_t occupied_;
+
+  // Number of tombstones.
+  size_t deleted_;
+};
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+FlatMap<K,V,F>::FlatMap() {
+  allocator_ = NULL;
+  control_   = NULL;
+  entries_   = NULL;
+  size_      = 0;
+  occupied_  = 0;
+  deleted_   = 0;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+FlatMap<K,V,F>::FlatMap(Allocator *allocator, size_t size) {
+  allocator_ = allocator;
+  control_   = NULL;
+  entries_   = NULL;
+  size_      = 0;
+  occupied_  = 0;
+  deleted_   = 0;
+
+  if (size)
+    this->rehash(size);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+FlatMap<K,V,F>::FlatMap(Allocator &allocator, size_t size) {
+  allocator_ = &allocator;
+  control_   = NULL;
+  entries_   = NULL;
+  size_      = 0;
+  occupied_  = 0;
+  deleted_   = 0;
+
+  if (size)
+    this->rehash(size);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+FlatMap<K,V,F>::~FlatMap() {
+  // Control bytes are allocated alongside entries.
+  if (allocator_ && entries_)
+    allocator_->deallocate((void *)entries_);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+size_t FlatMap<K,V,F>::locate(const K &key, const Hash hash_of_key) const {
+  const size_t mask = size_ - 1;
+
+  const u8 tag = flat_map::h2(hash_of_key);
+
+  // Triangular probing over groups visits every entry when the number of
+  // entries is a power of two.
+  size_t position = flat_map::h1(hash_of_key) & mask;
+  size_t stride = 0;
+
+  while (true) {
+    const flat_map::Group group(&control_[position]);
+
+    for (u32 matches = group.match(tag); matches; matches &= matches - 1) {
+      const size_t entry = (position + bit::ctz(matches)) & mask;
+      if (map::DefaultKeyComparison<K>::equal(entries_[entry].key, key))
+        return entry;
+    }
+
+    if (group.match_empty())
+      // Would have been inserted here.
+      return size_;
+
+    stride += flat_map::GROUP;
+    position = (position + stride) & mask;
+
+    yeti_assert_debug(stride <= size_);
+  }
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+size_t FlatMap<K,V,F>::vacancy(const Hash hash_of_key) const {
+  const size_t mask = size_ - 1;
+
+  size_t position = flat_map::h1(hash_of_key) & mask;
+  size_t stride = 0;
+
+  while (true) {
+    const flat_map::Group group(&control_[position]);
+
+    if (const u32 vacancies = group.match_empty_or_deleted())
+      return (position + bit::ctz(vacancies)) & mask;
+
+    stride += flat_map::GROUP;
+    position = (position + stride) & mask;
+
+    yeti_assert_debug(stride <= size_);
+  }
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::mark(size_t entry, u8 control) {
+  control_[entry] = control;
+
+  // Entries in the first group are mirrored past the end. Otherwise this
+  // writes to the same entry twice.
+  control_[((entry - flat_map::GROUP) & (size_ - 1)) + flat_map::GROUP] = control;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+V *FlatMap<K,V,F>::find(const K &key) {
+  if (occupied_ == 0)
+    return NULL;
+
+  const size_t entry = this->locate(key, F(key));
+
+  return (entry != size_) ? &entries_[entry].value : NULL;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+const V *FlatMap<K,V,F>::find(const K &key) const {
+  if (occupied_ == 0)
+    return NULL;
+
+  const size_t entry = this->locate(key, F(key));
+
+  return (entry != size_) ? &entries_[entry].value : NULL;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+V &FlatMap<K,V,F>::get(const K &key) {
+  V *ptr_to_value = this->find(key);
+  yeti_assert_debug(ptr_to_value != NULL);
+  return *ptr_to_value;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+const V &FlatMap<K,V,F>::get(const K &key) const {
+  const V *ptr_to_value = this->find(key);
+  yeti_assert_debug(ptr_to_value != NULL);
+  return *ptr_to_value;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+V &FlatMap<K,V,F>::emplace(const K &key) {
+  // Rehash when occupied entries and tombstones would exceed 87.5%. Only grow
+  // if occupied entries alone would exceed half, otherwise purging tombstones
+  // frees up enough room.
+  if ((occupied_ + deleted_ + 1) * 8 > size_ * 7)
+    this->rehash(((occupied_ + 1) * 2 > size_) ? size_ * 2 : size_);
+
+  const Hash hash_of_key = F(key);
+
+  // Prevent double insertion.
+  yeti_assert_debug(occupied_ == 0 || this->locate(key, hash_of_key) == size_);
+
+  const size_t entry = this->vacancy(hash_of_key);
+
+  if (control_[entry] == flat_map::DELETED)
+    deleted_ -= 1;
+
+  occupied_ += 1;
+
+  this->mark(entry, flat_map::h2(hash_of_key));
+
+  entries_[entry].key = key;
+
+  return entries_[entry].value;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::insert(const K &key, const V &value) {
+  this->emplace(key) = value;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::remove(const K &key) {
+  if (occupied_ == 0)
+    return;
+
+  const size_t entry = this->locate(key, F(key));
+
+  if (entry == size_)
+    // Not associated.
+    return;
+
+  // PERF(mtwilliams): Mark as empty rather than deleted when no probe could
+  // have passed over this entry, i.e. when there is an empty entry within a
+  // group's distance on either side.
+  this->mark(entry, flat_map::DELETED);
+
+  occupied_ -= 1;
+  deleted_ += 1;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::clear() {
+  if (control_)
+    memory::fill((void *)control_, size_ + flat_map::GROUP, flat_map::EMPTY);
+  occupied_ = 0;
+  deleted_ = 0;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+bool FlatMap<K,V,F>::empty() const {
+  return (occupied_ == 0);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::reserve(size_t n) {
+  // Round up, so that we don't exceed 87.5% load.
+  const size_t required = (n * 8 + 6) / 7;
+
+  if (required > size_)
+    this->rehash(required);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void FlatMap<K,V,F>::rehash(size_t size) {
+  yeti_assert_debug(allocator_ != NULL);
+
+  size_t new_size = flat_map::MINIMUM_NUM_OF_ENTRIES;
+  while (new_size < size)
+    new_size <<= 1;
+
+  yeti_assert_debug(new_size >= occupied_);
+
+  u8 *old_control = control_;
+  Entry *old_entries = entries_;
+  const size_t old_size = size_;
+
+  // Entries and control bytes share an allocation, with entries first so
+  // they're suitably aligned.
+  const size_t entries_in_bytes = new_size * sizeof(Entry);
+  const size_t control_in_bytes = new_size + flat_map::GROUP;
+
+  entries_ = (Entry *)allocator_->allocate(entries_in_bytes + control_in_bytes, alignof(Entry));
+  control_ = (u8 *)entries_ + entries_in_bytes;
+  size_    = new_size;
+
+  memory::fill((void *)control_, control_in_bytes, flat_map::EMPTY);
+
+  deleted_ = 0;
+
+  for (size_t old_entry = 0; old_entry < old_size; ++old_entry) {
+    if (old_control[old_entry] & 0x80)
+      // Empty or deleted.
+      continue;
+
+    const Hash hash_of_key = F(old_entries[old_entry].key);
+
+    const size_t entry = this->vacancy(hash_of_key);
+
+    this->mark(entry, flat_map::h2(hash_of_key));
+
+    entries_[entry] = old_entries[old_entry];
+  }
+
+  if (old_entries)
+    allocator_->deallocate((void *)old_entries);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_FLAT_MAP_H_
@@ -1 +1,282 @@
-// TODO(mtwilliams): Implement a linked-list container.
+//===-- yeti/core/containers/list.h ---------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Intrusive doubly linked lists.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_LIST_H_
+#define _YETI_CORE_CONTAINERS_LIST_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+namespace list {
+
+/// \brief Links an element into a `List`.
+///
+/// \details Elements derive from a node for each list they can be linked
+/// into, distinguished by @Tag. Copies of elements start out unlinked.
+///
+template <typename Tag = void>
+struct Node {
+  Node() : prev(NULL), next(NULL) {}
+  Node(const Node &) : prev(NULL), next(NULL) {}
+  Node &operator=(const Node &) { return *this; }
+
+  /// Determines if linked into a list.
+  bool linked() const { return (next != NULL); }
+
+  Node *prev;
+  Node *next;
+};
+
+}
+
+/// \brief An intrusive doubly linked list.
+///
+/// \details Elements embed their links by deriving from `list::Node<Tag>`,
+/// so linking and unlinking never allocate, and elements can be unlinked
+/// in constant time given just a pointer to them. The list doesn't own its
+/// elements, and elements must be unlinked before they're destroyed.
+///
+/// Links are circular through a sentinel owned by the list, so there are no
+/// special cases at either end.
+///
+template <typename T, typename Tag = void>
+class List {
+ YETI_DISALLOW_COPYING(List)
+
+ public:
+  typedef list::Node<Tag> Node;
+
+ public:
+  List();
+  ~List();
+
+ public:
+  /// Links @element at the front of the list.
+  void push_front(T *element);
+
+  /// Links @element at the back of the list.
+  void push_back(T *element);
+
+  /// Links @element before @position.
+  void insert_before(T *position, T *element);
+
+  /// Links @element after @position.
+  void insert_after(T *position, T *element);
+
+  /// Unlinks @element.
+  void remove(T *element);
+
+  /// Unlinks and returns the element at the front of the list, or `NULL` if
+  /// the list is empty.
+  T *pop_front();
+
+  /// Unlinks and returns the element at the back of the list, or `NULL` if
+  /// the list is empty.
+  T *pop_back();
+
+  /// Unlinks all elements.
+  void clear();
+
+ public:
+  /// Returns the element at the front of the list, or `NULL` if the list is
+  /// empty.
+  T *first() const;
+
+  /// Returns the element at the back of the list, or `NULL` if the list is
+  /// empty.
+  T *last() const;
+
+  /// Returns the element after @element, or `NULL` if @element is last.
+  T *next(const T *element) const;
+
+  /// Returns the element before @element, or `NULL` if @element is first.
+  T *prev(const T *element) const;
+
+ public:
+  /// Returns the number of elements in the list.
+  size_t size() const;
+
+  /// Determines if the list contains no elements.
+  bool empty() const;
+
+ private:
+  static Node *node_from_element(const T *element);
+  T *element_from_node(const Node *node) const;
+
+  static void link(Node *prev, Node *node, Node *next);
+  static void unlink(Node *node);
+
+ private:
+  Node sentinel_;
+  size_t size_;
+};
+
+template <typename T, typename Tag>
+List<T, Tag>::List()
+  : size_(0)
+{
+  sentinel_.prev = sentinel_.next = &sentinel_;
+}
+
+template <typename T, typename Tag>
+List<T, Tag>::~List() {
+  this->clear();
+}
+
+template <typename T, typename Tag>
+typename List<T, Tag>::Node *List<T, Tag>::node_from_element(const T *element) {
+  yeti_assert_debug(element != NULL);
+  return static_cast<Node *>(const_cast<T *>(element));
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::element_from_node(const Node *node) const {
+  if (node == &sentinel_)
+    return NULL;
+  return static_cast<T *>(const_cast<Node *>(node));
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::link(Node *prev, Node *node, Node *next) {
+  yeti_assert_with_reason_debug(!node->linked(), "Already linked.");
+
+  node->prev = prev;
+  node->next = next;
+
+  prev->next = node;
+  next->prev = node;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::unlink(Node *node) {
+  yeti_assert_with_reason_debug(node->linked(), "Not linked.");
+
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+
+  node->prev = node->next = NULL;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::push_front(T *element) {
+  link(&sentinel_, node_from_element(element), sentinel_.next);
+  size_ += 1;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::push_back(T *element) {
+  link(sentinel_.prev, node_from_element(element), &sentinel_);
+  size_ += 1;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::insert_before(T *position, T *element) {
+  Node *node = node_from_element(position);
+  link(node->prev, node_from_element(element), node);
+  size_ += 1;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::insert_after(T *position, T *element) {
+  Node *node = node_from_element(position);
+  link(node, node_from_element(element), node->next);
+  size_ += 1;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::remove(T *element) {
+  unlink(node_from_element(element));
+  size_ -= 1;
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::pop_front() {
+  if (T *element = this->first()) {
+    this->remove(element);
+    return element;
+  }
+
+  return NULL;
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::pop_back() {
+  if (T *element = this->last()) {
+    this->remove(element);
+    return element;
+  }
+
+  return NULL;
+}
+
+template <typename T, typename Tag>
+void List<T, Tag>::clear() {
+  // Unlink each element so they know they're no longer linked.
+  Node *node = sentinel_.next;
+
+  while (node != &sentinel_) {
+    Node *next = node->next;
+    node->prev = node->next = NULL;
+    node = next;
+  }
+
+  sentinel_.prev = sentinel_.next = &sentinel_;
+  size_ = 0;
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::first() const {
+  return element_from_node(sentinel_.next);
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::last() const {
+  return element_from_node(sentinel_.prev);
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::next(const T *element) const {
+  return element_from_node(node_from_element(element)->next);
+}
+
+template <typename T, typename Tag>
+T *List<T, Tag>::prev(const T *element) const {
+  return element_from_node(node_from_element(element)->prev);
+}
+
+template <typename T, typename Tag>
+size_t List<T, Tag>::size() const {
+  return size_;
+}
+
+template <typename T, typename Tag>
+bool List<T, Tag>::empty() const {
+  return (size_ == 0);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_LIST_H_
@@ -145,12 +145,53 @@ template <> struct IdentityHashFunction<u64, 64> {
   static u64 hash(const u64 key) { return key; }
 };
 
+/// \brief Default key comparison.
+///
+/// \details Compares by value, except for strings which are compared by
+/// content.
+///
+template <typename K>
+struct DefaultKeyComparison {
+  static bool equal(const K &lhs, const K &rhs) {
+    return (lhs == rhs);
+  }
+};
+
+template <> struct DefaultKeyComparison<const char *> {
+  static bool equal(const char *lhs, const char *rhs) {
+    return string::compare(lhs, rhs);
+  }
+};
+
+/// \internal Marks @hash as belonging to an occupied entry.
+///
+/// \details The most significant bit is never used to pick an entry, since
+/// maps never approach that many entries, so we set it to distinguish
+/// occupied entries from empty (zeroed) ones.
+///
+static YETI_INLINE Hash occupied(const Hash hash) {
+  return hash | (Hash(1) << (Bits - 1));
+}
+
+/// \internal Minimum number of entries allocated.
+static const size_t MINIMUM_NUM_OF_ENTRIES = 16;
+
 }
 
 /// \brief A dynamically resized hash map.
+///
+/// \details Uses open addressing with linear probing over a power-of-two
+/// number of entries. Keys are stored alongside their hashes, so keys that
+/// hash the same are still distinguished. Removal shifts subsequent entries
+/// back rather than leaving tombstones, so probe sequences never lengthen.
+/// Doubles in size when more than three-quarters full.
+///
+/// \warning Keys and values are copied bitwise when the map grows, and
+/// aren't constructed or destructed.
+///
 template <typename K, typename V,
           typename map::HashFunctionSignature<K>::Type F =
-            map::DefaultHashFunction<typename K>::hash>
+            map::DefaultHashFunction<K>::hash>
 class Map {
  // Copying a map does not make a lot of sense. If you find yourself needing to
  // copy a map, rethink what you're trying to do.
@@ -160,15 +201,20 @@ class Map {
   typedef map::Hash Hash;
 
   struct Entry {
+    // Zero if unoccupied. See `map::occupied`.
     Hash hash_of_key;
+    K    key;
     V    value;
   };
 
  public:
   Map();
 
+  /// \param @size Initial number of entries, rounded up to a power of two.
+  /// @{
   explicit Map(Allocator *allocator, size_t size = 0);
   explicit Map(Allocator &allocator, size_t size = 0);
+  /// @}
 
   ~Map();
 
@@ -200,12 +246,22 @@ class Map {
   /// Determines if the map doesn't contain any associations.
   bool empty() const;
 
+  /// Makes room for at least @n associations without growing.
+  void reserve(size_t n);
+
+ private:
+  // Returns index of entry associated with @key, or `size_` if none.
+  size_t locate(const K &key, const Hash hash_of_key) const;
+
+  // Reallocates to @size entries, reinserting all associations.
+  void rehash(size_t size);
+
  private:
   Allocator *allocator_;
 
   Entry *entries_;
 
-  // Total number of entries.
+  // Total number of entries. Always zero or a power of two.
   size_t size_;
 
   // Number of occupied entries.
@@ -223,58 +279,64 @@ Map<K,V,F>::Map() {
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 Map<K,V,F>::Map(Allocator *allocator, size_t size) {
   allocator_ = allocator;
-
-  entries_   = (Entry *)allocator_->allocate(size * sizeof(Entry), alignof(Entry));
-  size_      = size;
+  entries_   = NULL;
+  size_      = 0;
   occupied_  = 0;
 
-  memory::zero((void *)entries_, size * sizeof(Entry));
+  if (size)
+    this->rehash(size);
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 Map<K,V,F>::Map(Allocator &allocator, size_t size) {
   allocator_ = &allocator;
-
-  entries_   = (Entry *)allocator_->allocate(size * sizeof(Entry), alignof(Entry));
-  size_      = size;
+  entries_   = NULL;
+  size_      = 0;
   occupied_  = 0;
 
-  memory::zero((void *)entries_, size * sizeof(Entry));
+  if (size)
+    this->rehash(size);
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 Map<K,V,F>::~Map() {
-  if (allocator_)
+  if (allocator_ && entries_)
     allocator_->deallocate((void *)entries_);
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
-V *Map<K,V,F>::find(const K &key) {
-  const Hash hash_of_key = F(key);
+size_t Map<K,V,F>::locate(const K &key, const Hash hash_of_key) const {
+  const size_t mask = size_ - 1;
 
-  for (size_t entry = hash_of_key % size_;
+  for (size_t entry = hash_of_key & mask;
        entries_[entry].hash_of_key != 0;
-       entry = (entry + 1) % size_)
+       entry = (entry + 1) & mask)
     if (entries_[entry].hash_of_key == hash_of_key)
-      return &entries_[entry].value;
+      if (map::DefaultKeyComparison<K>::equal(entries_[entry].key, key))
+        return entry;
 
   // Not found.
-  return NULL;
+  return size_;
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+V *Map<K,V,F>::find(const K &key) {
+  if (occupied_ == 0)
+    return NULL;
+
+  const size_t entry = this->locate(key, map::occupied(F(key)));
+
+  return (entry != size_) ? &entries_[entry].value : NULL;
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 const V *Map<K,V,F>::find(const K &key) const {
-  const Hash hash_of_key = F(key);
+  if (occupied_ == 0)
+    return NULL;
 
-  for (size_t entry = hash_of_key % size_;
-       entries_[entry].hash_of_key != 0;
-       entry = (entry + 1) % size_) {
-    if (entries_[entry].hash_of_key == hash_of_key)
-      return &entries_[entry].value;
-  }
+  const size_t entry = this->locate(key, map::occupied(F(key)));
 
-  // Not found.
-  return NULL;
+  return (entry != size_) ? &entries_[entry].value : NULL;
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
@@ -293,22 +355,28 @@ const V &Map<K,V,F>::get(const K &key) const {
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 V &Map<K,V,F>::emplace(const K &key) {
-  // TODO(mtwilliams): Grow or shrink hash map when load is ~75%.
-  yeti_assert_development(((occupied_ * 100) / (size_ * 100)) <= 75);
+  // Grow when load would exceed 75%.
+  if ((occupied_ + 1) * 4 > size_ * 3)
+    this->rehash(size_ * 2);
 
-  const Hash hash_of_key = F(key);
+  const Hash hash_of_key = map::occupied(F(key));
+
+  const size_t mask = size_ - 1;
 
   size_t entry;
-  for (entry = hash_of_key % size_;
+  for (entry = hash_of_key & mask;
        entries_[entry].hash_of_key != 0;
-       entry = (entry + 1) % size_) {
+       entry = (entry + 1) & mask) {
     // Prevent double insertion.
-    yeti_assert_debug(entries_[entry].hash_of_key != hash_of_key);
+    yeti_assert_debug(!((entries_[entry].hash_of_key == hash_of_key) &&
+                        map::DefaultKeyComparison<K>::equal(entries_[entry].key, key)));
   }
 
   occupied_ += 1;
 
   entries_[entry].hash_of_key = hash_of_key;
+  entries_[entry].key = key;
+
   return entries_[entry].value;
 }
 
@@ -319,21 +387,40 @@ void Map<K,V,F>::insert(const K &key, const V &value) {
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 void Map<K,V,F>::remove(const K &key) {
-  const Hash hash_of_key = F(key);
+  if (occupied_ == 0)
+    return;
 
-  for (size_t entry = hash_of_key % size_;
+  size_t hole = this->locate(key, map::occupied(F(key)));
+
+  if (hole == size_)
+    // Not associated.
+    return;
+
+  const size_t mask = size_ - 1;
+
+  // Shift back any subsequent entries that would become unreachable, which
+  // are those that can't be reached from their ideal entry without passing
+  // through the hole.
+  for (size_t entry = (hole + 1) & mask;
        entries_[entry].hash_of_key != 0;
-       entry = (entry + 1) % size_) {
-    if (entries_[entry].hash_of_key == hash_of_key) {
-      memory::zero((void *)&entries_[entry], sizeof(Entry));
-      return;
+       entry = (entry + 1) & mask) {
+    const size_t ideal = entries_[entry].hash_of_key & mask;
+
+    if (((entry - ideal) & mask) >= ((entry - hole) & mask)) {
+      entries_[hole] = entries_[entry];
+      hole = entry;
     }
   }
+
+  memory::zero((void *)&entries_[hole], sizeof(Entry));
+
+  occupied_ -= 1;
 }
 
 template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
 void Map<K,V,F>::clear() {
-  memory::zero((void *)entries_, size_ * sizeof(Entry));
+  if (entries_)
+    memory::zero((void *)entries_, size_ * sizeof(Entry));
   occupied_ = 0;
 }
 
@@ -342,6 +429,51 @@ bool Map<K,V,F>::empty() const {
   return (occupied_ == 0);
 }
 
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void Map<K,V,F>::reserve(size_t n) {
+  // Round up, so that we don't exceed 75% load.
+  const size_t required = (n * 4 + 2) / 3;
+
+  if (required > size_)
+    this->rehash(required);
+}
+
+template <typename K, typename V, typename map::HashFunctionSignature<K>::Type F>
+void Map<K,V,F>::rehash(size_t size) {
+  yeti_assert_debug(allocator_ != NULL);
+
+  size_t new_size = map::MINIMUM_NUM_OF_ENTRIES;
+  while (new_size < size)
+    new_size <<= 1;
+
+  yeti_assert_debug(new_size >= occupied_);
+
+  Entry *old_entries = entries_;
+  const size_t old_size = size_;
+
+  entries_ = (Entry *)allocator_->allocate(new_size * sizeof(Entry), alignof(Entry));
+  size_    = new_size;
+
+  memory::zero((void *)entries_, new_size * sizeof(Entry));
+
+  const size_t mask = new_size - 1;
+
+  for (size_t old_entry = 0; old_entry < old_size; ++old_entry) {
+    if (old_entries[old_entry].hash_of_key == 0)
+      continue;
+
+    size_t entry;
+    for (entry = old_entries[old_entry].hash_of_key & mask;
+         entries_[entry].hash_of_key != 0;
+         entry = (entry + 1) & mask);
+
+    entries_[entry] = old_entries[old_entry];
+  }
+
+  if (old_entries)
+    allocator_->deallocate((void *)old_entries);
+}
+
 } // core
 } // yeti
 
@@ -0,0 +1,269 @@
+//===-- yeti/core/containers/mpmc_queue.h ---------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Lock-free queues with any number of producers and consumers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_MPMC_QUEUE_H_
+#define _YETI_CORE_CONTAINERS_MPMC_QUEUE_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+#include "yeti/core/atomics.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+// For storage of elements that aren't constructed yet.
+#include <type_traits>
+
+// To move elements out.
+#include <utility>
+
+namespace yeti {
+namespace core {
+
+/// \brief A fixed size, lock-free queue for any number of producers and
+/// consumers.
+///
+/// \details Based on Dmitry Vyukov's bounded queue. Every slot carries a
+/// sequence number that says whose turn it is: producers claim a slot when
+/// its sequence matches their position, and consumers when it's one past
+/// theirs. Producers and consumers only contend amongst themselves, through
+/// a compare-and-exchange on their respective positions.
+///
+template <typename T>
+class MpmcQueue {
+ // Copying a queue that is being concurrently accessed is nonsensical.
+ YETI_DISALLOW_COPYING(MpmcQueue)
+
+ private:
+  struct Slot {
+    volatile u32 sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type element;
+  };
+
+ public:
+  /// \param @size Maximum number of elements, rounded up to a power of two.
+  /// @{
+  explicit MpmcQueue(Allocator *allocator, size_t size);
+  explicit MpmcQueue(Allocator &allocator, size_t size);
+  /// @}
+
+  ~MpmcQueue();
+
+ public:
+  /// Pushes @element to the back of the queue.
+  /// \return If there was room for @element.
+  bool push(const T &element);
+
+  /// Pops an element from the front of the queue and moves it to @element.
+  /// \return If an element was popped.
+  bool pop(T *element);
+
+  /// Returns the maximum number of elements that can be stored in the queue.
+  size_t size() const;
+
+  /// Computes the number of elements in the queue.
+  ///
+  /// \warning Stale by the time it returns if the queue is being accessed.
+  ///
+  size_t depth() const;
+
+  /// Determines if the queue doesn't hold any elements.
+  ///
+  /// \warning Stale by the time it returns if the queue is being accessed.
+  ///
+  bool empty() const;
+
+ private:
+  void initialize(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  Slot *slots_;
+
+  u32 mask_;
+
+  u8 padding_after_shared_[YETI_CACHE_LINE];
+
+  // Position of next slot to push to. Contended by producers.
+  volatile u32 write_;
+
+  u8 padding_after_producers_[YETI_CACHE_LINE];
+
+  // Position of next slot to pop from. Contended by consumers.
+  volatile u32 read_;
+
+  u8 padding_after_consumers_[YETI_CACHE_LINE];
+};
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(Allocator *allocator, size_t size) {
+  allocator_ = allocator;
+  this->initialize(size);
+}
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(Allocator &allocator, size_t size) {
+  allocator_ = &allocator;
+  this->initialize(size);
+}
+
+template <typename T>
+void MpmcQueue<T>::initialize(size_t size) {
+  yeti_assert_debug(size > 0);
+  yeti_assert_debug(size <= 0x80000000u);
+
+  // Need at least two slots to distinguish full from empty by sequence.
+  size_t rounded = 2;
+  while (rounded < size)
+    rounded <<= 1;
+
+  slots_ = (Slot *)allocator_->allocate(rounded * sizeof(Slot), alignof(Slot));
+  mask_  = (u32)(rounded - 1);
+
+  // Every slot starts off as the turn of the producer at its position.
+  for (u32 slot = 0; slot <= mask_; ++slot)
+    slots_[slot].sequence = slot;
+
+  write_ = 0;
+  read_ = 0;
+}
+
+template <typename T>
+MpmcQueue<T>::~MpmcQueue() {
+  // Destruct any elements left behind.
+  for (u32 read = read_; read != write_; ++read)
+    ((T *)&slots_[read & mask_].element)->~T();
+
+  allocator_->deallocate((void *)slots_);
+}
+
+template <typename T>
+bool MpmcQueue<T>::push(const T &element) {
+  u32 position = atomic::load(&write_);
+
+  Slot *slot;
+
+  while (true) {
+    slot = &slots_[position & mask_];
+
+    const u32 sequence = atomic::load(&slot->sequence);
+    const i32 difference = (i32)(sequence - position);
+
+    if (difference == 0) {
+      // Our turn, if no other producer beats us to it.
+      const u32 claimed = atomic::cmp_and_xchg(&write_, position, position + 1);
+
+      if (claimed == position)
+        break;
+
+      position = claimed;
+    } else if (difference < 0) {
+      // Slot still holds an element from the last lap, so we're full.
+      return false;
+    } else {
+      // Another producer claimed this slot.
+      position = atomic::load(&write_);
+    }
+  }
+
+  // Don't let the element be written before we've claimed its slot.
+  atomic::barrier();
+
+  new ((void *)&slot->element) T(element);
+
+  // Publish only after the element is written.
+  atomic::barrier();
+
+  atomic::store(&slot->sequence, position + 1);
+
+  return true;
+}
+
+template <typename T>
+bool MpmcQueue<T>::pop(T *element) {
+  u32 position = atomic::load(&read_);
+
+  Slot *slot;
+
+  while (true) {
+    slot = &slots_[position & mask_];
+
+    const u32 sequence = atomic::load(&slot->sequence);
+    const i32 difference = (i32)(sequence - (position + 1));
+
+    if (difference == 0) {
+      // Our turn, if no other consumer beats us to it.
+      const u32 claimed = atomic::cmp_and_xchg(&read_, position, position + 1);
+
+      if (claimed == position)
+        break;
+
+      position = claimed;
+    } else if (difference < 0) {
+      // Slot hasn't been pushed to yet, so we're empty.
+      return false;
+    } else {
+      // Another consumer claimed this slot.
+      position = atomic::load(&read_);
+    }
+  }
+
+  // Don't let the element be read before we've claimed its slot.
+  atomic::barrier();
+
+  T *ptr_to_element = (T *)&slot->element;
+  *element = std::move(*ptr_to_element);
+  ptr_to_element->~T();
+
+  // Release the slot only after the element is read.
+  atomic::barrier();
+
+  // Hand the slot to the producer one lap ahead.
+  atomic::store(&slot->sequence, position + mask_ + 1);
+
+  return true;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::size() const {
+  return (size_t)mask_ + 1;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::depth() const {
+  // Read consumers' position first, so we never see it pass producers'.
+  const u32 read = atomic::load(&read_);
+  atomic::barrier();
+  const u32 write = atomic::load(&write_);
+  return (size_t)(write - read);
+}
+
+template <typename T>
+bool MpmcQueue<T>::empty() const {
+  return (this->depth() == 0);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_MPMC_QUEUE_H_
@@ -0,0 +1,363 @@
+//===-- yeti/core/containers/slot_map.h -----------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Densely packed storage addressed by generation-checked handles.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_SLOT_MAP_H_
+#define _YETI_CORE_CONTAINERS_SLOT_MAP_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/allocator.h"
+
+// Elements and bookkeeping are stored in arrays.
+#include "yeti/core/containers/array.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+// To move elements when compacting.
+#include <utility>
+
+namespace yeti {
+namespace core {
+
+namespace slot_map {
+
+/// \brief Refers to an element in a `SlotMap`.
+///
+/// \details Handles are invalidated when the element they refer to is
+/// removed, even if the slot is reused. A zeroed handle is never valid.
+///
+struct Handle {
+  u32 index;
+  u32 generation;
+};
+
+/// \internal Marks the end of the free list.
+static const u32 NONE = 0xFFFFFFFFul;
+
+}
+
+/// \brief Densely packed storage addressed by generation-checked handles.
+///
+/// \details Elements are kept packed, so iterating over them is as cheap as
+/// iterating over an array. Handles refer to slots, which in turn refer to
+/// elements. Removal moves the last element into the hole, and updates the
+/// slot referring to it. Slots carry a generation that is bumped whenever
+/// they're freed, so stale handles are detected with a single comparison.
+///
+/// \warning Pointers to elements are invalidated by insertion and removal.
+/// Hold on to handles instead.
+///
+template <typename T>
+class SlotMap {
+ YETI_DISALLOW_COPYING(SlotMap)
+
+ public:
+  typedef slot_map::Handle Handle;
+
+ private:
+  struct Slot {
+    // Index of element if occupied, otherwise index of next free slot.
+    u32 element_or_next;
+
+    // Bumped whenever freed.
+    u32 generation;
+  };
+
+ public:
+  SlotMap();
+
+  /// \param @size Number of elements to reserve space for.
+  /// @{
+  explicit SlotMap(Allocator *allocator, size_t size = 0);
+  explicit SlotMap(Allocator &allocator, size_t size = 0);
+  /// @}
+
+  ~SlotMap();
+
+ public:
+  /// Inserts @value, returning a handle to refer to it by.
+  Handle insert(const T &value);
+
+  /// Constructs an element, storing a handle to refer to it by in @handle.
+  T &emplace(Handle *handle);
+
+  /// Removes the element referred to by @handle.
+  /// \return If @handle referred to an element.
+  bool remove(Handle handle);
+
+  /// Removes all elements, invalidating all handles.
+  void clear();
+
+ public:
+  /// Determines if @handle refers to an element.
+  bool valid(Handle handle) const;
+
+  /// Returns a pointer to the element referred to by @handle, or `NULL` if
+  /// @handle is stale.
+  /// @{
+  T *find(Handle handle);
+  const T *find(Handle handle) const;
+  /// @}
+
+  /// Returns the element referred to by @handle.
+  /// @{
+  T &get(Handle handle);
+  const T &get(Handle handle) const;
+  /// @}
+
+ public:
+  /// Returns the handle that refers to the element at @index in packed
+  /// storage.
+  Handle handle_from_index(size_t index) const;
+
+  /// Returns the index in packed storage of the element referred to by
+  /// @handle.
+  size_t index_from_handle(Handle handle) const;
+
+ public:
+  /// Returns a pointer to the first element.
+  /// @{
+  T *begin();
+  const T *begin() const;
+  /// @}
+
+  /// Returns a pointer past the last element.
+  /// @{
+  T *end();
+  const T *end() const;
+  /// @}
+
+  /// Returns the number of elements.
+  size_t size() const;
+
+  /// Determines if there are no elements.
+  bool empty() const;
+
+ private:
+  // Claims a slot for an element about to be pushed.
+  Handle claim();
+
+ private:
+  // Packed.
+  Array<T> elements_;
+
+  // Maps each element back to the slot that refers to it, so that slots can
+  // be updated when elements are moved.
+  Array<u32> element_to_slot_;
+
+  Array<Slot> slots_;
+
+  // Head of the free list.
+  u32 free_;
+};
+
+template <typename T>
+SlotMap<T>::SlotMap()
+  : free_(slot_map::NONE)
+{
+}
+
+template <typename T>
+SlotMap<T>::SlotMap(Allocator *allocator, size_t size)
+  : elements_(allocator)
+  , element_to_slot_(allocator)
+  , slots_(allocator)
+  , free_(slot_map::NONE)
+{
+  elements_.reserve(size);
+  element_to_slot_.reserve(size);
+  slots_.reserve(size);
+}
+
+template <typename T>
+SlotMap<T>::SlotMap(Allocator &allocator, size_t size)
+  : elements_(allocator)
+  , element_to_slot_(allocator)
+  , slots_(allocator)
+  , free_(slot_map::NONE)
+{
+  elements_.reserve(size);
+  element_to_slot_.reserve(size);
+  slots_.reserve(size);
+}
+
+template <typename T>
+SlotMap<T>::~SlotMap() {
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::claim() {
+  u32 slot;
+
+  if (free_ != slot_map::NONE) {
+    slot = free_;
+    free_ = slots_[slot].element_or_next;
+  } else {
+    slot = (u32)slots_.size();
+    Slot &fresh = slots_.emplace();
+    // Start at one so zeroed handles are never valid.
+    fresh.generation = 1;
+  }
+
+  slots_[slot].element_or_next = (u32)elements_.size();
+
+  element_to_slot_.push(slot);
+
+  const Handle handle = { slot, slots_[slot].generation };
+  return handle;
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::insert(const T &value) {
+  const Handle handle = this->claim();
+  elements_.push(value);
+  return handle;
+}
+
+template <typename T>
+T &SlotMap<T>::emplace(Handle *handle) {
+  *handle = this->claim();
+  return elements_.emplace();
+}
+
+template <typename T>
+bool SlotMap<T>::remove(Handle handle) {
+  if (!this->valid(handle))
+    return false;
+
+  Slot &slot = slots_[handle.index];
+
+  const u32 hole = slot.element_or_next;
+  const u32 last = (u32)elements_.size() - 1;
+
+  if (hole != last) {
+    // Move last element into the hole to keep elements packed.
+    elements_[hole] = std::move(elements_[last]);
+    element_to_slot_[hole] = element_to_slot_[last];
+    slots_[element_to_slot_[hole]].element_or_next = hole;
+  }
+
+  elements_.pop();
+  element_to_slot_.pop();
+
+  // Invalidate outstanding handles.
+  slot.generation += 1;
+
+  slot.element_or_next = free_;
+  free_ = handle.index;
+
+  return true;
+}
+
+template <typename T>
+void SlotMap<T>::clear() {
+  // Free every occupied slot.
+  for (const u32 *I = element_to_slot_.begin(); I != element_to_slot_.end(); ++I) {
+    slots_[*I].generation += 1;
+    slots_[*I].element_or_next = free_;
+    free_ = *I;
+  }
+
+  elements_.clear();
+  element_to_slot_.clear();
+}
+
+template <typename T>
+bool SlotMap<T>::valid(Handle handle) const {
+  // Free slots have moved on to the next generation, so only occupied slots
+  // can match.
+  return (handle.index < slots_.size())
+      && (slots_[handle.index].generation == handle.generation);
+}
+
+template <typename T>
+T *SlotMap<T>::find(Handle handle) {
+  if (!this->valid(handle))
+    return NULL;
+  return &elements_[slots_[handle.index].element_or_next];
+}
+
+template <typename T>
+const T *SlotMap<T>::find(Handle handle) const {
+  if (!this->valid(handle))
+    return NULL;
+  return &elements_[slots_[handle.index].element_or_next];
+}
+
+template <typename T>
+T &SlotMap<T>::get(Handle handle) {
+  yeti_assert_with_reason_debug(this->valid(handle), "Stale handle.");
+  return elements_[slots_[handle.index].element_or_next];
+}
+
+template <typename T>
+const T &SlotMap<T>::get(Handle handle) const {
+  yeti_assert_with_reason_debug(this->valid(handle), "Stale handle.");
+  return elements_[slots_[handle.index].element_or_next];
+}
+
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::handle_from_index(size_t index) const {
+  const u32 slot = element_to_slot_[index];
+  const Handle handle = { slot, slots_[slot].generation };
+  return handle;
+}
+
+template <typename T>
+size_t SlotMap<T>::index_from_handle(Handle handle) const {
+  yeti_assert_with_reason_debug(this->valid(handle), "Stale handle.");
+  return slots_[handle.index].element_or_next;
+}
+
+template <typename T>
+T *SlotMap<T>::begin() {
+  return elements_.begin();
+}
+
+template <typename T>
+const T *SlotMap<T>::begin() const {
+  return elements_.begin();
+}
+
+template <typename T>
+T *SlotMap<T>::end() {
+  return elements_.end();
+}
+
+template <typename T>
+const T *SlotMap<T>::end() const {
+  return elements_.end();
+}
+
+template <typename T>
+size_t SlotMap<T>::size() const {
+  return elements_.size();
+}
+
+template <typename T>
+bool SlotMap<T>::empty() const {
+  return elements_.empty();
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_SLOT_MAP_H_
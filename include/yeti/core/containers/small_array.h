@@ -0,0 +1,490 @@
+//===-- yeti/core/containers/small_array.h --------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Dynamically resizeable arrays that store a few elements inline.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_SMALL_ARRAY_H_
+#define _YETI_CORE_CONTAINERS_SMALL_ARRAY_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+
+// Shares element construction.
+#include "yeti/core/containers/array.h"
+
+// For bounds checking in debug builds.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+/// \brief A dynamically resizeable array that stores up to @N elements
+/// inline.
+///
+/// \details Behaves like `Array`, but only allocates once it holds more than
+/// @N elements. Useful for arrays that usually hold a handful of elements,
+/// where allocating would dominate. Moves back inline when shrunk to fit @N
+/// or fewer elements.
+///
+/// An allocator isn't required unless the array ever holds more than @N
+/// elements.
+///
+template <typename T, size_t N>
+class SmallArray {
+ public:
+  SmallArray();
+
+  /// \param @size Initial number of elements.
+  /// @{
+  explicit SmallArray(Allocator *allocator, size_t size = 0);
+  explicit SmallArray(Allocator &allocator, size_t size = 0);
+  /// @}
+
+  SmallArray(const SmallArray<T,N> &array);
+  SmallArray<T,N> &operator=(const SmallArray<T,N> &array);
+
+  ~SmallArray();
+
+ public:
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+ public:
+  /// Returns the position of the value at @pointer in the array.
+  size_t index_from_pointer(const T *pointer) const;
+
+  /// Returns a pointer to the element at @index in the array.
+  T *pointer_from_index(size_t index);
+  const T *pointer_from_index(size_t index) const;
+
+ public:
+  /// Constructs an element at the back of the array.
+  T &emplace();
+
+  /// Pushes @element to the back of the array.
+  ///
+  /// \return Index of newly appended element.
+  ///
+  size_t push(const T &element);
+
+  /// Pops an element from the back of the array and copies it to @element.
+  void pop(T *element);
+
+  /// Pops an element from the back of the array.
+  void pop();
+
+  /// Returns a pointer to the first element in the array.
+  /// @{
+  T *begin();
+  const T *begin() const;
+  /// @}
+
+  /// Returns a pointer past the last element in the array.
+  /// @{
+  T *end();
+  const T *end() const;
+  /// @}
+
+  /// Resizes the array to store @size elements.
+  void resize(size_t size);
+
+  /// Grows the array to store @amount additional elements.
+  void grow(size_t amount);
+
+  /// Reserves space to hold @additional elements without reallocating.
+  void reserve(size_t additional);
+
+  /// Releases any space reserved beyond what is needed for elements, moving
+  /// elements back inline if they fit.
+  void shrink_to_fit();
+
+  /// Empties the array, keeping space reserved for reuse.
+  void clear();
+
+  /// Returns the number of elements in the array.
+  size_t size() const;
+
+  /// Returns the amount of space available for elements.
+  size_t reserved() const;
+
+  /// Determines if the array contains no elements.
+  bool empty() const;
+
+  /// Determines if elements are stored inline.
+  bool inlined() const;
+
+ public:
+  /// Returns a pointer to the first occurrence of @value in the the array.
+  /// @{
+  T *find(const T &value);
+  const T *find(const T &value) const;
+  /// @}
+
+ public:
+  /// Returns the position of the first occurance of @value in the array.
+  size_t position(const T &value) const;
+
+ public:
+  T *raw() { return (T *)first_; }
+  const T *raw() const { return (const T *)first_; }
+
+ private:
+  // Destructs elements in [@first, @last).
+  static void destruct(T *first, T *last);
+
+  // Reallocates to hold exactly @capacity elements, or moves inline if
+  // @capacity is @N or fewer.
+  void relocate(size_t capacity);
+
+  // Reallocates, if necessary, to hold at least @size elements. Grows
+  // geometrically to amortize the cost of reallocation.
+  void ensure(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  uintptr_t first_;
+  uintptr_t last_;
+  uintptr_t end_;
+
+  typename std::aligned_storage<N * sizeof(T), alignof(T)>::type storage_;
+};
+
+template <typename T, size_t N>
+SmallArray<T,N>::SmallArray() {
+  allocator_ = NULL;
+  first_ = last_ = (uintptr_t)&storage_;
+  end_ = first_ + N * sizeof(T);
+}
+
+template <typename T, size_t N>
+SmallArray<T,N>::SmallArray(Allocator *allocator, size_t size) {
+  allocator_ = allocator;
+  first_ = last_ = (uintptr_t)&storage_;
+  end_ = first_ + N * sizeof(T);
+
+  if (size)
+    this->resize(size);
+}
+
+template <typename T, size_t N>
+SmallArray<T,N>::SmallArray(Allocator &allocator, size_t size) {
+  allocator_ = &allocator;
+  first_ = last_ = (uintptr_t)&storage_;
+  end_ = first_ + N * sizeof(T);
+
+  if (size)
+    this->resize(size);
+}
+
+template <typename T, size_t N>
+SmallArray<T,N>::SmallArray(const SmallArray<T,N> &array) {
+  allocator_ = array.allocator_;
+  first_ = last_ = (uintptr_t)&storage_;
+  end_ = first_ + N * sizeof(T);
+
+  *this = array;
+}
+
+template <typename T, size_t N>
+SmallArray<T,N> &SmallArray<T,N>::operator=(const SmallArray<T,N> &array) {
+  if (&array == this)
+    return *this;
+
+  destruct(this->begin(), this->end());
+  last_ = first_;
+
+  if (allocator_ != array.allocator_) {
+    // Memory has to come from the same allocator as the array we're copying.
+    if (!this->inlined())
+      allocator_->deallocate((void *)first_);
+
+    allocator_ = array.allocator_;
+
+    first_ = last_ = (uintptr_t)&storage_;
+    end_ = first_ + N * sizeof(T);
+  }
+
+  const size_t size = array.size();
+
+  if (size > this->reserved())
+    this->relocate(size);
+
+  if (std::is_trivially_copyable<T>::value) {
+    if (size)
+      memory::copy((const void *)array.first_, (void *)first_, size * sizeof(T));
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      new ((void *)&((T *)first_)[i]) T(array[i]);
+  }
+
+  last_ = first_ + size * sizeof(T);
+
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallArray<T,N>::~SmallArray() {
+  destruct(this->begin(), this->end());
+
+  if (!this->inlined())
+    allocator_->deallocate((void *)first_);
+}
+
+template <typename T, size_t N>
+T &SmallArray<T,N>::operator[](size_t index) {
+  yeti_assert_debug(index < size());
+  return ((T *)first_)[index];
+}
+
+template <typename T, size_t N>
+const T &SmallArray<T,N>::operator[](size_t index) const {
+  yeti_assert_debug(index < size());
+  return ((const T *)first_)[index];
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T,N>::index_from_pointer(const T *pointer) const {
+  yeti_assert_debug(uintptr_t(pointer) >= first_ && uintptr_t(pointer) < last_);
+  return (size_t)(pointer - ((const T *)first_));
+}
+
+template <typename T, size_t N>
+T *SmallArray<T,N>::pointer_from_index(size_t index) {
+  return &(*this)[index];
+}
+
+template <typename T, size_t N>
+const T *SmallArray<T,N>::pointer_from_index(size_t index) const {
+  return &(*this)[index];
+}
+
+template <typename T, size_t N>
+T &SmallArray<T,N>::emplace() {
+  this->resize(this->size() + 1);
+  return ((T *)last_)[-1];
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T,N>::push(const T &element) {
+  const size_t size = this->size();
+
+  if (size + 1 > this->reserved()) {
+    // Copy first, as @element may live in the array.
+    const T copy(element);
+    this->ensure(size + 1);
+    new ((void *)last_) T(std::move(copy));
+  } else {
+    new ((void *)last_) T(element);
+  }
+
+  last_ += sizeof(T);
+
+  return size;
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::pop(T *element) {
+  yeti_assert_debug(!this->empty());
+  *element = std::move(((T *)last_)[-1]);
+  this->pop();
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::pop() {
+  yeti_assert_debug(!this->empty());
+  last_ -= sizeof(T);
+  destruct((T *)last_, (T *)last_ + 1);
+}
+
+template <typename T, size_t N>
+T *SmallArray<T,N>::begin() {
+  return (T *)first_;
+}
+
+template <typename T, size_t N>
+const T *SmallArray<T,N>::begin() const {
+  return (const T *)first_;
+}
+
+template <typename T, size_t N>
+T *SmallArray<T,N>::end() {
+  return ((T *)last_);
+}
+
+template <typename T, size_t N>
+const T *SmallArray<T,N>::end() const {
+  return ((const T *)last_);
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::resize(size_t size) {
+  const size_t current = this->size();
+
+  if (size > current) {
+    this->ensure(size);
+    array::Constructor<T>::construct((T *)last_, (T *)first_ + size);
+  } else if (size < current) {
+    destruct((T *)first_ + size, (T *)last_);
+  }
+
+  last_ = first_ + size * sizeof(T);
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::grow(size_t amount) {
+  this->resize(this->size() + amount);
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::reserve(size_t additional) {
+  const size_t required = this->size() + additional;
+
+  if (required > this->reserved())
+    this->relocate(required);
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::shrink_to_fit() {
+  if (!this->inlined() && this->reserved() > this->size())
+    this->relocate(this->size());
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::clear() {
+  destruct(this->begin(), this->end());
+  last_ = first_;
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T,N>::size() const {
+  return (last_ - first_) / sizeof(T);
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T,N>::reserved() const {
+  return (end_ - first_) / sizeof(T);
+}
+
+template <typename T, size_t N>
+bool SmallArray<T,N>::empty() const {
+  return (first_ == last_);
+}
+
+template <typename T, size_t N>
+bool SmallArray<T,N>::inlined() const {
+  return (first_ == (uintptr_t)&storage_);
+}
+
+template <typename T, size_t N>
+T *SmallArray<T,N>::find(const T &value) {
+  for (T *I = this->begin(); I < this->end(); ++I)
+    if (*I == value)
+      return I;
+
+  return NULL;
+}
+
+template <typename T, size_t N>
+const T *SmallArray<T,N>::find(const T &value) const {
+  for (const T *I = this->begin(); I < this->end(); ++I)
+    if (*I == value)
+      return I;
+
+  return NULL;
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T,N>::position(const T &value) const {
+  if (const T *I = this->find(value))
+    return (I - this->begin());
+  return ~(size_t)0;
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::destruct(T *first, T *last) {
+  if (std::is_trivially_destructible<T>::value)
+    return;
+
+  for (T *I = first; I < last; ++I)
+    I->~T();
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::relocate(size_t capacity) {
+  const size_t size = this->size();
+
+  yeti_assert_debug(capacity >= size);
+
+  const bool was_inlined = this->inlined();
+
+  if (capacity <= N && was_inlined)
+    // Already inline.
+    return;
+
+  if (!was_inlined && std::is_trivially_copyable<T>::value && capacity > N) {
+    first_ = (uintptr_t)allocator_->reallocate((void *)first_, capacity * sizeof(T), alignof(T));
+    last_  = first_ + size * sizeof(T);
+    end_   = first_ + capacity * sizeof(T);
+    return;
+  }
+
+  T *elements;
+
+  if (capacity <= N) {
+    elements = (T *)&storage_;
+    capacity = N;
+  } else {
+    yeti_assert_debug(allocator_ != NULL);
+    elements = (T *)allocator_->allocate(capacity * sizeof(T), alignof(T));
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    new ((void *)&elements[i]) T(std::move(((T *)first_)[i]));
+    ((T *)first_)[i].~T();
+  }
+
+  if (!was_inlined)
+    allocator_->deallocate((void *)first_);
+
+  first_ = (uintptr_t)elements;
+  last_  = first_ + size * sizeof(T);
+  end_   = first_ + capacity * sizeof(T);
+}
+
+template <typename T, size_t N>
+void SmallArray<T,N>::ensure(size_t size) {
+  const size_t reserved = this->reserved();
+
+  if (size <= reserved)
+    return;
+
+  size_t capacity = reserved * 2;
+
+  if (capacity < size)
+    capacity = size;
+
+  this->relocate(capacity);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_SMALL_ARRAY_H_
@@ -0,0 +1,221 @@
+//===-- yeti/core/containers/spsc_queue.h ---------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Lock-free queues with a single producer and a single consumer.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_SPSC_QUEUE_H_
+#define _YETI_CORE_CONTAINERS_SPSC_QUEUE_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/memory.h"
+#include "yeti/core/allocator.h"
+#include "yeti/core/atomics.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+// To move elements out.
+#include <utility>
+
+namespace yeti {
+namespace core {
+
+/// \brief A fixed size, lock-free queue for exactly one producer and exactly
+/// one consumer.
+///
+/// \details Only the producing thread may call `push`, and only the consuming
+/// thread may call `pop`. Each side keeps its index on its own cache line,
+/// along with a cached copy of the other side's index, so the sides only
+/// contend when the queue looks full or empty.
+///
+template <typename T>
+class SpscQueue {
+ // Copying a queue that is being concurrently accessed is nonsensical.
+ YETI_DISALLOW_COPYING(SpscQueue)
+
+ public:
+  /// \param @size Maximum number of elements, rounded up to a power of two.
+  /// @{
+  explicit SpscQueue(Allocator *allocator, size_t size);
+  explicit SpscQueue(Allocator &allocator, size_t size);
+  /// @}
+
+  ~SpscQueue();
+
+ public:
+  /// Pushes @element to the back of the queue.
+  /// \return If there was room for @element.
+  bool push(const T &element);
+
+  /// Pops an element from the front of the queue and moves it to @element.
+  /// \return If an element was popped.
+  bool pop(T *element);
+
+  /// Returns the maximum number of elements that can be stored in the queue.
+  size_t size() const;
+
+  /// Computes the number of elements in the queue.
+  ///
+  /// \warning Stale by the time it returns if the other side is active.
+  ///
+  size_t depth() const;
+
+  /// Determines if the queue doesn't hold any elements.
+  ///
+  /// \warning Stale by the time it returns if the other side is active.
+  ///
+  bool empty() const;
+
+ private:
+  void initialize(size_t size);
+
+ private:
+  Allocator *allocator_;
+
+  T *elements_;
+
+  u32 mask_;
+
+  u8 padding_after_shared_[YETI_CACHE_LINE];
+
+  // Only written by the consumer.
+  volatile u32 read_;
+  u32 cached_write_;
+
+  u8 padding_after_consumer_[YETI_CACHE_LINE];
+
+  // Only written by the producer.
+  volatile u32 write_;
+  u32 cached_read_;
+
+  u8 padding_after_producer_[YETI_CACHE_LINE];
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(Allocator *allocator, size_t size) {
+  allocator_ = allocator;
+  this->initialize(size);
+}
+
+template <typename T>
+SpscQueue<T>::SpscQueue(Allocator &allocator, size_t size) {
+  allocator_ = &allocator;
+  this->initialize(size);
+}
+
+template <typename T>
+void SpscQueue<T>::initialize(size_t size) {
+  yeti_assert_debug(size > 0);
+  yeti_assert_debug(size <= 0x80000000u);
+
+  size_t rounded = 1;
+  while (rounded < size)
+    rounded <<= 1;
+
+  elements_ = (T *)allocator_->allocate(rounded * sizeof(T), alignof(T));
+  mask_     = (u32)(rounded - 1);
+
+  read_ = cached_write_ = 0;
+  write_ = cached_read_ = 0;
+}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue() {
+  // Destruct any elements left behind.
+  for (u32 read = read_; read != write_; ++read)
+    elements_[read & mask_].~T();
+
+  allocator_->deallocate((void *)elements_);
+}
+
+template <typename T>
+bool SpscQueue<T>::push(const T &element) {
+  const u32 write = write_;
+
+  if (write - cached_read_ > mask_) {
+    // Looks full, but the consumer may have popped since we last looked.
+    cached_read_ = atomic::load(&read_);
+
+    if (write - cached_read_ > mask_)
+      return false;
+  }
+
+  // Don't let the element be written before we know its slot is free.
+  atomic::barrier();
+
+  new ((void *)&elements_[write & mask_]) T(element);
+
+  // Publish only after the element is written.
+  atomic::barrier();
+
+  atomic::store(&write_, write + 1);
+
+  return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T *element) {
+  const u32 read = read_;
+
+  if (read == cached_write_) {
+    // Looks empty, but the producer may have pushed since we last looked.
+    cached_write_ = atomic::load(&write_);
+
+    if (read == cached_write_)
+      return false;
+  }
+
+  // Don't let the element be read before it's published.
+  atomic::barrier();
+
+  T *slot = &elements_[read & mask_];
+  *element = std::move(*slot);
+  slot->~T();
+
+  // Release the slot only after the element is read.
+  atomic::barrier();
+
+  atomic::store(&read_, read + 1);
+
+  return true;
+}
+
+template <typename T>
+size_t SpscQueue<T>::size() const {
+  return (size_t)mask_ + 1;
+}
+
+template <typename T>
+size_t SpscQueue<T>::depth() const {
+  // Read the consumer's index first, so we never see it pass the producer's.
+  const u32 read = atomic::load(&read_);
+  atomic::barrier();
+  const u32 write = atomic::load(&write_);
+  return (size_t)(write - read);
+}
+
+template <typename T>
+bool SpscQueue<T>::empty() const {
+  return (atomic::load(&read_) == atomic::load(&write_));
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_SPSC_QUEUE_H_
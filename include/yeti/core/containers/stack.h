@@ -1 +1,247 @@
-// TODO(mtwilliams): Implement a stack.
+//===-- yeti/core/containers/stack.h --------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Last-in, first-out stacks.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_CONTAINERS_STACK_H_
+#define _YETI_CORE_CONTAINERS_STACK_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+#include "yeti/core/support.h"
+
+#include "yeti/core/allocator.h"
+
+// Elements are stored in an array.
+#include "yeti/core/containers/array.h"
+
+// For sanity checks in debug builds.
+#include "yeti/core/debug/assert.h"
+
+// To move elements out.
+#include <utility>
+
+namespace yeti {
+namespace core {
+
+/// \brief A last-in, first-out stack.
+///
+/// \details Elements are stored contiguously, from bottom to top, in an
+/// `Array`. Reserve space upfront to push without reallocating.
+///
+template <typename T>
+class Stack {
+ public:
+  Stack();
+
+  /// \param @reserve Number of elements to reserve space for.
+  /// @{
+  explicit Stack(Allocator *allocator, size_t reserve = 0);
+  explicit Stack(Allocator &allocator, size_t reserve = 0);
+  /// @}
+
+  Stack(const Stack<T> &stack);
+  Stack<T> &operator=(const Stack<T> &stack);
+
+  ~Stack();
+
+ public:
+  /// Constructs an element on top of the stack.
+  T &emplace();
+
+  /// Pushes @element on top of the stack.
+  void push(const T &element);
+
+  /// Pops the element on top of the stack and moves it to @element.
+  /// \return If an element was popped.
+  bool pop(T *element);
+
+  /// Pops the element on top of the stack.
+  /// \return If an element was popped.
+  bool pop();
+
+  /// Returns the element on top of the stack.
+  /// @{
+  T &top();
+  const T &top() const;
+  /// @}
+
+ public:
+  /// Returns a pointer to the element at the bottom of the stack.
+  /// @{
+  T *begin();
+  const T *begin() const;
+  /// @}
+
+  /// Returns a pointer past the element on top of the stack.
+  /// @{
+  T *end();
+  const T *end() const;
+  /// @}
+
+ public:
+  /// Reserves space to push @additional elements without reallocating.
+  void reserve(size_t additional);
+
+  /// Releases any space reserved beyond what is needed for elements.
+  void shrink_to_fit();
+
+  /// Pops all elements, keeping space reserved for reuse.
+  void clear();
+
+  /// Returns the number of elements on the stack.
+  size_t size() const;
+
+  /// Returns the amount of space allocated for elements.
+  size_t reserved() const;
+
+  /// Determines if the stack contains no elements.
+  bool empty() const;
+
+ private:
+  Array<T> elements_;
+};
+
+template <typename T>
+Stack<T>::Stack() {
+}
+
+template <typename T>
+Stack<T>::Stack(Allocator *allocator, size_t reserve)
+  : elements_(allocator)
+{
+  elements_.reserve(reserve);
+}
+
+template <typename T>
+Stack<T>::Stack(Allocator &allocator, size_t reserve)
+  : elements_(allocator)
+{
+  elements_.reserve(reserve);
+}
+
+template <typename T>
+Stack<T>::Stack(const Stack<T> &stack)
+  : elements_(stack.elements_)
+{
+}
+
+template <typename T>
+Stack<T> &Stack<T>::operator=(const Stack<T> &stack) {
+  elements_ = stack.elements_;
+  return *this;
+}
+
+template <typename T>
+Stack<T>::~Stack() {
+}
+
+template <typename T>
+T &Stack<T>::emplace() {
+  return elements_.emplace();
+}
+
+template <typename T>
+void Stack<T>::push(const T &element) {
+  elements_.push(element);
+}
+
+template <typename T>
+bool Stack<T>::pop(T *element) {
+  if (elements_.empty())
+    return false;
+
+  elements_.pop(element);
+
+  return true;
+}
+
+template <typename T>
+bool Stack<T>::pop() {
+  if (elements_.empty())
+    return false;
+
+  elements_.pop();
+
+  return true;
+}
+
+template <typename T>
+T &Stack<T>::top() {
+  yeti_assert_debug(!this->empty());
+  return elements_.end()[-1];
+}
+
+template <typename T>
+const T &Stack<T>::top() const {
+  yeti_assert_debug(!this->empty());
+  return elements_.end()[-1];
+}
+
+template <typename T>
+T *Stack<T>::begin() {
+  return elements_.begin();
+}
+
+template <typename T>
+const T *Stack<T>::begin() const {
+  return elements_.begin();
+}
+
+template <typename T>
+T *Stack<T>::end() {
+  return elements_.end();
+}
+
+template <typename T>
+const T *Stack<T>::end() const {
+  return elements_.end();
+}
+
+template <typename T>
+void Stack<T>::reserve(size_t additional) {
+  elements_.reserve(additional);
+}
+
+template <typename T>
+void Stack<T>::shrink_to_fit() {
+  elements_.shrink_to_fit();
+}
+
+template <typename T>
+void Stack<T>::clear() {
+  elements_.clear();
+}
+
+template <typename T>
+size_t Stack<T>::size() const {
+  return elements_.size();
+}
+
+template <typename T>
+size_t Stack<T>::reserved() const {
+  return elements_.reserved();
+}
+
+template <typename T>
+bool Stack<T>::empty() const {
+  return elements_.empty();
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_CONTAINERS_STACK_H_
@@ -0,0 +1,54 @@
+//===-- yeti/core/misc/interned_strings.h ---------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Maps hashes of names back to names.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_MISC_INTERNED_STRINGS_H_
+#define _YETI_CORE_MISC_INTERNED_STRINGS_H_
+
+#include "yeti/config.h"
+#include "yeti/linkage.h"
+
+#include "yeti/core/types.h"
+
+namespace yeti {
+namespace core {
+
+/// \namespace ::yeti::core::interned_strings
+/// \brief Maps hashes of names back to names.
+///
+/// \details Names are referred to by their hashes at runtime. In debug and
+/// development builds interned names are remembered so hashes can be turned
+/// back into something readable, and so that collisions are caught early.
+/// In release builds interning is equivalent to hashing.
+///
+namespace interned_strings {
+  /// Hashes @string with `murmur_hash_32` and remembers it.
+  extern YETI_PUBLIC u32 intern(const char *string);
+
+  /// Hashes the first @length characters of @string with `murmur_hash_32`
+  /// and remembers them.
+  extern YETI_PUBLIC u32 intern(const char *string, size_t length);
+
+  /// Returns the string interned with @hash, or `NULL` if no string was.
+  ///
+  /// \warning Always returns `NULL` in release builds.
+  ///
+  extern YETI_PUBLIC const char *lookup(u32 hash);
+}
+
+} // core
+} // yeti
+
+#endif // _YETI_CORE_MISC_INTERNED_STRINGS_H_
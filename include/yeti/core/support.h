@@ -29,6 +29,7 @@
 #include "yeti/core/support/thread_local_storage.h"
 #include "yeti/core/support/stack.h"
 #include "yeti/core/support/prefetch.h"
+#include "yeti/core/support/alignment.h"
 #include "yeti/core/support/strings.h"
 
 #endif // _YETI_CORE_SUPPORT_H_
@@ -0,0 +1,45 @@
+//===-- yeti/core/support/alignment.h -------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+///
+/// \file
+/// \brief Defines pre-processor macros that control the alignment of types.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_CORE_SUPPORT_ALIGNMENT_H_
+#define _YETI_CORE_SUPPORT_ALIGNMENT_H_
+
+/// \def YETI_ALIGNED
+/// \brief Aligns instances of a type to at least @Alignment bytes.
+///
+/// \warning Microsoft Visual C/C++ refuses to pass aligned types by value on
+/// 32-bit targets. Pass by reference instead.
+///
+#if defined(DOXYGEN)
+  #define YETI_ALIGNED(Alignment)
+#else
+  #if defined(_MSC_VER)
+    #define YETI_ALIGNED(Alignment) __declspec(align(Alignment))
+  #elif defined(__clang__) || defined(__GNUC__)
+    #define YETI_ALIGNED(Alignment) __attribute__ ((aligned(Alignment)))
+  #endif
+#endif
+
+/// \def YETI_CACHE_LINE
+/// \brief Size of a cache line in bytes.
+///
+/// \details Data written by different threads should be at least this far
+/// apart to prevent false sharing.
+///
+#define YETI_CACHE_LINE 64
+
+#endif // _YETI_CORE_SUPPORT_ALIGNMENT_H_
@@ -20,7 +20,7 @@
 
 #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
     YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
-  #include <mmintrin.h>
+  #include <xmmintrin.h>
 #endif
 
 /// \def YETI_PREFETCH_L1
@@ -60,7 +60,7 @@
     #define YETI_PREFETCH_NTA _MM_HINT_NTA
 
     #define YETI_PREFETCH(Address, Hint) \
-      _mm_prefetch(((void *)Address), Hint)
+      _mm_prefetch(((const char *)(Address)), Hint)
   #else
     #define YETI_PREFETCH(Address, Hint)
   #endif
@@ -39,7 +39,7 @@ namespace utility {
 
   /// \brief Returns @v clamped to @min and @max, inclusive.
   template <typename T>
-  static YETI_INLINE T clamp(const T &v, const T &min, const T &max) { return min(max(min, v), max); }
+  static YETI_INLINE T clamp(const T &v, const T &min, const T &max) { return utility::min(utility::max(min, v), max); }
 
   /// \brief Quickly determines if @v is a power of two.
   /// @{
@@ -192,6 +192,9 @@ class YETI_PUBLIC EntityManager {
 
   /// Tries to find a named entity.
   ///
+  /// \note Hashes of names known ahead of time can be computed at compile
+  /// time with `YETI_HASH`.
+  ///
   /// \return If the entity was found.
   ///
   bool named(const u32 hash_of_name, Entity *entity) const;
@@ -244,7 +247,7 @@ class YETI_PUBLIC EntityManager {
   core::Array<u32> names_;
 
   /// Map of names to entities used to accelerate lookups of entities by name.
-  core::Map<u32, Entity, core::map::IdentityHashFunction<u32>::hash> name_to_entity_;
+  core::FlatMap<u32, Entity, core::map::IdentityHashFunction<u32>::hash> name_to_entity_;
 
   /// Logical hierarchy of entities.
   /// @{
@@ -276,7 +279,7 @@ class YETI_PUBLIC EntityManager {
   };
 
   /// Lifecycle callbacks.
-  core::Array<RegisteredLifecycleCallback> callbacks_;
+  core::SmallArray<RegisteredLifecycleCallback, 16> callbacks_;
 };
 
 /// Records entity lifecycle events.
@@ -0,0 +1,154 @@
+//===-- yeti/light_clusters.h ---------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+// Bins lights into clusters, or froxels, that partition a camera's viewing
+// volume so shading only considers lights that can affect each cluster.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_LIGHT_CLUSTERS_H_
+#define _YETI_LIGHT_CLUSTERS_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math.h"
+
+#include "yeti/entity.h"
+
+#include "yeti/components/transform.h"
+#include "yeti/components/camera.h"
+#include "yeti/components/light.h"
+
+namespace yeti {
+
+/// \brief Per-cluster light lists for a particular camera.
+///
+/// \details Clusters are laid out in a grid of tiles across the viewport, and
+/// slices along depth. Slices are distributed exponentially for perspective
+/// cameras, and linearly for orthographic cameras. Cluster `(x, y, z)` is at
+/// `x + width * (y + height * z)` with `(0, 0, 0)` being the bottom-left tile
+/// of the nearest slice.
+///
+/// Assignment produces a flat buffer of offsets and indices suitable for
+/// upload. Lights assigned to cluster `c` are `indices[offsets[c]]` through
+/// `indices[offsets[c + 1]]`, exclusive, where each index refers to a light
+/// in `lights()`.
+///
+class YETI_PUBLIC LightClusters {
+ YETI_DISALLOW_COPYING(LightClusters)
+
+ public:
+  struct Description {
+    /// Number of tiles across the viewport.
+    u32 width;
+
+    /// Number of tiles up the viewport.
+    u32 height;
+
+    /// Number of slices along depth.
+    u32 depth;
+
+    /// Maximum number of lights assigned to a single cluster. Any more are
+    /// dropped.
+    u32 maximum_lights_per_cluster;
+  };
+
+ private:
+  LightClusters(const Description &desc);
+  ~LightClusters();
+
+ public:
+  static LightClusters *create(const Description &desc);
+  void destroy();
+
+ public:
+  /// \brief Assigns enabled point and spot lights to the clusters of @camera
+  /// positioned and oriented by @pose.
+  ///
+  /// \param @aspect Aspect ratio of the viewport.
+  ///
+  /// \note Slices are binned in parallel on the task scheduler. Returns once
+  /// all slices are binned.
+  ///
+  void assign(LightSystem *lights,
+              TransformSystem *transforms,
+              const Camera &camera,
+              const Mat4 &pose,
+              const f32 aspect);
+
+ public:
+  /// \brief Returns the total number of clusters.
+  u32 num_of_clusters() const;
+
+  /// \brief Entities with lights referenced by indices, in order.
+  const core::Array<Entity> &lights() const;
+
+  /// \brief Offset of each cluster's lights into `indices()`, followed by the
+  /// total number of indices.
+  const core::Array<u32> &offsets() const;
+
+  /// \brief Indices into `lights()` of lights assigned to each cluster.
+  const core::Array<u32> &indices() const;
+
+ private:
+  /// \internal Bins candidate lights into the clusters of a slice.
+  void bin(u32 slice);
+
+  /// \internal Task kernel that shims to `bin`.
+  static void bin_a_slice(void *job);
+
+ private:
+  const Description desc_;
+
+  // Copy of the camera used during assignment.
+  Camera camera_;
+  f32 aspect_;
+
+  core::Array<Entity> lights_;
+
+  // View-space bounding spheres of lights.
+  core::Array<f32> x_, y_, z_, radii_;
+
+  // View-space axes and angles of spot lights. Point lights have no axis and
+  // an angle of 180° so that they pass the cone test.
+  core::Array<f32> axis_x_, axis_y_, axis_z_;
+  core::Array<f32> cos_of_angles_, sin_of_angles_;
+
+  // Lights intersecting each slice.
+  core::Array<u32> candidates_;
+
+  // Lights assigned to each cluster prior to compaction.
+  core::Array<u32> counts_;
+  core::Array<u32> assigned_;
+
+  core::Array<u32> offsets_;
+  core::Array<u32> indices_;
+};
+
+YETI_INLINE u32 LightClusters::num_of_clusters() const {
+  return desc_.width * desc_.height * desc_.depth;
+}
+
+YETI_INLINE const core::Array<Entity> &LightClusters::lights() const {
+  return lights_;
+}
+
+YETI_INLINE const core::Array<u32> &LightClusters::offsets() const {
+  return offsets_;
+}
+
+YETI_INLINE const core::Array<u32> &LightClusters::indices() const {
+  return indices_;
+}
+
+} // yeti
+
+#endif // _YETI_LIGHT_CLUSTERS_H_
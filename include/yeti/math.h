@@ -30,4 +30,10 @@
 
 #include "yeti/math/mat4.h"
 
+#include "yeti/math/ray.h"
+#include "yeti/math/plane.h"
+#include "yeti/math/sphere.h"
+#include "yeti/math/aabb.h"
+#include "yeti/math/frustum.h"
+
 #endif // _YETI_MATH_H_
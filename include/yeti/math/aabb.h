@@ -0,0 +1,128 @@
+//===-- yeti/math/aabb.h --------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Axis-aligned bounding boxes.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_AABB_H_
+#define _YETI_MATH_AABB_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+#include "yeti/math/mat4.h"
+
+namespace yeti {
+
+/// \brief Represents an axis-aligned bounding box by its extremes.
+///
+class YETI_PUBLIC AABB {
+ public:
+  AABB() : min(0.f, 0.f, 0.f), max(0.f, 0.f, 0.f) {}
+  AABB(const Vec3 &min, const Vec3 &max) : min(min), max(max) {}
+  AABB(const AABB &b) : min(b.min), max(b.max) {}
+  AABB operator=(const AABB &b) { min = b.min; max = b.max; return *this; }
+
+ public:
+  /// \brief Builds a box centered at @center extending @extents along each
+  /// axis in both directions.
+  static AABB from_center_and_extents(const Vec3 &center, const Vec3 &extents);
+
+ public:
+  /// \brief Returns the center of this box.
+  Vec3 center() const;
+
+  /// \brief Returns half the size of this box along each axis.
+  Vec3 extents() const;
+
+  /// \brief Returns the surface area of this box.
+  f32 surface_area() const;
+
+  /// \brief Determines if @point is inside this box.
+  bool contains(const Vec3 &point) const;
+
+  /// \brief Determines if @box is entirely inside this box.
+  bool contains(const AABB &box) const;
+
+  /// \brief Determines if @box intersects this box.
+  bool intersects(const AABB &box) const;
+
+ public:
+  /// \brief Returns the smallest box enclosing both @b1 and @b2.
+  static AABB merge(const AABB &b1, const AABB &b2);
+
+  /// \brief Returns the smallest box enclosing @box after being transformed
+  /// by @m.
+  static AABB transform(const AABB &box, const Mat4 &m);
+
+ public:
+  Vec3 min;
+  Vec3 max;
+};
+
+YETI_INLINE AABB AABB::from_center_and_extents(const Vec3 &center, const Vec3 &extents) {
+  return AABB(center - extents, center + extents);
+}
+
+YETI_INLINE Vec3 AABB::center() const {
+  return (min + max) * 0.5f;
+}
+
+YETI_INLINE Vec3 AABB::extents() const {
+  return (max - min) * 0.5f;
+}
+
+YETI_INLINE f32 AABB::surface_area() const {
+  const Vec3 d = max - min;
+  return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+YETI_INLINE bool AABB::contains(const Vec3 &point) const {
+  return (point.x >= min.x) && (point.x <= max.x)
+      && (point.y >= min.y) && (point.y <= max.y)
+      && (point.z >= min.z) && (point.z <= max.z);
+}
+
+YETI_INLINE bool AABB::contains(const AABB &box) const {
+  return (box.min.x >= min.x) && (box.max.x <= max.x)
+      && (box.min.y >= min.y) && (box.max.y <= max.y)
+      && (box.min.z >= min.z) && (box.max.z <= max.z);
+}
+
+YETI_INLINE bool AABB::intersects(const AABB &box) const {
+  return (box.min.x <= max.x) && (box.max.x >= min.x)
+      && (box.min.y <= max.y) && (box.max.y >= min.y)
+      && (box.min.z <= max.z) && (box.max.z >= min.z);
+}
+
+YETI_INLINE AABB AABB::merge(const AABB &b1, const AABB &b2) {
+  return AABB(Vec3::min(b1.min, b2.min), Vec3::max(b1.max, b2.max));
+}
+
+YETI_INLINE AABB AABB::transform(const AABB &box, const Mat4 &m) {
+  // Transform center, then project extents onto each axis.
+  // See Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems.
+  const Vec3 center = m * box.center();
+  const Vec3 extents = box.extents();
+
+  const Vec3 transformed =
+    Vec3(fabsf(m(0,0)) * extents.x + fabsf(m(0,1)) * extents.y + fabsf(m(0,2)) * extents.z,
+         fabsf(m(1,0)) * extents.x + fabsf(m(1,1)) * extents.y + fabsf(m(1,2)) * extents.z,
+         fabsf(m(2,0)) * extents.x + fabsf(m(2,1)) * extents.y + fabsf(m(2,2)) * extents.z);
+
+  return AABB(center - transformed, center + transformed);
+}
+
+} // yeti
+
+#endif // _YETI_MATH_AABB_H_
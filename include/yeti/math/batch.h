@@ -0,0 +1,95 @@
+//===-- yeti/math/batch.h -------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Math over arrays of vectors, quaternions, and matrices.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_BATCH_H_
+#define _YETI_MATH_BATCH_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+#include "yeti/math/quaternion.h"
+#include "yeti/math/mat4.h"
+
+namespace yeti {
+
+/// \brief Kernels that operate on many values at once.
+///
+/// \details Values are transposed into structures of arrays internally, so
+/// that a handful of values are operated on at once. Results are identical
+/// to the equivalent operations on individual values.
+///
+/// Inputs and outputs may alias so long as they're identical.
+///
+namespace batch {
+
+/// \brief Transforms @n @points by @matrix.
+///
+/// \note Like `Mat4 * Vec3`, this performs a perspective divide.
+///
+extern YETI_PUBLIC void transform_points(const Mat4 &matrix,
+                                         const Vec3 *points,
+                                         Vec3 *transformed,
+                                         size_t n);
+
+/// \brief Rotates @n @vectors by corresponding @rotations.
+extern YETI_PUBLIC void rotate_vectors(const Quaternion *rotations,
+                                       const Vec3 *vectors,
+                                       Vec3 *rotated,
+                                       size_t n);
+
+/// \brief Normalizes @n @quaternions.
+extern YETI_PUBLIC void normalize_quaternions(const Quaternion *quaternions,
+                                              Quaternion *normalized,
+                                              size_t n);
+
+/// \brief Normalized-linearly interpolates between @n pairs of quaternions,
+/// @a and @b, by @t.
+///
+/// \see yeti::Quaternion::nlerp
+///
+extern YETI_PUBLIC void nlerp(const Quaternion *a,
+                              const Quaternion *b,
+                              const f32 t,
+                              Quaternion *interpolated,
+                              size_t n);
+
+/// \brief Spherically interpolates between @n pairs of quaternions, @a and
+/// @b, by @t.
+///
+/// \see yeti::Quaternion::slerp
+///
+extern YETI_PUBLIC void slerp(const Quaternion *a,
+                              const Quaternion *b,
+                              const f32 t,
+                              Quaternion *interpolated,
+                              size_t n);
+
+/// \brief Builds @n matrices from corresponding @positions, @rotations, and
+/// @scales.
+///
+/// \see yeti::Mat4::compose
+///
+extern YETI_PUBLIC void compose(const Vec3 *positions,
+                                const Quaternion *rotations,
+                                const Vec3 *scales,
+                                Mat4 *matrices,
+                                size_t n);
+
+} // batch
+
+} // yeti
+
+#endif // _YETI_MATH_BATCH_H_
@@ -29,12 +29,12 @@ namespace yeti {
 
 /// \brief Converts degrees to radians.
 YETI_INLINE f32 degrees_to_radians(const f32 degrees) {
-  return degrees * (180.f / PI);
+  return degrees * (PI / 180.f);
 }
 
 /// \brief Converts radians to degrees.
 YETI_INLINE f32 radians_to_degrees(const f32 radians) {
-  return radians * (PI / 180.f);
+  return radians * (180.f / PI);
 }
 
 } // yeti
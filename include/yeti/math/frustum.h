@@ -0,0 +1,178 @@
+//===-- yeti/math/frustum.h -----------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief View frustums and batched culling against them.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_FRUSTUM_H_
+#define _YETI_MATH_FRUSTUM_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+#include "yeti/math/mat4.h"
+#include "yeti/math/plane.h"
+#include "yeti/math/sphere.h"
+#include "yeti/math/aabb.h"
+
+namespace yeti {
+
+/// \brief Represents a convex viewing volume as six inward facing planes.
+///
+/// \details Frustums are built in view space, looking down negative z, then
+/// transformed into world space by the viewer's pose.
+///
+class YETI_PUBLIC Frustum {
+ public:
+  enum Side {
+    LEFT_PLANE   = 0,
+    RIGHT_PLANE  = 1,
+    TOP_PLANE    = 2,
+    BOTTOM_PLANE = 3,
+    NEAR_PLANE   = 4,
+    FAR_PLANE    = 5
+  };
+
+ public:
+  Frustum();
+  Frustum(const Frustum &f);
+  Frustum operator=(const Frustum &f);
+
+ public:
+  /// \brief Builds a perspective viewing volume.
+  ///
+  /// \param @field_of_view Horizontal field-of-view in degrees.
+  /// \param @aspect Aspect ratio of projected image.
+  /// \param @near Near plane.
+  /// \param @far Far plane.
+  ///
+  static Frustum perspective(const f32 field_of_view,
+                             const f32 aspect,
+                             const f32 near,
+                             const f32 far);
+
+  /// \brief Builds an orthographic viewing volume.
+  static Frustum orthographic(const f32 top,
+                              const f32 left,
+                              const f32 bottom,
+                              const f32 right,
+                              const f32 near,
+                              const f32 far);
+
+ public:
+  /// \brief Returns this frustum transformed by @pose.
+  ///
+  /// \warning Assumes @pose has no shear or non-uniform scale.
+  ///
+  Frustum transform(const Mat4 &pose) const;
+
+  /// \brief Determines if @sphere is at least partially inside.
+  bool test(const Sphere &sphere) const;
+
+  /// \brief Determines if @box is at least partially inside.
+  ///
+  /// \note Conservative. May report boxes near corners as inside.
+  ///
+  bool test(const AABB &box) const;
+
+ public:
+  Plane planes[6];
+};
+
+namespace frustum {
+  /// \brief Bounding spheres laid out as a structure of arrays.
+  struct Spheres {
+    const f32 *x;
+    const f32 *y;
+    const f32 *z;
+    const f32 *radius;
+  };
+
+  /// \brief Axis-aligned bounding boxes laid out as a structure of arrays.
+  struct Boxes {
+    const f32 *min_x;
+    const f32 *min_y;
+    const f32 *min_z;
+    const f32 *max_x;
+    const f32 *max_y;
+    const f32 *max_z;
+  };
+
+  /// \brief Culls @n bounding @spheres against @frustum.
+  ///
+  /// \param @visible Filled with the indices of visible spheres, in order.
+  /// Must be able to hold @n indices.
+  ///
+  /// \return Number of visible spheres.
+  ///
+  extern YETI_PUBLIC u32 cull(const Frustum &frustum,
+                              const Spheres &spheres,
+                              const u32 n,
+                              u32 *visible);
+
+  /// \brief Culls @n bounding @boxes against @frustum.
+  ///
+  /// \param @visible Filled with the indices of visible boxes, in order.
+  /// Must be able to hold @n indices.
+  ///
+  /// \return Number of visible boxes.
+  ///
+  extern YETI_PUBLIC u32 cull(const Frustum &frustum,
+                              const Boxes &boxes,
+                              const u32 n,
+                              u32 *visible);
+}
+
+YETI_INLINE Frustum::Frustum() {
+}
+
+YETI_INLINE Frustum::Frustum(const Frustum &f) {
+  for (unsigned plane = 0; plane < 6; ++plane)
+    planes[plane] = f.planes[plane];
+}
+
+YETI_INLINE Frustum Frustum::operator=(const Frustum &f) {
+  for (unsigned plane = 0; plane < 6; ++plane)
+    planes[plane] = f.planes[plane];
+  return *this;
+}
+
+YETI_INLINE bool Frustum::test(const Sphere &sphere) const {
+  for (unsigned plane = 0; plane < 6; ++plane)
+    if (planes[plane].distance_to(sphere.center) < -sphere.radius)
+      return false;
+  return true;
+}
+
+YETI_INLINE bool Frustum::test(const AABB &box) const {
+  const Vec3 center = box.center();
+  const Vec3 extents = box.extents();
+
+  for (unsigned plane = 0; plane < 6; ++plane) {
+    const Vec3 &n = planes[plane].normal;
+
+    // Projection of extents onto normal.
+    const f32 radius = fabsf(n.x) * extents.x
+                     + fabsf(n.y) * extents.y
+                     + fabsf(n.z) * extents.z;
+
+    if (planes[plane].distance_to(center) < -radius)
+      return false;
+  }
+
+  return true;
+}
+
+} // yeti
+
+#endif // _YETI_MATH_FRUSTUM_H_
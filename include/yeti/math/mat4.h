@@ -19,6 +19,8 @@
 
 #include "yeti/core.h"
 
+#include "yeti/math/simd.h"
+
 #include "yeti/math/vec3.h"
 #include "yeti/math/vec4.h"
 
@@ -35,7 +37,10 @@ namespace yeti {
 /// multiplying matrices and vectors, meaning transformations are applied
 /// right-to-left.
 ///
-class YETI_PUBLIC Mat4 {
+/// \remark Aligned so that each row can be loaded into a SIMD register in one
+/// go.
+///
+class YETI_PUBLIC YETI_ALIGNED(16) Mat4 {
  public:
   /// \brief Default constructor.
   /// \warning Does *not* initialize for efficiency,
@@ -121,13 +126,47 @@ class YETI_PUBLIC Mat4 {
                         Quaternion *rotation,
                         Vec3 *scale);
 
+  /// Decomposes an affine matrix into its translation, rotation, and scale
+  /// components.
+  ///
+  /// \details Cheaper and more accurate than `decompose` as scale is removed
+  /// prior to extracting rotation, which means the determinant is known to
+  /// be one.
+  ///
+  /// \warning Breaks if shear or reflection are introduced.
+  ///
+  static void decompose_affine(const Mat4 &matrix,
+                               Vec3 *translation,
+                               Quaternion *rotation,
+                               Vec3 *scale);
+
  public:
   /// \brief Calculates the determinant of this matrix.
   f32 determinant() const;
 
+  /// \brief Determines if this matrix is affine, i.e. the bottom row is
+  /// exactly `[0 0 0 1]`.
+  bool is_affine() const;
+
   /// \brief Derives the inverse of this matrix.
   Mat4 inverse() const;
 
+  /// \brief Derives the inverse of this matrix, assuming it's affine.
+  ///
+  /// \details Only the upper 3x3 is inverted; translation is then rotated and
+  /// scaled by the result and negated.
+  ///
+  Mat4 inverse_affine() const;
+
+  /// \brief Derives the inverse of this matrix, assuming it's rigid, i.e. only
+  /// rotates and translates.
+  ///
+  /// \details The upper 3x3 is orthonormal so its inverse is its transpose.
+  ///
+  /// \warning Results are meaningless if the matrix scales.
+  ///
+  Mat4 inverse_rigid() const;
+
   /// \brief Derives the transposition of this matrix.
   Mat4 transpose() const;
 
@@ -155,15 +194,36 @@ YETI_INLINE Mat4::Mat4(const f32 m00, const f32 m01, const f32 m02, const f32 m0
 }
 
 YETI_INLINE Mat4::Mat4(const f32 m[4][4]) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  _mm_storeu_ps(M[0], _mm_loadu_ps(m[0]));
+  _mm_storeu_ps(M[1], _mm_loadu_ps(m[1]));
+  _mm_storeu_ps(M[2], _mm_loadu_ps(m[2]));
+  _mm_storeu_ps(M[3], _mm_loadu_ps(m[3]));
+#else
   core::memory::copy((const void *)&m[0][0], (void *)&M[0][0], sizeof(M));
+#endif
 }
 
 YETI_INLINE Mat4::Mat4(const Mat4 &m) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  _mm_storeu_ps(M[0], _mm_loadu_ps(m.M[0]));
+  _mm_storeu_ps(M[1], _mm_loadu_ps(m.M[1]));
+  _mm_storeu_ps(M[2], _mm_loadu_ps(m.M[2]));
+  _mm_storeu_ps(M[3], _mm_loadu_ps(m.M[3]));
+#else
   core::memory::copy((const void *)&m.M[0][0], (void *)&M[0][0], sizeof(M));
+#endif
 }
 
 YETI_INLINE Mat4 Mat4::operator=(const Mat4 &m) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  _mm_storeu_ps(M[0], _mm_loadu_ps(m.M[0]));
+  _mm_storeu_ps(M[1], _mm_loadu_ps(m.M[1]));
+  _mm_storeu_ps(M[2], _mm_loadu_ps(m.M[2]));
+  _mm_storeu_ps(M[3], _mm_loadu_ps(m.M[3]));
+#else
   core::memory::copy((const void *)&m.M[0][0], (void *)&M[0][0], sizeof(M));
+#endif
   return *this;
 }
 
@@ -177,9 +237,29 @@ YETI_INLINE f32 Mat4::operator()(const unsigned i, const unsigned j) const {
   return M[i][j];
 }
 
+YETI_INLINE bool Mat4::is_affine() const {
+  return (M[3][0] == 0.f) && (M[3][1] == 0.f) && (M[3][2] == 0.f) && (M[3][3] == 1.f);
+}
+
 YETI_INLINE Mat4 operator*(const Mat4 &lhs, const Mat4 &rhs) {
   Mat4 concatenated;
 
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  // Each row of the result is a combination of the rows of the right-hand
+  // side, weighted by the corresponding row of the left-hand side.
+  const __m128 r0 = _mm_loadu_ps(rhs.M[0]);
+  const __m128 r1 = _mm_loadu_ps(rhs.M[1]);
+  const __m128 r2 = _mm_loadu_ps(rhs.M[2]);
+  const __m128 r3 = _mm_loadu_ps(rhs.M[3]);
+
+  for (unsigned i = 0; i < 4; ++i) {
+    __m128 row = _mm_mul_ps(_mm_set1_ps(lhs.M[i][0]), r0);
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.M[i][1]), r1));
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.M[i][2]), r2));
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.M[i][3]), r3));
+    _mm_storeu_ps(concatenated.M[i], row);
+  }
+#else
   concatenated.M[0][0] = lhs.M[0][0] * rhs.M[0][0] + lhs.M[0][1] * rhs.M[1][0] + lhs.M[0][2] * rhs.M[2][0] + lhs.M[0][3] * rhs.M[3][0];
   concatenated.M[0][1] = lhs.M[0][0] * rhs.M[0][1] + lhs.M[0][1] * rhs.M[1][1] + lhs.M[0][2] * rhs.M[2][1] + lhs.M[0][3] * rhs.M[3][1];
   concatenated.M[0][2] = lhs.M[0][0] * rhs.M[0][2] + lhs.M[0][1] * rhs.M[1][2] + lhs.M[0][2] * rhs.M[2][2] + lhs.M[0][3] * rhs.M[3][2];
@@ -199,11 +279,34 @@ YETI_INLINE Mat4 operator*(const Mat4 &lhs, const Mat4 &rhs) {
   concatenated.M[3][1] = lhs.M[3][0] * rhs.M[0][1] + lhs.M[3][1] * rhs.M[1][1] + lhs.M[3][2] * rhs.M[2][1] + lhs.M[3][3] * rhs.M[3][1];
   concatenated.M[3][2] = lhs.M[3][0] * rhs.M[0][2] + lhs.M[3][1] * rhs.M[1][2] + lhs.M[3][2] * rhs.M[2][2] + lhs.M[3][3] * rhs.M[3][2];
   concatenated.M[3][3] = lhs.M[3][0] * rhs.M[0][3] + lhs.M[3][1] * rhs.M[1][3] + lhs.M[3][2] * rhs.M[2][3] + lhs.M[3][3] * rhs.M[3][3];
+#endif
 
   return concatenated;
 }
 
 YETI_INLINE Vec3 operator*(const Mat4 &m, const Vec3 &v) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  // Transposed so that we can accumulate columns, which keeps the order of
+  // operations the same as below.
+  __m128 c0 = _mm_loadu_ps(m.M[0]);
+  __m128 c1 = _mm_loadu_ps(m.M[1]);
+  __m128 c2 = _mm_loadu_ps(m.M[2]);
+  __m128 c3 = _mm_loadu_ps(m.M[3]);
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+  __m128 t = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+  t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+  t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+  t = _mm_add_ps(t, c3);
+
+  const __m128 w = _mm_div_ps(_mm_set1_ps(1.f), _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 3, 3)));
+
+  f32 transformed[4];
+  _mm_storeu_ps(transformed, _mm_mul_ps(t, w));
+
+  return Vec3(transformed[0], transformed[1], transformed[2]);
+#else
   Vec3 transformed;
 
   const f32 w = 1.0f / (m.M[3][0] * v.x + m.M[3][1] * v.y + m.M[3][2] * v.z + m.M[3][3]);
@@ -213,15 +316,34 @@ YETI_INLINE Vec3 operator*(const Mat4 &m, const Vec3 &v) {
   transformed.z = (m.M[2][0] * v.x + m.M[2][1] * v.y + m.M[2][2] * v.z + m.M[2][3]) * w;
 
   return transformed;
+#endif
 }
 
 YETI_INLINE Vec4 operator*(const Mat4 &m, const Vec4 &v) {
   Vec4 transformed;
 
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  // Transposed so that we can accumulate columns, which keeps the order of
+  // operations the same as below.
+  __m128 c0 = _mm_loadu_ps(m.M[0]);
+  __m128 c1 = _mm_loadu_ps(m.M[1]);
+  __m128 c2 = _mm_loadu_ps(m.M[2]);
+  __m128 c3 = _mm_loadu_ps(m.M[3]);
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+  __m128 t = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+  t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+  t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+  t = _mm_add_ps(t, _mm_mul_ps(c3, _mm_set1_ps(v.w)));
+
+  _mm_storeu_ps(&transformed.x, t);
+#else
   transformed.x = m.M[0][0] * v.x + m.M[0][1] * v.y + m.M[0][2] * v.z + m.M[0][3] * v.w;
   transformed.y = m.M[1][0] * v.x + m.M[1][1] * v.y + m.M[1][2] * v.z + m.M[1][3] * v.w;
   transformed.z = m.M[2][0] * v.x + m.M[2][1] * v.y + m.M[2][2] * v.z + m.M[2][3] * v.w;
   transformed.w = m.M[3][0] * v.x + m.M[3][1] * v.y + m.M[3][2] * v.z + m.M[3][3] * v.w;
+#endif
 
   return transformed;
 }
@@ -235,6 +357,12 @@ extern YETI_PUBLIC Quaternion rotation_from_matrix(const Mat4 &matrix);
 /// \brief Extracts scale from @matrix.
 extern YETI_PUBLIC Vec3 scale_from_matrix(const Mat4 &matrix);
 
+/// \brief Extracts rotation from an affine @matrix.
+///
+/// \details Unlike `rotation_from_matrix`, this handles non-uniform scale.
+///
+extern YETI_PUBLIC Quaternion rotation_from_affine_matrix(const Mat4 &matrix);
+
 } // yeti
 
 #endif // _YETI_MATH_MAT4_H_
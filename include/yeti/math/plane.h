@@ -0,0 +1,72 @@
+//===-- yeti/math/plane.h -------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Planes.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_PLANE_H_
+#define _YETI_MATH_PLANE_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+
+namespace yeti {
+
+/// \brief Represents an infinite plane as a normal and distance from origin.
+///
+/// \details Points satisfying `normal.dot(point) + distance = 0` lie on the
+/// plane. Points in the direction of the normal are considered in front.
+///
+class YETI_PUBLIC Plane {
+ public:
+  Plane() : normal(0.f, 0.f, 1.f), distance(0.f) {}
+  Plane(const Vec3 &normal, f32 distance) : normal(normal), distance(distance) {}
+  Plane(const Plane &p) : normal(p.normal), distance(p.distance) {}
+  Plane operator=(const Plane &p) { normal = p.normal; distance = p.distance; return *this; }
+
+ public:
+  /// \brief Builds a plane passing through @point facing @normal.
+  static Plane from_point_and_normal(const Vec3 &point, const Vec3 &normal);
+
+ public:
+  /// \brief Returns a version of this plane with a unit length normal.
+  Plane normalize() const;
+
+  /// \brief Returns the signed distance of @point from this plane.
+  ///
+  /// \note Only correct if the plane is normalized.
+  ///
+  f32 distance_to(const Vec3 &point) const;
+
+ public:
+  Vec3 normal;
+  f32 distance;
+};
+
+YETI_INLINE Plane Plane::from_point_and_normal(const Vec3 &point, const Vec3 &normal) {
+  return Plane(normal, -normal.dot(point));
+}
+
+YETI_INLINE Plane Plane::normalize() const {
+  const f32 inverse_of_magnitude = 1.f / normal.magnitude();
+  return Plane(normal * inverse_of_magnitude, distance * inverse_of_magnitude);
+}
+
+YETI_INLINE f32 Plane::distance_to(const Vec3 &point) const {
+  return normal.dot(point) + distance;
+}
+
+} // yeti
+
+#endif // _YETI_MATH_PLANE_H_
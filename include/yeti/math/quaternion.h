@@ -19,15 +19,23 @@
 
 #include "yeti/core.h"
 
+#include "yeti/math/simd.h"
+
 #include "yeti/math/vec3.h"
 
 #include <math.h>
 
 namespace yeti {
 
+/// \brief Cosine of angle between quaternions beyond which `slerp` falls back
+/// to `nlerp`.
+static const f32 QUATERNION_SLERP_THRESHOLD = 0.9995f;
+
 /// \brief Represents a direction.
 ///
-class YETI_PUBLIC Quaternion {
+/// \remark Aligned so that it can be loaded into a SIMD register in one go.
+///
+class YETI_PUBLIC YETI_ALIGNED(16) Quaternion {
  public:
   Quaternion() : x(0.f), y(0.f), z(0.f), w(1.f) {}
   Quaternion(f32 x, f32 y, f32 z, f32 w) : x(x), y(y), z(z), w(w) {}
@@ -112,10 +120,36 @@ YETI_INLINE f32 Quaternion::dot(const Quaternion &q) const {
 }
 
 YETI_INLINE Quaternion operator*(const Quaternion &lhs, const Quaternion &rhs) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  // Each component is the sum of four products, accumulated in the same
+  // order as below. Subtraction is performed by flipping the sign of the
+  // product, which is exact.
+  const __m128 l = _mm_loadu_ps(&lhs.x);
+  const __m128 r = _mm_loadu_ps(&rhs.x);
+
+  const __m128 p1 = _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r);
+
+  const __m128 p2 = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)),
+                                          _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3))),
+                               _mm_set_ps(-0.f, 0.f, -0.f, 0.f));
+
+  const __m128 p3 = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)),
+                                          _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2))),
+                               _mm_set_ps(-0.f, -0.f, 0.f, 0.f));
+
+  const __m128 p4 = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)),
+                                          _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1))),
+                               _mm_set_ps(-0.f, 0.f, 0.f, -0.f));
+
+  Quaternion q;
+  _mm_storeu_ps(&q.x, _mm_add_ps(_mm_add_ps(_mm_add_ps(p1, p2), p3), p4));
+  return q;
+#else
   return Quaternion(lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
                     lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
                     lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
                     lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z);
+#endif
 }
 
 YETI_INLINE Vec3 operator*(const Quaternion &q, const Vec3 &v) {
@@ -132,7 +166,13 @@ YETI_INLINE Vec3 operator*(const Quaternion &q, const Vec3 &v) {
 }
 
 YETI_INLINE Quaternion operator*(const Quaternion &q, const f32 s) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Quaternion scaled;
+  _mm_storeu_ps(&scaled.x, _mm_mul_ps(_mm_loadu_ps(&q.x), _mm_set1_ps(s)));
+  return scaled;
+#else
   return Quaternion(q.x * s, q.y * s, q.z * s, q.w * s);
+#endif
 }
 
 YETI_INLINE Quaternion Quaternion::from_axis_angle(const Vec3 &axis, const f32 angle) {
@@ -173,7 +213,13 @@ YETI_INLINE Quaternion Quaternion::nlerp(const Quaternion &a, const Quaternion &
 YETI_INLINE Quaternion Quaternion::slerp(const Quaternion &a, const Quaternion &b, const f32 t) {
   const f32 one_minus_t = 1.f - t;
 
-  const f32 theta = acosf(a.dot(b));
+  const f32 cos_of_theta = a.dot(b);
+
+  if (cos_of_theta > QUATERNION_SLERP_THRESHOLD)
+    // Nearly parallel, so we'd end up dividing by (nearly) zero.
+    return Quaternion::nlerp(a, b, t);
+
+  const f32 theta = acosf(cos_of_theta);
   const f32 sin_of_theta = sinf(theta);
   const f32 inverse_of_sin_of_theta = 1.f / sin_of_theta;
 
@@ -0,0 +1,52 @@
+//===-- yeti/math/ray.h ---------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Rays.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_RAY_H_
+#define _YETI_MATH_RAY_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+
+namespace yeti {
+
+/// \brief Represents a half-line by its origin and direction.
+///
+class YETI_PUBLIC Ray {
+ public:
+  Ray() : origin(0.f, 0.f, 0.f), direction(0.f, 0.f, -1.f) {}
+  Ray(const Vec3 &origin, const Vec3 &direction) : origin(origin), direction(direction) {}
+  Ray(const Ray &r) : origin(r.origin), direction(r.direction) {}
+  Ray operator=(const Ray &r) { origin = r.origin; direction = r.direction; return *this; }
+
+ public:
+  /// \brief Returns the point @t units along this ray.
+  Vec3 at(const f32 t) const;
+
+ public:
+  Vec3 origin;
+
+  /// \warning Expected to be normalized.
+  Vec3 direction;
+};
+
+YETI_INLINE Vec3 Ray::at(const f32 t) const {
+  return origin + direction * t;
+}
+
+} // yeti
+
+#endif // _YETI_MATH_RAY_H_
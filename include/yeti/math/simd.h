@@ -0,0 +1,63 @@
+//===-- yeti/math/simd.h --------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Selects the backend used to implement vector, quaternion, and matrix math.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_SIMD_H_
+#define _YETI_MATH_SIMD_H_
+
+#include "yeti/core.h"
+
+/// \def YETI_MATH_BACKEND_SCALAR
+/// \brief Plain old C++. Serves as the reference implementation.
+#define YETI_MATH_BACKEND_SCALAR 1
+
+/// \def YETI_MATH_BACKEND_SSE
+/// \brief Streaming SIMD Extensions.
+#define YETI_MATH_BACKEND_SSE 2
+
+/// \def YETI_MATH_BACKEND
+/// \brief Backend used to implement math.
+///
+/// \details Chosen at compile time based on the target architecture unless
+/// explicitly specified. Define as `YETI_MATH_BACKEND_SCALAR` to force the
+/// reference implementation.
+///
+/// Every backend produces bit-identical results to the reference. Vectorized
+/// routines perform the same operations in the same order, just a few at a
+/// time.
+///
+#if defined(DOXYGEN)
+  #define YETI_MATH_BACKEND
+#else
+  #if !defined(YETI_MATH_BACKEND)
+    #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+        YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+      #define YETI_MATH_BACKEND YETI_MATH_BACKEND_SSE
+    #else
+      #define YETI_MATH_BACKEND YETI_MATH_BACKEND_SCALAR
+    #endif
+  #endif
+#endif
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  #include <xmmintrin.h>
+#endif
+
+// NOTE(mtwilliams): Vectorized routines always use unaligned loads and stores
+// because we don't control all memory that math types live in, like LuaJIT's
+// FFI. They're just as fast as aligned loads and stores when data is aligned
+// on any remotely recent microarchitecture.
+
+#endif // _YETI_MATH_SIMD_H_
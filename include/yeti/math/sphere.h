@@ -0,0 +1,82 @@
+//===-- yeti/math/sphere.h ------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Spheres.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_MATH_SPHERE_H_
+#define _YETI_MATH_SPHERE_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math/vec3.h"
+
+namespace yeti {
+
+/// \brief Represents a sphere as a center and radius.
+///
+class YETI_PUBLIC Sphere {
+ public:
+  Sphere() : center(0.f, 0.f, 0.f), radius(0.f) {}
+  Sphere(const Vec3 &center, f32 radius) : center(center), radius(radius) {}
+  Sphere(const Sphere &s) : center(s.center), radius(s.radius) {}
+  Sphere operator=(const Sphere &s) { center = s.center; radius = s.radius; return *this; }
+
+ public:
+  /// \brief Determines if @point is inside this sphere.
+  bool contains(const Vec3 &point) const;
+
+  /// \brief Determines if @sphere intersects this sphere.
+  bool intersects(const Sphere &sphere) const;
+
+ public:
+  /// \brief Returns the smallest sphere enclosing both @s1 and @s2.
+  static Sphere merge(const Sphere &s1, const Sphere &s2);
+
+ public:
+  Vec3 center;
+  f32 radius;
+};
+
+YETI_INLINE bool Sphere::contains(const Vec3 &point) const {
+  const Vec3 delta = point - center;
+  return delta.dot(delta) <= radius * radius;
+}
+
+YETI_INLINE bool Sphere::intersects(const Sphere &sphere) const {
+  const Vec3 delta = sphere.center - center;
+  const f32 radii = sphere.radius + radius;
+  return delta.dot(delta) <= radii * radii;
+}
+
+YETI_INLINE Sphere Sphere::merge(const Sphere &s1, const Sphere &s2) {
+  const Vec3 delta = s2.center - s1.center;
+  const f32 distance = delta.magnitude();
+
+  if (distance + s2.radius <= s1.radius)
+    // First encloses second.
+    return s1;
+
+  if (distance + s1.radius <= s2.radius)
+    // Second encloses first.
+    return s2;
+
+  const f32 radius = (distance + s1.radius + s2.radius) * 0.5f;
+  const Vec3 center = s1.center + delta * ((radius - s1.radius) / distance);
+
+  return Sphere(center, radius);
+}
+
+} // yeti
+
+#endif // _YETI_MATH_SPHERE_H_
@@ -19,13 +19,17 @@
 
 #include "yeti/core.h"
 
+#include "yeti/math/simd.h"
+
 #include <math.h>
 
 namespace yeti {
 
 /// \brief Represents a point or direction in four-dimensional space.
 ///
-class YETI_PUBLIC Vec4 {
+/// \remark Aligned so that it can be loaded into a SIMD register in one go.
+///
+class YETI_PUBLIC YETI_ALIGNED(16) Vec4 {
  public:
   Vec4() : x(0.f), y(0.f), z(0.f), w(0.f) {}
   Vec4(f32 x, f32 y, f32 z, f32 w) : x(x), y(y), z(z), w(w) {}
@@ -99,27 +103,63 @@ YETI_INLINE f32 Vec4::dot(const Vec4 &v) const {
 }
 
 YETI_INLINE Vec4 operator+(const Vec4 &lhs, const Vec4 &rhs) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 v;
+  _mm_storeu_ps(&v.x, _mm_add_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x)));
+  return v;
+#else
   return Vec4(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
+#endif
 }
 
 YETI_INLINE Vec4 operator-(const Vec4 &lhs, const Vec4 &rhs) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 v;
+  _mm_storeu_ps(&v.x, _mm_sub_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x)));
+  return v;
+#else
   return Vec4(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
+#endif
 }
 
 YETI_INLINE Vec4 operator*(const Vec4 &lhs, const Vec4 &rhs) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 v;
+  _mm_storeu_ps(&v.x, _mm_mul_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x)));
+  return v;
+#else
   return Vec4(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
+#endif
 }
 
 YETI_INLINE Vec4 operator*(const Vec4 &v, const f32 s) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 scaled;
+  _mm_storeu_ps(&scaled.x, _mm_mul_ps(_mm_loadu_ps(&v.x), _mm_set1_ps(s)));
+  return scaled;
+#else
   return Vec4(v.x * s, v.y * s, v.z * s, v.w * s);
+#endif
 }
 
 YETI_INLINE Vec4 operator/(const Vec4 &lhs, const Vec4 &rhs) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 v;
+  _mm_storeu_ps(&v.x, _mm_div_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x)));
+  return v;
+#else
   return Vec4(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w);
+#endif
 }
 
 YETI_INLINE Vec4 operator/(const Vec4 &v, const f32 s) {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  Vec4 scaled;
+  _mm_storeu_ps(&scaled.x, _mm_div_ps(_mm_loadu_ps(&v.x), _mm_set1_ps(s)));
+  return scaled;
+#else
   return Vec4(v.x / s, v.y / s, v.z / s, v.w / s);
+#endif
 }
 
 YETI_INLINE f32 Vec4::distance(const Vec4 &v1, const Vec4 &v2) {
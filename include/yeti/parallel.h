@@ -0,0 +1,52 @@
+//===-- yeti/parallel.h ---------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// \brief Algorithms spread across workers by the task scheduler.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_PARALLEL_H_
+#define _YETI_PARALLEL_H_
+
+#include "yeti/core.h"
+
+namespace yeti {
+
+namespace parallel {
+
+/// \brief Sorts @n @keys in ascending order, reordering @values alongside.
+///
+/// \details Equivalent to `core::radix_sort`, but each pass is split into
+/// chunks that are counted then scattered by workers. Falls back to
+/// `core::radix_sort` when there are too few keys to be worth splitting.
+///
+/// \note Assumes execution on main thread.
+///
+/// @{
+extern YETI_PUBLIC void radix_sort(u32 *keys,
+                                   u32 *values,
+                                   u32 *keys_scratch,
+                                   u32 *values_scratch,
+                                   size_t n);
+
+extern YETI_PUBLIC void radix_sort(u64 *keys,
+                                   u32 *values,
+                                   u64 *keys_scratch,
+                                   u32 *values_scratch,
+                                   size_t n);
+/// @}
+
+} // parallel
+
+} // yeti
+
+#endif // _YETI_PARALLEL_H_
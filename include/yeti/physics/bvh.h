@@ -0,0 +1,169 @@
+//===-- yeti/physics/bvh.h ------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Bounding volume hierarchy used to answer spatial queries.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_PHYSICS_BVH_H_
+#define _YETI_PHYSICS_BVH_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math.h"
+
+#include "yeti/entity.h"
+
+#include "yeti/physics/raycast.h"
+
+namespace yeti {
+
+/// \brief Spatial index over the bounds of entities.
+///
+/// \details Entities are inserted with bounds relative to their transform and
+/// moved by providing their world pose. Structural changes, i.e. insertions
+/// and removals, are batched and cause a rebuild on the next `update`, which
+/// uses a binned surface area heuristic. Movement only causes a (much cheaper)
+/// refit, unless the quality of the hierarchy has degraded enough that a
+/// rebuild is worthwhile.
+///
+/// Queries are answered in batches. Queries are traversed in packets of four
+/// so that each node is tested against a packet at once.
+///
+/// \note Worlds move entities as their transforms change. Use `World::track`
+/// rather than inserting directly, so entities start at their current pose.
+///
+/// \warning Queries are answered against the hierarchy as of the last
+/// `update`.
+///
+class YETI_PUBLIC BoundingVolumeHierarchy {
+ YETI_DISALLOW_COPYING(BoundingVolumeHierarchy)
+
+ public:
+  /// \internal Nodes are laid out so that a node fits in half a cache line,
+  /// and children are always adjacent and after their parent.
+  struct Node {
+    f32 min[3];
+
+    // Index of left child if interior, otherwise index of first primitive.
+    u32 left_or_first;
+
+    f32 max[3];
+
+    // Number of primitives, or zero if interior.
+    u32 count;
+  };
+
+ private:
+  BoundingVolumeHierarchy(EntityManager *entities);
+  ~BoundingVolumeHierarchy();
+
+ public:
+  static BoundingVolumeHierarchy *create(EntityManager *entities);
+  void destroy();
+
+ public:
+  /// \brief Inserts @entity with @bounds relative to @pose.
+  void insert(Entity entity,
+              const AABB &bounds,
+              const Mat4 &pose = Mat4::IDENTITY);
+
+  /// \brief Removes @entity.
+  ///
+  /// \note Entities are automatically removed when destroyed.
+  ///
+  void remove(Entity entity);
+
+  /// \brief Determines if @entity is in the hierarchy.
+  bool has(Entity entity) const;
+
+  /// \brief Moves @entity to @pose.
+  void move(Entity entity, const Mat4 &pose);
+
+  /// \brief Rebuilds or refits to account for changes since the last update.
+  void update();
+
+ public:
+  /// \brief Casts @n rays given by @raycasts and stores the closest
+  /// intersection of each in @hits.
+  void raycast_n(const Raycast *raycasts,
+                 RaycastHit *hits,
+                 size_t n) const;
+
+  /// \brief Finds entities with bounds overlapping each of @n @spheres.
+  void overlap_sphere_n(const Sphere *spheres,
+                        size_t n,
+                        Overlaps *overlaps) const;
+
+  /// \brief Finds entities with bounds overlapping each of @n @boxes.
+  void overlap_aabb_n(const AABB *boxes,
+                      size_t n,
+                      Overlaps *overlaps) const;
+
+ private:
+  /// \internal Builds from scratch.
+  void build();
+
+  /// \internal Splits @node if worthwhile.
+  ///
+  /// \return If @node was split.
+  ///
+  bool split(u32 node);
+
+  /// \internal Recomputes bounds of nodes bottom up.
+  void refit();
+
+  /// \internal Estimates the cost of traversal by the surface area heuristic.
+  f32 cost() const;
+
+ private:
+  /// \internal Removes destroyed entities.
+  static void lifecycle_callback_shim(Entity::LifecycleEvent event,
+                                      Entity entity,
+                                      void *bvh);
+
+ private:
+  EntityManager *entities_;
+
+  u32 callback_;
+
+  const unsigned limit_;
+
+  core::Array<u32> entity_to_primitive_;
+  core::Array<Entity> primitive_to_entity_;
+
+  core::Array<AABB> local_bounds_;
+  core::Array<AABB> world_bounds_;
+
+  // Primitives referenced by leaves.
+  core::Array<u32> order_;
+
+  core::Array<Node> nodes_;
+  u32 num_of_nodes_;
+
+  // Insertions or removals require a rebuild while movement only requires a
+  // refit.
+  bool restructured_;
+  bool moved_;
+
+  // Cost immediately after the last rebuild, to determine when refitting has
+  // degraded quality enough to warrant a rebuild.
+  f32 cost_after_build_;
+};
+
+YETI_INLINE bool BoundingVolumeHierarchy::has(Entity entity) const {
+  return (entity_to_primitive_[entity.index()] != 0xFFFFFFFFul);
+}
+
+} // yeti
+
+#endif // _YETI_PHYSICS_BVH_H_
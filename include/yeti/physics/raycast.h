@@ -0,0 +1,67 @@
+//===-- yeti/physics/raycast.h --------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Types shared by spatial queries.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_PHYSICS_RAYCAST_H_
+#define _YETI_PHYSICS_RAYCAST_H_
+
+#include "yeti/core.h"
+
+#include "yeti/math.h"
+
+#include "yeti/entity.h"
+
+namespace yeti {
+
+/// \brief A ray cast against the world.
+///
+struct Raycast {
+  /// Ray to cast. Direction is expected to be normalized.
+  Ray ray;
+
+  /// Maximum distance along the ray to consider.
+  f32 distance;
+};
+
+/// \brief Closest intersection of a raycast.
+///
+struct RaycastHit {
+  /// Entity that was hit or an invalid handle, i.e. `Entity()`, if nothing
+  /// was hit.
+  Entity entity;
+
+  /// Distance along the ray to the intersection. Zero if the ray starts
+  /// inside the entity's bounds.
+  f32 distance;
+};
+
+/// \brief Entities overlapping each of a batch of queries.
+///
+/// \details Entities overlapping query `i` are `entities[offsets[i]]` through
+/// `entities[offsets[i + 1]]`, exclusive, in no particular order.
+///
+struct Overlaps {
+  Overlaps()
+    : offsets(core::global_heap_allocator())
+    , entities(core::global_heap_allocator()) {
+  }
+
+  core::Array<u32> offsets;
+  core::Array<Entity> entities;
+};
+
+} // yeti
+
+#endif // _YETI_PHYSICS_RAYCAST_H_
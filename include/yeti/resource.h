@@ -134,6 +134,10 @@ namespace resource {
     u32 version;
 
     /// Allocates space for a resource of this type.
+    ///
+    /// \note Resources are prepared and unloaded often, so prefer allocating
+    /// them from `resource::pool<T>()` over the heap.
+    ///
     Resource *(*prepare)(resource::Id id);
 
     /// Loads a resource of this type from compiled data.
@@ -316,6 +320,27 @@ namespace resource {
   /// Calls @callback for every registered type.
   extern YETI_PUBLIC void for_each_type(void (*callback)(Type::Id id, const Type *type, void *context),
                                         void *context = NULL);
+
+  /// Returns a pool to allocate resources of type @T from.
+  ///
+  /// \details Resources are freed by whichever thread unloads them, so the
+  /// pool is thread-safe. Slabs are taken from the page allocator.
+  ///
+  /// \note Pools are never destroyed, as resources can still be loaded at
+  /// exit. Their slabs are reclaimed along with the process.
+  ///
+  template <typename T>
+  core::thread_safe::PoolAllocator &pool() {
+    // HACK(mtwilliams): Use a function-local static, so that the pool is
+    // constructed on first use, and not before the page allocator. It's
+    // deliberately leaked so that it isn't checked for leaks during static
+    // destruction.
+    static core::thread_safe::PoolAllocator *pool =
+      YETI_NEW(core::thread_safe::PoolAllocator, core::global_heap_allocator())
+        (core::global_page_allocator(), sizeof(T), alignof(T));
+
+    return *pool;
+  }
 }
 
 /// An instance of a resource.
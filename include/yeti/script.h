@@ -110,7 +110,7 @@ class YETI_PUBLIC Script {
   template <typename T> T to_a(int index);
 
   /// \brief Pushes @value to top of stack.
-  template <typename T> void push(T value);
+  template <typename T> void push(const T &value);
 
  public:
   /// \brief Calls the global function @fn with @n number of arguments.
@@ -36,6 +36,10 @@
 #include "yeti/components/data.h"
 #include "yeti/components/tag.h"
 
+// Spatial queries are answered by the world.
+#include "yeti/physics/raycast.h"
+#include "yeti/physics/bvh.h"
+
 namespace yeti {
 
 class YETI_PUBLIC World {
@@ -50,6 +54,10 @@ class YETI_PUBLIC World {
 
   void update(const f32 delta_time);
 
+  /// \brief Blends state prior to and after the last update by @alpha for
+  /// presentation.
+  void interpolate(const f32 alpha);
+
   void destroy();
 
  public:
@@ -83,6 +91,52 @@ class YETI_PUBLIC World {
     return lights_;
   }
 
+  YETI_INLINE BoundingVolumeHierarchy *spatial() {
+    return spatial_;
+  }
+
+ public:
+  /// \brief Makes @entity visible to spatial queries, with @bounds relative
+  /// to its transform.
+  ///
+  /// \details Entities follow their transforms from then on, including
+  /// transforms created later. Tracking an entity again replaces its bounds.
+  /// Entities stop being tracked when destroyed.
+  ///
+  /// \note Nothing is tracked by default, as no component describes bounds
+  /// yet. Spawn code, or scripts, must track what they want to query.
+  ///
+  void track(Entity entity, const AABB &bounds);
+
+  /// \brief Hides @entity from spatial queries.
+  void untrack(Entity entity);
+
+ public:
+  /// \brief Casts @n rays given by @raycasts against the bounds of entities
+  /// and stores the closest intersection of each in @hits.
+  ///
+  /// \see yeti::BoundingVolumeHierarchy::raycast_n
+  ///
+  void raycast_n(const Raycast *raycasts,
+                 RaycastHit *hits,
+                 size_t n) const;
+
+  /// \brief Finds entities with bounds overlapping each of @n @spheres.
+  ///
+  /// \see yeti::BoundingVolumeHierarchy::overlap_sphere_n
+  ///
+  void overlap_sphere_n(const Sphere *spheres,
+                        size_t n,
+                        Overlaps *overlaps) const;
+
+  /// \brief Finds entities with bounds overlapping each of @n @boxes.
+  ///
+  /// \see yeti::BoundingVolumeHierarchy::overlap_aabb_n
+  ///
+  void overlap_aabb_n(const AABB *boxes,
+                      size_t n,
+                      Overlaps *overlaps) const;
+
  private:
   EntityManager entities_;
 
@@ -91,6 +145,11 @@ class YETI_PUBLIC World {
   TransformSystem *transforms_;
   CameraSystem *cameras_;
   LightSystem *lights_;
+
+  BoundingVolumeHierarchy *spatial_;
+
+  // Entities with transforms that changed during the last update.
+  core::Array<Entity> moved_;
 };
 
 } // yeti
@@ -169,6 +169,9 @@ void Application::run() {
   this->startup();
 
   for (;;) {
+    // Reclaim scratch memory from the frame before last.
+    core::global_frame_allocator().flip();
+
     for (Window **window = windows_.begin(); window < windows_.end(); ++window)
       (*window)->update(&window_event_handler_, (void *)this);
 
@@ -181,12 +184,18 @@ void Application::run() {
     // the time-step policy is changed during a step.
     const u32 steps = time_step_policy_->steps();
     const f32 delta_time_per_step = time_step_policy_->delta_time_per_step();
+    const f32 alpha = time_step_policy_->alpha();
 
-    yeti_assert_debug(steps >= 1);
-
+    // Fixed time-steps may not step at all if we're presenting faster than we
+    // are simulating.
     for (u32 step = 0; step < steps; ++step)
       this->update(delta_time_per_step);
 
+    // Blend between the last two steps so presentation is smooth regardless
+    // of the rate at which we simulate.
+    for (World **world = worlds_.begin(); world < worlds_.end(); ++world)
+      (*world)->interpolate(alpha);
+
     logical_frame_count_ += 1;
 
     // TODO(mtwilliams): Limit latency.
@@ -20,6 +20,7 @@ TimeStepPolicy::TimeStepPolicy() {
   desc_.type = TimeStepPolicy::UNKNOWN;
   steps_ = 0;
   delta_time_per_step_ = 0.f;
+  alpha_ = 1.f;
 }
 
 TimeStepPolicy::~TimeStepPolicy() {
@@ -52,13 +53,19 @@ void TimeStepPolicy::update(const core::Timer &frame,
     case TimeStepPolicy::VARIABLE: {
       steps_ = 1;
       delta_time_per_step_ = (f32)frame.usecs() / 1000000.f;
+      alpha_ = 1.f;
     } break;
 
     case TimeStepPolicy::FIXED: {
       state_.fixed.accumulated += (f32)frame.usecs() / 1000000.f;
-      steps_ = lroundf(state_.fixed.accumulated / desc_.config.fixed.delta_time_per_step);
+      // Round down, rather than to nearest, so the remainder is always positive
+      // and can be used to interpolate. This means we may not step at all when
+      // presenting faster than we simulate.
+      steps_ = (u32)floorf(state_.fixed.accumulated / desc_.config.fixed.delta_time_per_step);
       state_.fixed.accumulated -= steps_ * desc_.config.fixed.delta_time_per_step;
       delta_time_per_step_ = desc_.config.fixed.delta_time_per_step;
+      alpha_ = state_.fixed.accumulated / desc_.config.fixed.delta_time_per_step;
+      alpha_ = YETI_CLAMP(alpha_, 0.f, 1.f);
     } break;
 
     case TimeStepPolicy::SMOOTHED: {
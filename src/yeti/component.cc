@@ -51,7 +51,7 @@ Component::Id component_registry::register_a_component(const Component *componen
       yeti_assert_with_reason(0, "Already registered a component with the name '%s'!", component->name);
 #endif
 
-  const Component::Id id = id_from_name(component->name);
+  const Component::Id id = (Component::Id)core::interned_strings::intern(component->name);
 
   ids_.push(id);
   components_.push(component);
@@ -321,6 +321,28 @@ namespace camera {
     return "unknown";
   }
 
+  Frustum frustum(const Camera &camera,
+                  const Mat4 &pose,
+                  const f32 aspect) {
+    switch (camera.type) {
+      case Camera::PERSPECTIVE:
+        return Frustum::perspective(camera.perspective.field_of_view,
+                                    aspect,
+                                    camera.near,
+                                    camera.far).transform(pose);
+
+      case Camera::ORTHOGRAPHIC:
+        return Frustum::orthographic(camera.orthographic.top,
+                                     camera.orthographic.left,
+                                     camera.orthographic.bottom,
+                                     camera.orthographic.right,
+                                     camera.near,
+                                     camera.far).transform(pose);
+    }
+
+    YETI_UNREACHABLE();
+  }
+
   static bool compile(const component_compiler::Environment *env,
                       const component_compiler::Input *input,
                       const component_compiler::Output *output)
@@ -345,16 +367,157 @@ namespace camera {
 CameraSystem::CameraSystem(EntityManager *entities)
   : System(CameraSystem::component())
   , entities_(entities)
-  , entity_to_instance_(core::global_heap_allocator(), 256)
+  , limit_(entities->limit())
+  , entity_to_instance_(core::global_page_allocator(), limit_)
   , instance_to_entity_(core::global_heap_allocator())
-  , cameras_(core::global_heap_allocator())
-  , siblings_(core::global_heap_allocator())
+  , types_(core::global_heap_allocator())
+  , fields_of_view_(core::global_heap_allocator())
+  , boxes_(core::global_heap_allocator())
+  , near_planes_(core::global_heap_allocator())
+  , far_planes_(core::global_heap_allocator())
 {
+  for (unsigned index = 0; index < limit_; ++index)
+    // We use -1 to indicate that there is no instance associated with an entity.
+    entity_to_instance_[index].index = u32(-1);
 }
 
 CameraSystem::~CameraSystem() {
 }
 
+Camera::Handle CameraSystem::create(Entity entity) {
+  // Enforce one-to-one mapping.
+  yeti_assert_with_reason_debug(!this->has(entity), "Camera component already associated with entity.");
+
+  const u32 instance = (u32)instance_to_entity_.push(entity);
+
+  entity_to_instance_[entity.index()].index = instance;
+
+  static const Box empty = { 0.f, 0.f, 0.f, 0.f };
+
+  types_.push(Camera::PERSPECTIVE);
+  fields_of_view_.push(90.f);
+  boxes_.push(empty);
+  near_planes_.push(0.1f);
+  far_planes_.push(1000.f);
+
+  return { entity.index() };
+}
+
+void CameraSystem::destroy(Camera::Handle handle) {
+  const u32 instance = resolve(handle).index;
+
+  yeti_assert_with_reason_debug(instance != u32(-1), "Camera component already destroyed.");
+
+  // Swap and pop. Handles refer to entities rather than instances, so there's
+  // no need to defer.
+  const u32 last = (u32)instance_to_entity_.size() - 1;
+
+  const Entity replacement = instance_to_entity_[last];
+  entity_to_instance_[replacement.index()].index = instance;
+  instance_to_entity_[instance] = replacement;
+
+  types_[instance] = types_[last];
+  fields_of_view_[instance] = fields_of_view_[last];
+  boxes_[instance] = boxes_[last];
+  near_planes_[instance] = near_planes_[last];
+  far_planes_[instance] = far_planes_[last];
+
+  instance_to_entity_.pop();
+  types_.pop();
+  fields_of_view_.pop();
+  boxes_.pop();
+  near_planes_.pop();
+  far_planes_.pop();
+
+  // Unmap.
+  entity_to_instance_[handle.opaque].index = u32(-1);
+}
+
+void CameraSystem::destroy(Entity entity) {
+  if (this->has(entity))
+    // Has a camera component, so destroy it.
+    this->destroy(lookup(entity));
+}
+
+Camera::Type CameraSystem::get_type(Camera::Handle handle) const {
+  return types_[resolve(handle).index];
+}
+
+f32 CameraSystem::get_field_of_view(Camera::Handle handle) const {
+  return fields_of_view_[resolve(handle).index];
+}
+
+void CameraSystem::get_box(Camera::Handle handle, f32 *top, f32 *left, f32 *bottom, f32 *right) const {
+  const Box &box = boxes_[resolve(handle).index];
+
+  *top = box.top;
+  *left = box.left;
+  *bottom = box.bottom;
+  *right = box.right;
+}
+
+f32 CameraSystem::get_near_plane(Camera::Handle handle) const {
+  return near_planes_[resolve(handle).index];
+}
+
+f32 CameraSystem::get_far_plane(Camera::Handle handle) const {
+  return far_planes_[resolve(handle).index];
+}
+
+void CameraSystem::set_type(Camera::Handle handle, Camera::Type type) {
+  yeti_assert_debug(type == Camera::PERSPECTIVE || type == Camera::ORTHOGRAPHIC);
+  types_[resolve(handle).index] = type;
+}
+
+void CameraSystem::set_field_of_view(Camera::Handle handle, f32 field_of_view) {
+  yeti_assert_with_reason_debug(field_of_view > 0.f, "Field-of-view must be greater than 0°!");
+  yeti_assert_with_reason_debug(field_of_view <= 180.f, "Field-of-view must be no greater than 180°!");
+  fields_of_view_[resolve(handle).index] = field_of_view;
+}
+
+void CameraSystem::set_box(Camera::Handle handle, f32 top, f32 left, f32 bottom, f32 right) {
+  const Box box = { top, left, bottom, right };
+  boxes_[resolve(handle).index] = box;
+}
+
+void CameraSystem::set_near_plane(Camera::Handle handle, f32 near_plane) {
+  near_planes_[resolve(handle).index] = near_plane;
+}
+
+void CameraSystem::set_far_plane(Camera::Handle handle, f32 far_plane) {
+  far_planes_[resolve(handle).index] = far_plane;
+}
+
+Camera CameraSystem::describe(Camera::Handle handle) const {
+  const u32 instance = resolve(handle).index;
+
+  Camera camera;
+
+  camera.type = types_[instance];
+
+  switch (camera.type) {
+    case Camera::PERSPECTIVE: {
+      camera.perspective.field_of_view = fields_of_view_[instance];
+    } break;
+
+    case Camera::ORTHOGRAPHIC: {
+      camera.orthographic.top = boxes_[instance].top;
+      camera.orthographic.left = boxes_[instance].left;
+      camera.orthographic.bottom = boxes_[instance].bottom;
+      camera.orthographic.right = boxes_[instance].right;
+    } break;
+  }
+
+  camera.near = near_planes_[instance];
+  camera.far = far_planes_[instance];
+
+  return camera;
+}
+
+void CameraSystem::destroyed(Entity entity) {
+  this->destroy(entity);
+}
+
 // Automatically register with component registry.
 YETI_AUTO_REGISTER_COMPONENT(CameraSystem::component());
 
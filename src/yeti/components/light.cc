@@ -35,16 +35,175 @@ namespace light {
 LightSystem::LightSystem(EntityManager *entities)
   : System(LightSystem::component())
   , entities_(entities)
-  , entity_to_instance_(core::global_heap_allocator(), 256)
+  , limit_(entities->limit())
+  , entity_to_instance_(core::global_page_allocator(), limit_)
   , instance_to_entity_(core::global_heap_allocator())
-  , lights_(core::global_heap_allocator())
-  , siblings_(core::global_heap_allocator())
+  , types_(core::global_heap_allocator())
+  , radii_(core::global_heap_allocator())
+  , angles_(core::global_heap_allocator())
+  , colors_(core::global_heap_allocator())
+  , intensities_(core::global_heap_allocator())
+  , flags_(core::global_heap_allocator())
 {
+  for (unsigned index = 0; index < limit_; ++index)
+    // We use -1 to indicate that there is no instance associated with an entity.
+    entity_to_instance_[index].index = u32(-1);
 }
 
 LightSystem::~LightSystem() {
 }
 
+Light::Handle LightSystem::create(Entity entity) {
+  // Enforce one-to-one mapping.
+  yeti_assert_with_reason_debug(!this->has(entity), "Light component already associated with entity.");
+
+  const u32 instance = (u32)instance_to_entity_.push(entity);
+
+  entity_to_instance_[entity.index()].index = instance;
+
+  types_.push(Light::POINT);
+  radii_.push(1.f);
+  angles_.push(0.f);
+  colors_.push(Color::WHITE);
+  intensities_.push(0.f);
+  flags_.push(Light::ENABLED);
+
+  return { entity.index() };
+}
+
+void LightSystem::destroy(Light::Handle handle) {
+  const u32 instance = resolve(handle).index;
+
+  yeti_assert_with_reason_debug(instance != u32(-1), "Light component already destroyed.");
+
+  // Swap and pop. Handles refer to entities rather than instances, so there's
+  // no need to defer.
+  const u32 last = (u32)instance_to_entity_.size() - 1;
+
+  const Entity replacement = instance_to_entity_[last];
+  entity_to_instance_[replacement.index()].index = instance;
+  instance_to_entity_[instance] = replacement;
+
+  types_[instance] = types_[last];
+  radii_[instance] = radii_[last];
+  angles_[instance] = angles_[last];
+  colors_[instance] = colors_[last];
+  intensities_[instance] = intensities_[last];
+  flags_[instance] = flags_[last];
+
+  instance_to_entity_.pop();
+  types_.pop();
+  radii_.pop();
+  angles_.pop();
+  colors_.pop();
+  intensities_.pop();
+  flags_.pop();
+
+  // Unmap.
+  entity_to_instance_[handle.opaque].index = u32(-1);
+}
+
+void LightSystem::destroy(Entity entity) {
+  if (this->has(entity))
+    // Has a light component, so destroy it.
+    this->destroy(lookup(entity));
+}
+
+Light::Type LightSystem::get_type(Light::Handle handle) const {
+  return types_[resolve(handle).index];
+}
+
+f32 LightSystem::get_radius(Light::Handle handle) const {
+  return radii_[resolve(handle).index];
+}
+
+f32 LightSystem::get_angle(Light::Handle handle) const {
+  return angles_[resolve(handle).index];
+}
+
+Color LightSystem::get_color(Light::Handle handle) const {
+  return colors_[resolve(handle).index];
+}
+
+f32 LightSystem::get_intensity(Light::Handle handle) const {
+  return intensities_[resolve(handle).index];
+}
+
+u32 LightSystem::flags(Light::Handle handle) const {
+  return flags_[resolve(handle).index];
+}
+
+void LightSystem::set_type(Light::Handle handle, Light::Type type) {
+  yeti_assert_debug(type >= Light::DIRECTIONAL && type <= Light::SPOT);
+  types_[resolve(handle).index] = type;
+}
+
+void LightSystem::set_radius(Light::Handle handle, f32 radius) {
+  yeti_assert_debug(radius >= 0.f);
+  radii_[resolve(handle).index] = radius;
+}
+
+void LightSystem::set_angle(Light::Handle handle, f32 angle) {
+  yeti_assert_debug(angle >= 0.f);
+  angles_[resolve(handle).index] = angle;
+}
+
+void LightSystem::set_color(Light::Handle handle, const Color &color) {
+  colors_[resolve(handle).index] = color;
+}
+
+void LightSystem::set_intensity(Light::Handle handle, f32 intensity) {
+  yeti_assert_debug(intensity >= 0.f);
+  intensities_[resolve(handle).index] = intensity;
+}
+
+void LightSystem::set_flags(Light::Handle handle, u32 flags, u32 mask) {
+  u32 &existing = flags_[resolve(handle).index];
+  existing = (existing & ~mask) | (flags & mask);
+}
+
+Light LightSystem::describe(Light::Handle handle) const {
+  const u32 instance = resolve(handle).index;
+
+  Light light;
+
+  light.type = types_[instance];
+
+  switch (light.type) {
+    case Light::DIRECTIONAL: {
+      light.directional.color = colors_[instance];
+      light.directional.intensity = intensities_[instance];
+    } break;
+
+    case Light::POINT: {
+      light.point.radius = radii_[instance];
+      light.point.color = colors_[instance];
+      light.point.intensity = intensities_[instance];
+    } break;
+
+    case Light::SPOT: {
+      light.spot.radius = radii_[instance];
+      light.spot.angle = angles_[instance];
+      light.spot.color = colors_[instance];
+      light.spot.intensity = intensities_[instance];
+    } break;
+  }
+
+  light.flags = flags_[instance];
+
+  return light;
+}
+
+void LightSystem::filter(u32 flags, core::Array<Entity> &entities) const {
+  for (u32 instance = 0; instance < flags_.size(); ++instance)
+    if ((flags_[instance] & flags) == flags)
+      entities.push(instance_to_entity_[instance]);
+}
+
+void LightSystem::destroyed(Entity entity) {
+  this->destroy(entity);
+}
+
 // Automatically register with component registry.
 YETI_AUTO_REGISTER_COMPONENT(LightSystem::component());
 
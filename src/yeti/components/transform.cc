@@ -9,11 +9,14 @@
 //
 //===----------------------------------------------------------------------===//
 
-// TODO(mtwilliams): Use our own sort.
-#include <algorithm>
-
 #include "yeti/components/transform.h"
 
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Interpolation is batched four instances at a time.
+  #include <xmmintrin.h>
+#endif
+
 // TODO(mtwilliams): Quantize scale.
 
 // PERF(mtwilliams): Sort or bucket transforms by depth. This will increase
@@ -22,6 +25,15 @@
 
 namespace yeti {
 
+// Dead instances are left in place until this many have accumulated, at which
+// point we compact. Amortizes the cost of fixing up links across despawns.
+static const u32 TRANSFORM_GC_THRESHOLD = 256;
+
+// Instances pending collection are mapped to an invalid entity.
+static YETI_INLINE bool is_dead(const Entity entity) {
+  return (entity.id == 0xFFFFFFFFul);
+}
+
 // TODO(mtwilliams): Error messages during compilation.
 // TODO(mtwilliams): Contextualize by indicating location in source.
 
@@ -202,6 +214,228 @@ namespace transform {
   {
     return false;
   }
+
+  // NOTE(mtwilliams): Like `Mat4::decompose_affine`, interpolation breaks if
+  // shear or reflection are introduced.
+
+  static void interpolate_1(const Mat4 &previous,
+                            const Mat4 &current,
+                            const f32 alpha,
+                            Mat4 *interpolated)
+  {
+    Vec3 translations[2];
+    Quaternion rotations[2];
+    Vec3 scales[2];
+
+    Mat4::decompose_affine(previous, &translations[0], &rotations[0], &scales[0]);
+    Mat4::decompose_affine(current, &translations[1], &rotations[1], &scales[1]);
+
+    // Take the shortest path.
+    if (rotations[0].dot(rotations[1]) < 0.f)
+      rotations[1] = Quaternion(-rotations[1].x, -rotations[1].y, -rotations[1].z, -rotations[1].w);
+
+    const f32 beta = 1.f - alpha;
+
+    const Vec3 translation = translations[0] * beta + translations[1] * alpha;
+    const Quaternion rotation = Quaternion::nlerp(rotations[0], rotations[1], alpha);
+    const Vec3 scale = scales[0] * beta + scales[1] * alpha;
+
+    *interpolated = Mat4::compose(translation, rotation, scale);
+  }
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Upper 3x4 of four poses, transposed so each register holds the same
+  // element of each pose. The bottom row is implicitly (0, 0, 0, 1).
+  struct Poses {
+    __m128 m[3][4];
+  };
+
+  static YETI_INLINE void load_4(const Mat4 *poses, Poses *lanes) {
+    // Poses are stored row-major without any padding.
+    const f32 *p0 = (const f32 *)&poses[0];
+    const f32 *p1 = (const f32 *)&poses[1];
+    const f32 *p2 = (const f32 *)&poses[2];
+    const f32 *p3 = (const f32 *)&poses[3];
+
+    for (unsigned row = 0; row < 3; ++row) {
+      __m128 r0 = _mm_loadu_ps(&p0[row * 4]);
+      __m128 r1 = _mm_loadu_ps(&p1[row * 4]);
+      __m128 r2 = _mm_loadu_ps(&p2[row * 4]);
+      __m128 r3 = _mm_loadu_ps(&p3[row * 4]);
+
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+      lanes->m[row][0] = r0;
+      lanes->m[row][1] = r1;
+      lanes->m[row][2] = r2;
+      lanes->m[row][3] = r3;
+    }
+  }
+
+  static YETI_INLINE void store_4(const Poses &lanes, Mat4 *poses) {
+    f32 *p0 = (f32 *)&poses[0];
+    f32 *p1 = (f32 *)&poses[1];
+    f32 *p2 = (f32 *)&poses[2];
+    f32 *p3 = (f32 *)&poses[3];
+
+    for (unsigned row = 0; row < 3; ++row) {
+      __m128 r0 = lanes.m[row][0];
+      __m128 r1 = lanes.m[row][1];
+      __m128 r2 = lanes.m[row][2];
+      __m128 r3 = lanes.m[row][3];
+
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+      _mm_storeu_ps(&p0[row * 4], r0);
+      _mm_storeu_ps(&p1[row * 4], r1);
+      _mm_storeu_ps(&p2[row * 4], r2);
+      _mm_storeu_ps(&p3[row * 4], r3);
+    }
+
+    static const f32 bottom[4] = { 0.f, 0.f, 0.f, 1.f };
+
+    _mm_storeu_ps(&p0[12], _mm_loadu_ps(bottom));
+    _mm_storeu_ps(&p1[12], _mm_loadu_ps(bottom));
+    _mm_storeu_ps(&p2[12], _mm_loadu_ps(bottom));
+    _mm_storeu_ps(&p3[12], _mm_loadu_ps(bottom));
+  }
+
+  // Lane-wise equivalent of `Mat4::decompose_affine`.
+  static YETI_INLINE void decompose_4(const Poses &lanes,
+                                      __m128 t[3],
+                                      __m128 q[4],
+                                      __m128 s[3]) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign = _mm_set1_ps(-0.f);
+
+    __m128 r[3][3];
+
+    for (unsigned column = 0; column < 3; ++column) {
+      const __m128 x = lanes.m[0][column];
+      const __m128 y = lanes.m[1][column];
+      const __m128 z = lanes.m[2][column];
+
+      s[column] = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x),
+                                                    _mm_mul_ps(y, y)),
+                                         _mm_mul_ps(z, z)));
+
+      const __m128 inverse_of_scale = _mm_div_ps(one, s[column]);
+
+      r[0][column] = _mm_mul_ps(x, inverse_of_scale);
+      r[1][column] = _mm_mul_ps(y, inverse_of_scale);
+      r[2][column] = _mm_mul_ps(z, inverse_of_scale);
+
+      t[column] = lanes.m[column][3];
+    }
+
+    const __m128 r00 = r[0][0], r11 = r[1][1], r22 = r[2][2];
+
+    q[3] = _mm_add_ps(_mm_add_ps(one, r00), _mm_add_ps(r11, r22));
+    q[0] = _mm_sub_ps(_mm_add_ps(one, r00), _mm_add_ps(r11, r22));
+    q[1] = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, r11), r00), r22);
+    q[2] = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, r22), r00), r11);
+
+    for (unsigned component = 0; component < 4; ++component)
+      q[component] = _mm_mul_ps(_mm_sqrt_ps(_mm_max_ps(zero, q[component])), half);
+
+    // Copy signs.
+    q[0] = _mm_or_ps(q[0], _mm_and_ps(sign, _mm_sub_ps(r[2][1], r[1][2])));
+    q[1] = _mm_or_ps(q[1], _mm_and_ps(sign, _mm_sub_ps(r[0][2], r[2][0])));
+    q[2] = _mm_or_ps(q[2], _mm_and_ps(sign, _mm_sub_ps(r[1][0], r[0][1])));
+  }
+
+  static YETI_INLINE void interpolate_4(const Mat4 *previous,
+                                        const Mat4 *current,
+                                        const f32 alpha,
+                                        Mat4 *interpolated) {
+    Poses lanes;
+
+    __m128 ta[3], qa[4], sa[3];
+    __m128 tb[3], qb[4], sb[3];
+
+    load_4(previous, &lanes);
+    decompose_4(lanes, ta, qa, sa);
+
+    load_4(current, &lanes);
+    decompose_4(lanes, tb, qb, sb);
+
+    const __m128 a = _mm_set1_ps(1.f - alpha);
+    const __m128 b = _mm_set1_ps(alpha);
+
+    // Take the shortest path by flipping signs when the dot product is
+    // negative.
+    const __m128 sign = _mm_and_ps(_mm_set1_ps(-0.f),
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(qa[0], qb[0]), _mm_mul_ps(qa[1], qb[1])),
+                 _mm_add_ps(_mm_mul_ps(qa[2], qb[2]), _mm_mul_ps(qa[3], qb[3]))));
+
+    __m128 t[3], q[4], s[3];
+
+    for (unsigned axis = 0; axis < 3; ++axis) {
+      t[axis] = _mm_add_ps(_mm_mul_ps(ta[axis], a), _mm_mul_ps(tb[axis], b));
+      s[axis] = _mm_add_ps(_mm_mul_ps(sa[axis], a), _mm_mul_ps(sb[axis], b));
+    }
+
+    for (unsigned component = 0; component < 4; ++component)
+      q[component] = _mm_add_ps(_mm_mul_ps(qa[component], a),
+                                _mm_mul_ps(_mm_xor_ps(qb[component], sign), b));
+
+    const __m128 inverse_of_magnitude =
+      _mm_div_ps(_mm_set1_ps(1.f),
+                 _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])),
+                                        _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3])))));
+
+    const __m128 x = _mm_mul_ps(q[0], inverse_of_magnitude);
+    const __m128 y = _mm_mul_ps(q[1], inverse_of_magnitude);
+    const __m128 z = _mm_mul_ps(q[2], inverse_of_magnitude);
+    const __m128 w = _mm_mul_ps(q[3], inverse_of_magnitude);
+
+    // Compose, as per `Mat4::compose`.
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+
+    const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    lanes.m[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), s[0]);
+    lanes.m[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), s[1]);
+    lanes.m[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), s[2]);
+    lanes.m[0][3] = t[0];
+
+    lanes.m[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), s[0]);
+    lanes.m[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), s[1]);
+    lanes.m[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), s[2]);
+    lanes.m[1][3] = t[1];
+
+    lanes.m[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), s[0]);
+    lanes.m[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), s[1]);
+    lanes.m[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), s[2]);
+    lanes.m[2][3] = t[2];
+
+    store_4(lanes, interpolated);
+  }
+#endif
+
+  static void interpolate_n(const Mat4 *previous,
+                            const Mat4 *current,
+                            const f32 alpha,
+                            Mat4 *interpolated,
+                            const u32 n)
+  {
+    u32 index = 0;
+
+  #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+      YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+    for (; index + 4 <= n; index += 4)
+      interpolate_4(&previous[index], &current[index], alpha, &interpolated[index]);
+  #endif
+
+    for (; index < n; ++index)
+      interpolate_1(previous[index], current[index], alpha, &interpolated[index]);
+  }
 }
 
 TransformSystem::TransformSystem(EntityManager *entities)
@@ -214,8 +448,11 @@ TransformSystem::TransformSystem(EntityManager *entities)
   , parent_(core::global_page_allocator(), limit_)
   , local_poses_(core::global_page_allocator(), limit_)
   , world_poses_(core::global_page_allocator(), limit_)
+  , previous_world_poses_(core::global_page_allocator(), limit_)
+  , interpolated_world_poses_(core::global_page_allocator(), limit_)
   , dirty_(core::global_page_allocator(), limit_)
   , changed_(core::global_page_allocator(), limit_)
+  , fresh_(core::global_page_allocator(), limit_)
   , dead_(core::global_heap_allocator())
 {
   for (unsigned index = 0; index < limit_; ++index)
@@ -233,6 +470,12 @@ Transform::Handle TransformSystem::create(Entity entity,
   // Enforce one-to-one mapping.
   yeti_assert_with_reason_debug(!this->has(entity), "Transform component already associated with entity.");
 
+  if (n_ == limit_)
+    // Dead instances are still occupying space, so collect them now.
+    TransformSystem::gc();
+
+  yeti_assert_with_reason_development(n_ < limit_, "Too many transforms.");
+
   const u32 instance = n_++;
 
   entity_to_instance_[entity.index()].index = instance;
@@ -240,11 +483,18 @@ Transform::Handle TransformSystem::create(Entity entity,
 
   parent_[instance] = -1;
 
-  local_poses_[instance] = Mat4::IDENTITY;
-  world_poses_[instance] = Mat4::IDENTITY;
+  const Mat4 pose = Mat4::compose(position, rotation, scale);
+
+  // Unlinked, so local-pose is equivalent to world-pose.
+  local_poses_[instance] = pose;
+  world_poses_[instance] = pose;
+
+  previous_world_poses_[instance] = pose;
+  interpolated_world_poses_[instance] = pose;
 
-  dirty_[instance] = true;
-  changed_[instance] = true;
+  dirty_.set(instance);
+  changed_.set(instance);
+  fresh_.set(instance);
 
   return { entity.index() };
 }
@@ -252,17 +502,24 @@ Transform::Handle TransformSystem::create(Entity entity,
 void TransformSystem::destroy(Transform::Handle handle) {
   const Transform::Instance instance = resolve(handle);
 
-  // Defer destruction until next update as this prevents instances from being
+  yeti_assert_with_reason_debug(instance.index != u32(-1), "Transform component already destroyed.");
+
+  // Defer destruction until we collect as this prevents instances from being
   // invalidated (pointing to wrong instances) for the duration of a frame.
   dead_.push(instance);
 
-  // Unlink all children otherwise they'll be linked to a random transform at
-  // some point in the future.
-  this->unlink_all_children(instance);
+  // Children are unlinked when we collect, otherwise they'd be linked to a
+  // random transform at some point in the future. Until then they continue to
+  // follow the last known pose of this instance.
 
   // Unmap.
   entity_to_instance_[handle.opaque] = { u32(-1) };
-  instance_to_entity_[instance.index] = { 0xFFFFFFFF };
+  instance_to_entity_[instance.index] = Entity();
+
+  // Dead instances linger until collected, so make sure they're skipped.
+  dirty_.reset(instance.index);
+  changed_.reset(instance.index);
+  fresh_.reset(instance.index);
 }
 
 void TransformSystem::destroy(Entity entity) {
@@ -297,7 +554,7 @@ Vec3 TransformSystem::get_local_position(Transform::Instance instance) {
 
 Quaternion TransformSystem::get_local_rotation(Transform::Instance instance) {
   const Mat4 &pose = local_poses_[instance.index];
-  return rotation_from_matrix(pose);
+  return rotation_from_affine_matrix(pose);
 }
 
 Vec3 TransformSystem::get_local_scale(Transform::Instance instance) {
@@ -377,10 +634,14 @@ Mat4 TransformSystem::get_world_pose(Transform::Instance instance) {
   return world_poses_[instance.index];
 }
 
+Mat4 TransformSystem::get_interpolated_world_pose(Transform::Instance instance) {
+  return interpolated_world_poses_[instance.index];
+}
+
 void TransformSystem::modified(Transform::Instance instance) {
   // TODO(mtwilliams): Mark descendants.
-  dirty_[instance.index] = true;
-  changed_[instance.index] = true;
+  dirty_.set(instance.index);
+  changed_.set(instance.index);
 }
 
 void TransformSystem::unlink_all_children(Transform::Instance instance) {
@@ -391,13 +652,29 @@ void TransformSystem::unlink_all_children(Transform::Instance instance) {
 // greatest.
 
 void TransformSystem::update() {
-  // Quick 'n' dirty linear walk through transforms.
-  for (u32 index = 0; index < n_; ++index)
-    if (dirty_[index])
-      this->recompute({ index });
+  // PERF(mtwilliams): Only copy poses that changed during the last two steps.
+  core::memory::copy((const void *)world_poses_.raw(),
+                     (void *)previous_world_poses_.raw(),
+                     n_ * sizeof(Mat4));
+
+  // Walk dirty transforms, skipping clean ones a word at a time.
+  for (size_t index = dirty_.find_next_set(); index < n_; index = dirty_.find_next_set(index + 1))
+    this->recompute({ (u32)index });
 
-  // Blow away dead transforms.
-  TransformSystem::gc();
+  // Fresh instances have no pose prior to this update to blend from, so
+  // start them where they were created rather than at the origin.
+  for (size_t index = fresh_.find_next_set(); index < n_; index = fresh_.find_next_set(index + 1))
+    previous_world_poses_[index] = world_poses_[index];
+
+  fresh_.reset_range(0, n_);
+
+  // Changes are only tracked between updates.
+  changed_.reset_range(0, n_);
+
+  // Blow away dead transforms, but only once there's enough of them to make
+  // it worthwhile.
+  if (dead_.size() >= TRANSFORM_GC_THRESHOLD)
+    TransformSystem::gc();
 }
 
 void TransformSystem::recompute(Transform::Instance instance) {
@@ -412,49 +689,94 @@ void TransformSystem::recompute(Transform::Instance instance) {
     world_poses_[index] = local_poses_[index];
 
   // No longer dirty, of course.
-  dirty_[instance.index] = false;
+  dirty_.reset(instance.index);
+}
+
+void TransformSystem::interpolate(const f32 alpha) {
+  yeti_assert_debug(alpha >= 0.f && alpha <= 1.f);
+
+  if (alpha >= 1.f) {
+    // Short-circuit, as we'd otherwise introduce error by decomposing.
+    core::memory::copy((const void *)world_poses_.raw(),
+                       (void *)interpolated_world_poses_.raw(),
+                       n_ * sizeof(Mat4));
+    return;
+  }
+
+  transform::interpolate_n(previous_world_poses_.raw(),
+                           world_poses_.raw(),
+                           alpha,
+                           interpolated_world_poses_.raw(),
+                           n_);
 }
 
 void TransformSystem::gc() {
-  // Sort from highest to lowest so we can work backwards.
-  std::sort(dead_.begin(), dead_.end(), [](const auto &a, const auto &b) { return a.index > b.index; });
+  // Instances are about to move, so translate links into entities which are
+  // stable. Children of dead instances are unlinked in the process, and keep
+  // their last world pose.
+  for (u32 index = 0; index < n_; ++index) {
+    if (parent_[index] == u32(-1))
+      continue;
 
-  u32 swap;
+    if (is_dead(instance_to_entity_[index]))
+      continue;
 
-  // Skip any dead instances occupying the tail end of our arrays.
-  for (swap = 0; swap < dead_.size(); swap++)
-    if (dead_[swap].index != n_ - swap - 1)
-      break;
+    const Entity parent = instance_to_entity_[parent_[index]];
 
-  // Swap the last alive instance with remaining dead instances.
-  for (Transform::Instance *dead = &dead_[swap]; dead < dead_.end(); ++dead) {
-    // Identify the last alive instance.
-    const Entity replacement = instance_to_entity_[swap];
+    if (is_dead(parent)) {
+      local_poses_[index] = world_poses_[index];
+      parent_[index] = u32(-1);
+    } else {
+      parent_[index] = parent.index();
+    }
+  }
+
+  // Swap-remove dead instances from the tail. Since the tail is popped of
+  // dead instances prior to each swap, we never move a dead instance and
+  // don't need to process dead instances in any particular order.
+  for (const Transform::Instance *dead = dead_.begin(); dead != dead_.end(); ++dead) {
+    while (n_ && is_dead(instance_to_entity_[n_ - 1]))
+      --n_;
+
+    if (dead->index >= n_)
+      // Already popped.
+      continue;
+
+    const u32 last = --n_;
 
     // Remap.
+    const Entity replacement = instance_to_entity_[last];
     entity_to_instance_[replacement.index()] = { dead->index };
     instance_to_entity_[dead->index] = replacement;
 
-    // Replace parent and poses but not flags as we collect after recomputing
-    // poses.
-    parent_[dead->index] = parent_[swap];
-    local_poses_[dead->index] = local_poses_[swap];
-    world_poses_[dead->index] = world_poses_[swap];
-
-    swap--;
+    parent_[dead->index] = parent_[last];
+    local_poses_[dead->index] = local_poses_[last];
+    world_poses_[dead->index] = world_poses_[last];
+    previous_world_poses_[dead->index] = previous_world_poses_[last];
+    interpolated_world_poses_[dead->index] = interpolated_world_poses_[last];
+    dirty_.assign(dead->index, dirty_.test(last));
+    changed_.assign(dead->index, changed_.test(last));
+    fresh_.assign(dead->index, fresh_.test(last));
+
+    // Keep flags clear past the end so walks stop at the last instance.
+    dirty_.reset(last);
+    changed_.reset(last);
+    fresh_.reset(last);
   }
 
-  // Now "pop" the dead instances that are all at the end of our arrays.
-  n_ -= dead_.size();
+  // Translate links back into instances.
+  for (u32 index = 0; index < n_; ++index)
+    if (parent_[index] != u32(-1))
+      parent_[index] = entity_to_instance_[parent_[index]].index;
 
-  // Clear our queue for the next frame.
+  // Clear our queue for the next collection.
   dead_.clear();
 }
 
 void TransformSystem::changed(core::Array<Entity> &changed) const {
-  for (unsigned instance = 0; instance < n_; ++instance)
-    if (changed_[instance])
-      changed.push(instance_to_entity_[instance]);
+  // Dead instances are never flagged as changed, so there's no need to check.
+  for (size_t instance = changed_.find_next_set(); instance < n_; instance = changed_.find_next_set(instance + 1))
+    changed.push(instance_to_entity_[instance]);
 }
 
 void TransformSystem::destroyed(Entity entity) {
@@ -0,0 +1,97 @@
+//===-- yeti/core/algorithms/sort.cc --------------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/core/algorithms/sort.h"
+
+#include "yeti/core/memory.h"
+
+// For sanity checks.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+namespace radix {
+  template <typename K, bool Values>
+  static void sort(K *keys,
+                   u32 *values,
+                   K *keys_scratch,
+                   u32 *values_scratch,
+                   size_t n) {
+    yeti_assert_debug(n <= 0xFFFFFFFFull);
+
+    if (n <= 1)
+      return;
+
+    // Count every digit upfront, in a single pass over keys. Counts don't
+    // change as keys are reordered.
+    u32 histograms[sizeof(K)][RADIX];
+    memory::zero((void *)histograms, sizeof(histograms));
+    count(keys, n, histograms);
+
+    K *from_keys = keys, *to_keys = keys_scratch;
+    u32 *from_values = values, *to_values = values_scratch;
+
+    for (unsigned pass = 0; pass < sizeof(K); ++pass) {
+      if (trivial(histograms[pass], n))
+        // Wouldn't change order.
+        continue;
+
+      u32 offsets[RADIX];
+
+      for (unsigned d = 0, offset = 0; d < RADIX; ++d) {
+        offsets[d] = offset;
+        offset += histograms[pass][d];
+      }
+
+      scatter<K, Values>(from_keys, from_values, to_keys, to_values, n, pass, offsets);
+
+      K *swap_keys = from_keys;
+      from_keys = to_keys;
+      to_keys = swap_keys;
+
+      u32 *swap_values = from_values;
+      from_values = to_values;
+      to_values = swap_values;
+    }
+
+    if (from_keys != keys) {
+      // Ended up in scratch after an odd number of passes.
+      memory::copy((const void *)from_keys, (void *)keys, n * sizeof(K));
+
+      if (Values)
+        memory::copy((const void *)from_values, (void *)values, n * sizeof(u32));
+    }
+  }
+}
+
+void radix_sort(u32 *keys, u32 *values, u32 *keys_scratch, u32 *values_scratch, size_t n) {
+  yeti_assert_debug(!n || (keys != NULL && keys_scratch != NULL));
+  yeti_assert_debug((values == NULL) == (values_scratch == NULL));
+
+  if (values)
+    radix::sort<u32, true>(keys, values, keys_scratch, values_scratch, n);
+  else
+    radix::sort<u32, false>(keys, values, keys_scratch, values_scratch, n);
+}
+
+void radix_sort(u64 *keys, u32 *values, u64 *keys_scratch, u32 *values_scratch, size_t n) {
+  yeti_assert_debug(!n || (keys != NULL && keys_scratch != NULL));
+  yeti_assert_debug((values == NULL) == (values_scratch == NULL));
+
+  if (values)
+    radix::sort<u64, true>(keys, values, keys_scratch, values_scratch, n);
+  else
+    radix::sort<u64, false>(keys, values, keys_scratch, values_scratch, n);
+}
+
+} // core
+} // yeti
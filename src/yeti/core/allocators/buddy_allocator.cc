@@ -10,3 +10,292 @@
 //===----------------------------------------------------------------------===//
 
 #include "yeti/core/allocators/buddy_allocator.h"
+
+// Levels are derived from bit scans.
+#include "yeti/core/bits.h"
+
+// For sanity checks.
+#include "yeti/core/utilities.h"
+#include "yeti/core/debug/assert.h"
+
+// Bookkeeping for arenas we don't own.
+#include "yeti/core/allocators/global_heap_allocator.h"
+
+namespace yeti {
+namespace core {
+
+namespace buddy_allocator {
+  static unsigned floor_log2(size_t v) {
+    return 63 - bit::clz((u64)v);
+  }
+
+  static unsigned ceil_log2(size_t v) {
+    return (v > 1) ? (64 - bit::clz((u64)(v - 1))) : 0;
+  }
+
+  static size_t round_down_to_power_of_two(size_t v) {
+    return v ? ((size_t)1 << floor_log2(v)) : 0;
+  }
+
+  // Blocks that can be split, of which there's one less than there are
+  // minimum sized blocks.
+  static size_t num_of_nodes(size_t size, size_t minimum) {
+    return (size >= minimum) ? (size / minimum) - 1 : 0;
+  }
+
+  // Arena is aligned as strictly as reasonable, so large blocks can satisfy
+  // strict alignment.
+  static size_t alignment_of_arena(size_t size) {
+    return (size < 4096) ? size : 4096;
+  }
+}
+
+BuddyAllocator::BuddyAllocator(Allocator *allocator, size_t size, size_t minimum)
+  : Allocator()
+  , backing_(allocator)
+  , size_(buddy_allocator::round_down_to_power_of_two(size))
+  , minimum_(minimum)
+  , base_((uintptr_t)allocator->allocate(size_, buddy_allocator::alignment_of_arena(size_)))
+  , split_(allocator, buddy_allocator::num_of_nodes(size_, minimum_))
+  , buddies_(allocator, buddy_allocator::num_of_nodes(size_, minimum_))
+{
+  this->initialize();
+}
+
+BuddyAllocator::BuddyAllocator(Allocator &allocator, size_t size, size_t minimum)
+  : Allocator()
+  , backing_(&allocator)
+  , size_(buddy_allocator::round_down_to_power_of_two(size))
+  , minimum_(minimum)
+  , base_((uintptr_t)allocator.allocate(size_, buddy_allocator::alignment_of_arena(size_)))
+  , split_(allocator, buddy_allocator::num_of_nodes(size_, minimum_))
+  , buddies_(allocator, buddy_allocator::num_of_nodes(size_, minimum_))
+{
+  this->initialize();
+}
+
+BuddyAllocator::BuddyAllocator(void *memory, size_t size, size_t minimum)
+  : Allocator()
+  , backing_(NULL)
+  , size_(buddy_allocator::round_down_to_power_of_two(size))
+  , minimum_(minimum)
+  , base_((uintptr_t)memory)
+  , split_(global_heap_allocator(), buddy_allocator::num_of_nodes(size_, minimum_))
+  , buddies_(global_heap_allocator(), buddy_allocator::num_of_nodes(size_, minimum_))
+{
+  this->initialize();
+}
+
+BuddyAllocator::~BuddyAllocator() {
+  if (backing_)
+    backing_->deallocate((void *)base_);
+}
+
+void BuddyAllocator::initialize() {
+  yeti_assert_debug(base_ != 0);
+
+  yeti_assert_with_reason_debug(YETI_IS_POWER_OF_TWO((u64)minimum_), "Minimum size of blocks must be a power of two.");
+  yeti_assert_with_reason_debug(minimum_ >= sizeof(buddy_allocator::Block), "Minimum size of blocks is too small.");
+  yeti_assert_with_reason_debug(size_ >= minimum_, "Arena is smaller than minimum size of blocks.");
+
+  log2_of_size_ = buddy_allocator::floor_log2(size_);
+  num_of_levels_ = log2_of_size_ - buddy_allocator::floor_log2(minimum_) + 1;
+
+  yeti_assert_debug(num_of_levels_ <= buddy_allocator::MAXIMUM_NUM_OF_LEVELS);
+
+  const size_t alignment_of_base = base_ & (~base_ + 1);
+  alignment_ = (alignment_of_base < size_) ? alignment_of_base : size_;
+
+  memory::zero((void *)&free_[0], sizeof(free_));
+  memory::zero((void *)&num_of_free_blocks_[0], sizeof(num_of_free_blocks_));
+
+  // Everything is free.
+  this->push(0, (buddy_allocator::Block *)base_);
+
+  allocated_ = 0;
+  num_of_allocations_ = 0;
+}
+
+size_t BuddyAllocator::node(unsigned level, size_t offset) const {
+  return (((size_t)1 << level) - 1) + (offset >> (log2_of_size_ - level));
+}
+
+unsigned BuddyAllocator::level(size_t offset) const {
+  // Descend until we reach a block that isn't split.
+  unsigned level = 0;
+
+  while ((level + 1) < num_of_levels_ && split_.test(this->node(level, offset)))
+    level += 1;
+
+  return level;
+}
+
+void BuddyAllocator::push(unsigned level, buddy_allocator::Block *block) {
+  block->prev = NULL;
+  block->next = free_[level];
+
+  if (free_[level])
+    free_[level]->prev = block;
+
+  free_[level] = block;
+
+  num_of_free_blocks_[level] += 1;
+}
+
+void BuddyAllocator::remove(unsigned level, buddy_allocator::Block *block) {
+  if (block->prev)
+    block->prev->next = block->next;
+  else
+    free_[level] = block->next;
+
+  if (block->next)
+    block->next->prev = block->prev;
+
+  num_of_free_blocks_[level] -= 1;
+}
+
+void *BuddyAllocator::allocate(size_t size, size_t alignment) {
+  yeti_assert_debug(YETI_IS_POWER_OF_TWO((u64)alignment));
+  yeti_assert_with_reason_debug(alignment <= alignment_, "Arena isn't aligned strictly enough.");
+
+  // Blocks are aligned to their size, relative to the start of the arena.
+  size_t needed = size;
+  needed = (needed > minimum_) ? needed : minimum_;
+  needed = (needed > alignment) ? needed : alignment;
+
+  const unsigned log2_of_needed = buddy_allocator::ceil_log2(needed);
+
+  if (log2_of_needed > log2_of_size_)
+    return NULL;
+
+  const unsigned level = log2_of_size_ - log2_of_needed;
+
+  // Find smallest free block that is large enough.
+  unsigned available = level;
+
+  while (!free_[available])
+    if (available-- == 0)
+      return NULL;
+
+  buddy_allocator::Block *block = free_[available];
+
+  this->remove(available, block);
+
+  const size_t offset = (uintptr_t)block - base_;
+
+  if (available > 0)
+    buddies_.assign(this->node(available - 1, offset), !buddies_.test(this->node(available - 1, offset)));
+
+  // Split until it's just large enough, freeing the upper halves.
+  for (; available < level; ++available) {
+    const size_t parent = this->node(available, offset);
+
+    split_.set(parent);
+
+    // Lower half is in use and upper half is free.
+    buddies_.set(parent);
+
+    this->push(available + 1, (buddy_allocator::Block *)((uintptr_t)block + (size_ >> (available + 1))));
+  }
+
+  allocated_ += size_ >> level;
+  num_of_allocations_ += 1;
+
+  return (void *)block;
+}
+
+void *BuddyAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
+
+  if (size == 0) {
+    this->deallocate(ptr);
+    return NULL;
+  }
+
+  yeti_assert_debug(((uintptr_t)ptr >= base_) && ((uintptr_t)ptr < (base_ + size_)));
+
+  const size_t current = size_ >> this->level((uintptr_t)ptr - base_);
+
+  size_t needed = size;
+  needed = (needed > minimum_) ? needed : minimum_;
+  needed = (needed > alignment) ? needed : alignment;
+
+  if (((uintptr_t)ptr % alignment) == 0)
+    if (((size_t)1 << buddy_allocator::ceil_log2(needed)) == current)
+      return ptr;
+
+  void *moved = this->allocate(size, alignment);
+
+  if (moved == NULL)
+    return NULL;
+
+  memory::copy(ptr, moved, (size < current) ? size : current);
+
+  this->deallocate(ptr);
+
+  return moved;
+}
+
+void BuddyAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
+  yeti_assert_debug(((uintptr_t)ptr >= base_) && ((uintptr_t)ptr < (base_ + size_)));
+
+  size_t offset = (uintptr_t)ptr - base_;
+  unsigned level = this->level(offset);
+
+  yeti_assert_with_reason_debug((offset & ((size_ >> level) - 1)) == 0, "Not a block handed out by this allocator.");
+
+  allocated_ -= size_ >> level;
+  num_of_allocations_ -= 1;
+
+  // Merge with buddies for as long as they're free.
+  while (level > 0) {
+    const size_t parent = this->node(level - 1, offset);
+
+    const bool merge = buddies_.test(parent);
+
+    buddies_.assign(parent, !merge);
+
+    if (!merge)
+      // Buddy is in use.
+      break;
+
+    const size_t buddy = offset ^ (size_ >> level);
+
+    this->remove(level, (buddy_allocator::Block *)(base_ + buddy));
+
+    split_.reset(parent);
+
+    offset = (offset < buddy) ? offset : buddy;
+    level -= 1;
+  }
+
+  this->push(level, (buddy_allocator::Block *)(base_ + offset));
+}
+
+void BuddyAllocator::statistics(Statistics *statistics) const {
+  yeti_assert_debug(statistics != NULL);
+
+  statistics->size = size_;
+  statistics->allocated = allocated_;
+  statistics->free = 0;
+  statistics->largest_free_block = 0;
+  statistics->num_of_allocations = num_of_allocations_;
+  statistics->num_of_free_blocks = 0;
+
+  for (unsigned level = 0; level < num_of_levels_; ++level) {
+    const size_t size_of_blocks = size_ >> level;
+
+    if (num_of_free_blocks_[level] && !statistics->largest_free_block)
+      statistics->largest_free_block = size_of_blocks;
+
+    statistics->free += num_of_free_blocks_[level] * size_of_blocks;
+    statistics->num_of_free_blocks += num_of_free_blocks_[level];
+  }
+}
+
+} // core
+} // yeti
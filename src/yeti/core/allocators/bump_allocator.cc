@@ -10,3 +10,132 @@
 //===----------------------------------------------------------------------===//
 
 #include "yeti/core/allocators/bump_allocator.h"
+
+// For sanity checks.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+BumpAllocator::BumpAllocator(Allocator *allocator, size_t size)
+  : Allocator()
+  , backing_(allocator)
+  , lower_((uintptr_t)allocator->allocate(size))
+  , upper_(lower_ + size)
+  , unallocated_(lower_)
+  , last_(0)
+{
+}
+
+BumpAllocator::BumpAllocator(Allocator &allocator, size_t size)
+  : Allocator()
+  , backing_(&allocator)
+  , lower_((uintptr_t)allocator.allocate(size))
+  , upper_(lower_ + size)
+  , unallocated_(lower_)
+  , last_(0)
+{
+}
+
+BumpAllocator::BumpAllocator(void *memory, size_t size)
+  : Allocator()
+  , backing_(NULL)
+  , lower_((uintptr_t)memory)
+  , upper_(lower_ + size)
+  , unallocated_(lower_)
+  , last_(0)
+{
+}
+
+BumpAllocator::~BumpAllocator() {
+  if (backing_)
+    backing_->deallocate((void *)lower_);
+}
+
+void *BumpAllocator::allocate(size_t size, size_t alignment) {
+  const uintptr_t allocation = unallocated_ + memory::align(unallocated_, alignment);
+
+  if (allocation > upper_ || size > upper_ - allocation)
+    // We don't have enough memory left to fufill the requested allocation.
+    return NULL;
+
+  unallocated_ = allocation + size;
+  last_ = allocation;
+
+  return (void *)allocation;
+}
+
+void *BumpAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
+
+  yeti_assert_debug(this->owns(ptr));
+
+  if ((uintptr_t)ptr == last_ && ((uintptr_t)ptr % alignment) == 0) {
+    if (size > upper_ - last_)
+      return NULL;
+
+    // Resize in place.
+    unallocated_ = last_ + size;
+
+    return ptr;
+  }
+
+  // We don't know how large the original allocation was, but it can't extend
+  // past anything allocated after it, so copying up to that is safe.
+  const size_t available = unallocated_ - (uintptr_t)ptr;
+
+  void *moved = this->allocate(size, alignment);
+
+  if (moved)
+    memory::copy(ptr, moved, (size < available) ? size : available);
+
+  return moved;
+}
+
+void BumpAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
+  yeti_assert_debug(this->owns(ptr));
+
+  if ((uintptr_t)ptr == last_) {
+    // Undo last allocation. We don't know where the one before starts, so we
+    // can only do this once.
+    unallocated_ = last_;
+    last_ = 0;
+  }
+}
+
+BumpAllocator::Marker BumpAllocator::mark() const {
+  return unallocated_;
+}
+
+void BumpAllocator::rewind(BumpAllocator::Marker marker) {
+  yeti_assert_debug(marker >= lower_ && marker <= unallocated_);
+
+  unallocated_ = marker;
+
+  if (last_ >= marker)
+    last_ = 0;
+}
+
+void BumpAllocator::reset() {
+  unallocated_ = lower_;
+  last_ = 0;
+}
+
+bool BumpAllocator::owns(const void *ptr) const {
+  return ((uintptr_t)ptr >= lower_) && ((uintptr_t)ptr < upper_);
+}
+
+size_t BumpAllocator::used() const {
+  return unallocated_ - lower_;
+}
+
+size_t BumpAllocator::remaining() const {
+  return upper_ - unallocated_;
+}
+
+} // core
+} // yeti
@@ -0,0 +1,112 @@
+//===-- yeti/core/allocators/frame_allocator.cc ---------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/core/allocators/frame_allocator.h"
+
+// Buffers are whole pages.
+#include "yeti/core/allocators/global_page_allocator.h"
+
+// For sanity checks.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+FrameAllocator::FrameAllocator(Allocator *allocator, size_t size)
+  : Allocator()
+  , backing_(allocator)
+  , memory_((uintptr_t)allocator->allocate(2 * size))
+  , even_((void *)memory_, size)
+  , odd_((void *)(memory_ + size), size)
+  , current_(&even_)
+  , previous_(&odd_)
+{
+}
+
+FrameAllocator::FrameAllocator(Allocator &allocator, size_t size)
+  : Allocator()
+  , backing_(&allocator)
+  , memory_((uintptr_t)allocator.allocate(2 * size))
+  , even_((void *)memory_, size)
+  , odd_((void *)(memory_ + size), size)
+  , current_(&even_)
+  , previous_(&odd_)
+{
+}
+
+FrameAllocator::~FrameAllocator() {
+  backing_->deallocate((void *)memory_);
+}
+
+void *FrameAllocator::allocate(size_t size, size_t alignment) {
+  void *ptr = current_->allocate(size, alignment);
+
+  yeti_assert_with_reason_development(ptr != NULL, "Out of per-frame memory!");
+
+  return ptr;
+}
+
+void *FrameAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL || current_->owns(ptr)) {
+    void *reallocated = current_->reallocate(ptr, size, alignment);
+    yeti_assert_with_reason_development(reallocated != NULL, "Out of per-frame memory!");
+    return reallocated;
+  }
+
+  yeti_assert_with_reason_debug(previous_->owns(ptr), "Reallocating memory from before last frame.");
+
+  // Carried over from last frame. Same reasoning as `BumpAllocator`, applied
+  // to the previous buffer.
+  const size_t available = (size_t)(previous_->mark() - (uintptr_t)ptr);
+
+  void *moved = this->allocate(size, alignment);
+
+  if (moved)
+    memory::copy(ptr, moved, (size < available) ? size : available);
+
+  return moved;
+}
+
+void FrameAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
+  if (current_->owns(ptr))
+    current_->deallocate(ptr);
+
+  // Anything from last frame is reclaimed next flip.
+}
+
+void FrameAllocator::flip() {
+  BumpAllocator *reclaimed = previous_;
+
+  previous_ = current_;
+  current_ = reclaimed;
+
+  current_->reset();
+}
+
+BumpAllocator &FrameAllocator::current() {
+  return *current_;
+}
+
+FrameAllocator &global_frame_allocator() {
+  // HACK(mtwilliams): Force initialization on first call in case static
+  // constructors need to allocate from the global frame allocator.
+
+  // BUG(mtwilliams): May initialize more than once.
+  static FrameAllocator global_frame_allocator_(global_page_allocator(), frame_allocator::DEFAULT_SIZE_OF_BUFFERS);
+
+  return global_frame_allocator_;
+}
+
+} // core
+} // yeti
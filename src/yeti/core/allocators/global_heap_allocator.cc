@@ -19,12 +19,546 @@
   #include <malloc.h>
 #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
       YETI_PLATFORM == YETI_PLATFORM_LINUX
-  #include <malloc.h>
+  // Size classes are derived from bit scans.
+  #include "yeti/core/bits.h"
+
+  // Remote frees and heap bookkeeping are lock-free.
+  #include "yeti/core/atomics.h"
+
+  #include <unistd.h>
+  #include <pthread.h>
+  #include <sys/mman.h>
 #endif
 
 namespace yeti {
 namespace core {
 
+#if YETI_PLATFORM == YETI_PLATFORM_MAC || \
+    YETI_PLATFORM == YETI_PLATFORM_LINUX
+
+// NOTE(mtwilliams): We roll our own heap rather than relying on the system
+// allocator, as resource loading and scripts allocate heavily from workers.
+//
+// Small allocations are rounded up to one of a few dozen size classes and
+// carved from 64KiB slabs dedicated to a single size class. Each thread has
+// its own heap of slabs, so allocating and freeing on the same thread never
+// synchronizes. Blocks freed by other threads are pushed onto a lock-free
+// list belonging to their slab, which the owning thread collects when it
+// runs out of blocks.
+//
+// Slabs are aligned to their size, so the slab a block belongs to is found
+// by masking its address. Large allocations are mapped individually, but
+// are prefixed by a slab header for the same reason.
+//
+// Heaps are never freed. When a thread exits its heap is abandoned, and is
+// adopted by the next thread to need one, along with its slabs.
+
+namespace heap {
+  static const size_t SLAB_SIZE = 65536;
+
+  static const size_t MAXIMUM_SIZE_OF_SMALL_ALLOCATION = 16384;
+
+  static const unsigned NUM_OF_SIZE_CLASSES = 40;
+
+  // Blocks are aligned to the largest power of two dividing their size, up
+  // to this. Requests for stricter alignment are served by larger classes.
+  static const size_t MAXIMUM_ALIGNMENT_OF_BLOCKS = 1024;
+
+  // Number of slabs checked for free blocks before giving up and mapping a
+  // new one. Keeps the slow path bounded when most slabs are full.
+  static const unsigned MAXIMUM_NUM_OF_SLABS_TO_SEARCH = 8;
+
+  // Number of empty slabs each heap holds on to rather than unmapping.
+  static const unsigned MAXIMUM_NUM_OF_SPARE_SLABS = 8;
+
+  struct Block {
+    Block *next;
+  };
+
+  struct Heap;
+
+  struct Slab {
+    enum Kind {
+      SMALL = 0x534D414C,
+      LARGE = 0x4C415247
+    };
+
+    u32 kind;
+
+    // Index of size class, for small allocations.
+    u32 size_class;
+
+    // Heap blocks are allocated from.
+    Heap *owner;
+
+    // Siblings of same size class, in a ring.
+    Slab *prev;
+    Slab *next;
+
+    // Blocks freed by owner.
+    Block *free;
+
+    // Blocks yet to be handed out.
+    uintptr_t unused;
+    uintptr_t end;
+
+    // Number of blocks handed out and not yet collected.
+    u32 used;
+
+    // Number of bytes mapped, for large allocations.
+    size_t mapped;
+
+    // Keep remote frees from contending with owner.
+    u8 padding_[YETI_CACHE_LINE];
+
+    // Blocks freed by other threads.
+    void *volatile remote;
+  };
+
+  struct Heap {
+    // Rings of slabs by size class. Allocations are served from the first.
+    Slab *slabs[NUM_OF_SIZE_CLASSES];
+
+    // Empty slabs for reuse.
+    Slab *spare;
+    unsigned num_of_spare;
+
+    // All heaps.
+    Heap *next;
+
+    // Heaps awaiting adoption.
+    Heap *next_abandoned;
+
+    // Only ever modified by owning thread.
+    u64 allocations;
+    u64 deallocations;
+    u64 remote_deallocations;
+
+    // May go negative, as mappings can be released by other threads.
+    i64 mapped;
+  };
+
+  static Heap *volatile heaps_ = NULL;
+
+  static Heap *abandoned_ = NULL;
+  static volatile u32 abandoned_lock_ = 0;
+
+  static YETI_THREAD_LOCAL Heap *heap_for_thread_ = NULL;
+
+  static pthread_once_t abandon_on_exit_once_ = PTHREAD_ONCE_INIT;
+  static pthread_key_t abandon_on_exit_;
+
+  static size_t size_of_class(unsigned size_class) {
+    if (size_class < 16)
+      return (size_class + 1) * 16;
+
+    // Four classes between each power of two.
+    const unsigned group = (size_class - 16) / 4;
+    const unsigned step = (size_class - 16) % 4;
+
+    return (size_t)(5 + step) << (6 + group);
+  }
+
+  static size_t alignment_of_class(unsigned size_class) {
+    const size_t size = size_of_class(size_class);
+    const size_t alignment = size & (~size + 1);
+    return (alignment < MAXIMUM_ALIGNMENT_OF_BLOCKS) ? alignment : MAXIMUM_ALIGNMENT_OF_BLOCKS;
+  }
+
+  static unsigned class_for_size(size_t size) {
+    if (size <= 256)
+      return size ? (unsigned)((size - 1) >> 4) : 0;
+
+    const unsigned log2 = 31 - bit::clz((u32)(size - 1));
+
+    return 16 + (log2 - 8) * 4 + (unsigned)((size - 1) >> (log2 - 2)) - 4;
+  }
+
+  // Returns `NUM_OF_SIZE_CLASSES` if too large or too strictly aligned.
+  static unsigned class_for_size(size_t size, size_t alignment) {
+    if (size > MAXIMUM_SIZE_OF_SMALL_ALLOCATION)
+      return NUM_OF_SIZE_CLASSES;
+
+    if (alignment <= 16)
+      return class_for_size(size);
+
+    unsigned size_class = class_for_size((size > alignment) ? size : alignment);
+
+    while (size_class < NUM_OF_SIZE_CLASSES && alignment_of_class(size_class) < alignment)
+      size_class += 1;
+
+    return size_class;
+  }
+
+  static size_t round_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+
+  static size_t size_of_pages() {
+    static const size_t size = (size_t)::sysconf(_SC_PAGESIZE);
+    return size;
+  }
+
+  static Slab *slab_from_pointer(const void *ptr) {
+    return (Slab *)((uintptr_t)ptr & ~(uintptr_t)(SLAB_SIZE - 1));
+  }
+
+  // Maps @size bytes aligned to a slab.
+  static uintptr_t map(size_t size) {
+    // Over map so we can trim to alignment.
+    const size_t padded = size + SLAB_SIZE - size_of_pages();
+
+    void *address = ::mmap(NULL, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    yeti_assert_with_reason(address != MAP_FAILED, "Out of memory!");
+
+    const uintptr_t base = (uintptr_t)address;
+    const uintptr_t aligned = round_up(base, SLAB_SIZE);
+
+    if (aligned > base)
+      ::munmap((void *)base, aligned - base);
+    if (base + padded > aligned + size)
+      ::munmap((void *)(aligned + size), (base + padded) - (aligned + size));
+
+    return aligned;
+  }
+
+  static void unmap(uintptr_t address, size_t size) {
+    ::munmap((void *)address, size);
+  }
+
+  static void spin(volatile u32 *lock) {
+    while (atomic::cmp_and_xchg(lock, 0, 1) != 0)
+      ;
+  }
+
+  static void unspin(volatile u32 *lock) {
+    atomic::barrier();
+    atomic::store(lock, (u32)0);
+  }
+
+  static void abandon(void *heap) {
+    heap_for_thread_ = NULL;
+
+    spin(&abandoned_lock_);
+    ((Heap *)heap)->next_abandoned = abandoned_;
+    abandoned_ = (Heap *)heap;
+    unspin(&abandoned_lock_);
+  }
+
+  static void prepare_to_abandon() {
+    ::pthread_key_create(&abandon_on_exit_, &abandon);
+  }
+
+  static Heap *adopt_or_create_heap() {
+    spin(&abandoned_lock_);
+
+    Heap *heap = abandoned_;
+
+    if (heap)
+      abandoned_ = heap->next_abandoned;
+
+    unspin(&abandoned_lock_);
+
+    if (!heap) {
+      heap = (Heap *)::mmap(NULL, round_up(sizeof(Heap), size_of_pages()), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+      yeti_assert_with_reason(heap != MAP_FAILED, "Out of memory!");
+
+      // Mapped pages are zeroed, so no further initialization is required.
+
+      Heap *head;
+      do {
+        head = heaps_;
+        heap->next = head;
+      } while (atomic::cmp_and_xchg((void *volatile *)&heaps_, (void *)head, (void *)heap) != (void *)head);
+    }
+
+    heap->next_abandoned = NULL;
+
+    // Abandon on exit, so slabs aren't leaked.
+    ::pthread_once(&abandon_on_exit_once_, &prepare_to_abandon);
+    ::pthread_setspecific(abandon_on_exit_, (void *)heap);
+
+    return heap_for_thread_ = heap;
+  }
+
+  static YETI_INLINE Heap *heap_for_thread() {
+    if (Heap *heap = heap_for_thread_)
+      return heap;
+    return adopt_or_create_heap();
+  }
+
+  // Links @slab to front of its ring.
+  static void link(Heap *heap, Slab *slab) {
+    Slab *&head = heap->slabs[slab->size_class];
+
+    if (head) {
+      slab->prev = head->prev;
+      slab->next = head;
+      head->prev->next = slab;
+      head->prev = slab;
+    } else {
+      slab->prev = slab->next = slab;
+    }
+
+    head = slab;
+  }
+
+  static void unlink(Heap *heap, Slab *slab) {
+    Slab *&head = heap->slabs[slab->size_class];
+
+    if (slab->next == slab) {
+      head = NULL;
+      return;
+    }
+
+    slab->prev->next = slab->next;
+    slab->next->prev = slab->prev;
+
+    if (head == slab)
+      head = slab->next;
+  }
+
+  static Slab *create_slab(Heap *heap, unsigned size_class) {
+    Slab *slab = heap->spare;
+
+    if (slab) {
+      heap->spare = slab->next;
+      heap->num_of_spare -= 1;
+    } else {
+      slab = (Slab *)map(SLAB_SIZE);
+      heap->mapped += SLAB_SIZE;
+    }
+
+    const size_t size = size_of_class(size_class);
+    const size_t offset = round_up(sizeof(Slab), alignment_of_class(size_class));
+
+    slab->kind = Slab::SMALL;
+    slab->size_class = size_class;
+    slab->owner = heap;
+    slab->free = NULL;
+    slab->unused = (uintptr_t)slab + offset;
+    slab->end = (uintptr_t)slab + offset + ((SLAB_SIZE - offset) / size) * size;
+    slab->used = 0;
+    slab->mapped = SLAB_SIZE;
+    slab->remote = NULL;
+
+    link(heap, slab);
+
+    return slab;
+  }
+
+  static void destroy_slab(Heap *heap, Slab *slab) {
+    unlink(heap, slab);
+
+    if (heap->num_of_spare < MAXIMUM_NUM_OF_SPARE_SLABS) {
+      slab->next = heap->spare;
+      heap->spare = slab;
+      heap->num_of_spare += 1;
+    } else {
+      unmap((uintptr_t)slab, SLAB_SIZE);
+      heap->mapped -= SLAB_SIZE;
+    }
+  }
+
+  // Moves blocks freed by other threads to free list.
+  static void collect(Slab *slab) {
+    if (!slab->remote)
+      return;
+
+    void *blocks;
+
+    do {
+      blocks = slab->remote;
+    } while (atomic::cmp_and_xchg(&slab->remote, blocks, NULL) != blocks);
+
+    Block *tail = (Block *)blocks;
+    u32 collected = 1;
+
+    while (tail->next) {
+      tail = tail->next;
+      collected += 1;
+    }
+
+    tail->next = slab->free;
+    slab->free = (Block *)blocks;
+
+    slab->used -= collected;
+  }
+
+  static void *take(Slab *slab) {
+    if (!slab->free)
+      collect(slab);
+
+    if (Block *block = slab->free) {
+      slab->free = block->next;
+      slab->used += 1;
+      return (void *)block;
+    }
+
+    const size_t size = size_of_class(slab->size_class);
+
+    if (slab->unused + size <= slab->end) {
+      void *block = (void *)slab->unused;
+      slab->unused += size;
+      slab->used += 1;
+      return block;
+    }
+
+    return NULL;
+  }
+
+  static void *allocate_small_slowly(Heap *heap, unsigned size_class) {
+    if (Slab *first = heap->slabs[size_class]) {
+      for (unsigned searched = 0; searched < MAXIMUM_NUM_OF_SLABS_TO_SEARCH; ++searched) {
+        if (void *block = take(heap->slabs[size_class]))
+          // Serve from this slab until it's exhausted.
+          return block;
+
+        // Rotate exhausted slabs to the back, so slabs that have had blocks
+        // freed by other threads are eventually revisited.
+        heap->slabs[size_class] = heap->slabs[size_class]->next;
+
+        if (heap->slabs[size_class] == first)
+          break;
+      }
+    }
+
+    return take(create_slab(heap, size_class));
+  }
+
+  static YETI_INLINE void *allocate_small(Heap *heap, unsigned size_class) {
+    heap->allocations += 1;
+
+    if (Slab *slab = heap->slabs[size_class]) {
+      if (Block *block = slab->free) {
+        slab->free = block->next;
+        slab->used += 1;
+        return (void *)block;
+      }
+    }
+
+    return allocate_small_slowly(heap, size_class);
+  }
+
+  static void deallocate_small(Heap *heap, Slab *slab, void *ptr) {
+    heap->deallocations += 1;
+
+    if (slab->owner != heap) {
+      heap->remote_deallocations += 1;
+
+      void *head;
+
+      do {
+        head = slab->remote;
+        ((Block *)ptr)->next = (Block *)head;
+      } while (atomic::cmp_and_xchg(&slab->remote, head, ptr) != head);
+
+      return;
+    }
+
+    Block *block = (Block *)ptr;
+
+    const bool exhausted = (slab->free == NULL);
+
+    block->next = slab->free;
+    slab->free = block;
+
+    slab->used -= 1;
+
+    if (slab == heap->slabs[slab->size_class])
+      return;
+
+    if (slab->used == 0) {
+      // Release memory, keeping at least one slab for each size class.
+      destroy_slab(heap, slab);
+    } else if (exhausted) {
+      // Prefer slabs with free blocks.
+      unlink(heap, slab);
+      link(heap, slab);
+    }
+  }
+
+  static size_t offset_for_large(size_t alignment) {
+    return round_up(sizeof(Slab), (alignment > 16) ? alignment : 16);
+  }
+
+  static void *allocate_large(Heap *heap, size_t size, size_t alignment) {
+    yeti_assert_debug(alignment < SLAB_SIZE);
+
+    heap->allocations += 1;
+
+    const size_t offset = offset_for_large(alignment);
+    const size_t mapped = round_up(offset + size, size_of_pages());
+
+    Slab *slab = (Slab *)map(mapped);
+
+    heap->mapped += mapped;
+
+    slab->kind = Slab::LARGE;
+    slab->owner = heap;
+    slab->mapped = mapped;
+
+    return (void *)((uintptr_t)slab + offset);
+  }
+
+  static void deallocate_large(Heap *heap, Slab *slab) {
+    heap->deallocations += 1;
+    heap->mapped -= slab->mapped;
+
+    unmap((uintptr_t)slab, slab->mapped);
+  }
+
+  static void *reallocate_large(Heap *heap, Slab *slab, void *ptr, size_t size, size_t alignment) {
+    const size_t offset = (uintptr_t)ptr - (uintptr_t)slab;
+    const size_t mapped = round_up(offset + size, size_of_pages());
+
+    if (mapped == slab->mapped)
+      return ptr;
+
+  #if YETI_PLATFORM == YETI_PLATFORM_LINUX
+    // Pages keep their offset from a slab boundary, so alignment is kept.
+    YETI_UNUSED(alignment);
+
+    heap->mapped += (i64)mapped - (i64)slab->mapped;
+
+    // Try to resize in place, which always succeeds when shrinking.
+    void *address = ::mremap((void *)slab, slab->mapped, mapped, 0);
+
+    if (address == MAP_FAILED) {
+      // Otherwise move pages rather than copying. We reserve space first so
+      // we land on a slab boundary.
+      const uintptr_t destination = map(mapped);
+
+      address = ::mremap((void *)slab, slab->mapped, mapped, MREMAP_MAYMOVE | MREMAP_FIXED, (void *)destination);
+
+      yeti_assert_with_reason(address != MAP_FAILED, "Out of memory!");
+    }
+
+    slab = (Slab *)address;
+    slab->mapped = mapped;
+
+    return (void *)((uintptr_t)slab + offset);
+  #else
+    if (mapped < slab->mapped) {
+      ::munmap((void *)((uintptr_t)slab + mapped), slab->mapped - mapped);
+      heap->mapped -= slab->mapped - mapped;
+      slab->mapped = mapped;
+      return ptr;
+    }
+
+    void *moved = allocate_large(heap, size, alignment);
+    memory::copy(ptr, moved, slab->mapped - offset);
+    deallocate_large(heap, slab);
+
+    return moved;
+  #endif
+  }
+}
+
+#endif
+
 class GlobalHeapAllocator : public Allocator {
  YETI_DISALLOW_COPYING(GlobalHeapAllocator)
 
@@ -51,6 +585,16 @@ void *GlobalHeapAllocator::allocate(size_t size, size_t alignment) {
   return _aligned_malloc(size, alignment);
 #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
       YETI_PLATFORM == YETI_PLATFORM_LINUX
+  yeti_assert_debug(YETI_IS_POWER_OF_TWO(alignment));
+
+  heap::Heap *heap = heap::heap_for_thread();
+
+  const unsigned size_class = heap::class_for_size(size, alignment);
+
+  if (size_class < heap::NUM_OF_SIZE_CLASSES)
+    return heap::allocate_small(heap, size_class);
+  else
+    return heap::allocate_large(heap, size, alignment);
 #endif
 }
 
@@ -59,6 +603,46 @@ void *GlobalHeapAllocator::reallocate(void *ptr, size_t size, size_t alignment)
   return _aligned_realloc(ptr, size, alignment);
 #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
       YETI_PLATFORM == YETI_PLATFORM_LINUX
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
+
+  if (size == 0) {
+    this->deallocate(ptr);
+    return NULL;
+  }
+
+  heap::Slab *slab = heap::slab_from_pointer(ptr);
+
+  yeti_assert_debug((slab->kind == heap::Slab::SMALL) || (slab->kind == heap::Slab::LARGE));
+
+  const unsigned size_class = heap::class_for_size(size, alignment);
+
+  size_t available;
+
+  if (slab->kind == heap::Slab::SMALL) {
+    // Still fits, and not so small that we're wasting space.
+    if (size_class == slab->size_class)
+      return ptr;
+
+    available = heap::size_of_class(slab->size_class);
+  } else {
+    const size_t offset = (uintptr_t)ptr - (uintptr_t)slab;
+
+    // Large allocations stay large, unless they shrink enough to be small,
+    // so we can resize without copying.
+    if (size_class == heap::NUM_OF_SIZE_CLASSES && ((uintptr_t)ptr & (alignment - 1)) == 0)
+      return heap::reallocate_large(heap::heap_for_thread(), slab, ptr, size, alignment);
+
+    available = slab->mapped - offset;
+  }
+
+  void *moved = this->allocate(size, alignment);
+
+  memory::copy(ptr, moved, (size < available) ? size : available);
+
+  this->deallocate(ptr);
+
+  return moved;
 #endif
 }
 
@@ -67,6 +651,17 @@ void GlobalHeapAllocator::deallocate(void *ptr) {
   _aligned_free(ptr);
 #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
       YETI_PLATFORM == YETI_PLATFORM_LINUX
+  if (ptr == NULL)
+    return;
+
+  heap::Slab *slab = heap::slab_from_pointer(ptr);
+
+  yeti_assert_debug((slab->kind == heap::Slab::SMALL) || (slab->kind == heap::Slab::LARGE));
+
+  if (slab->kind == heap::Slab::SMALL)
+    heap::deallocate_small(heap::heap_for_thread(), slab, ptr);
+  else
+    heap::deallocate_large(heap::heap_for_thread(), slab);
 #endif
 }
 
@@ -80,5 +675,27 @@ Allocator &global_heap_allocator() {
   return global_heap_allocator_;
 }
 
+void heap::statistics(heap::Statistics *statistics) {
+  yeti_assert_debug(statistics != NULL);
+
+  memory::zero((void *)statistics, sizeof(heap::Statistics));
+
+#if YETI_PLATFORM == YETI_PLATFORM_MAC || \
+    YETI_PLATFORM == YETI_PLATFORM_LINUX
+  i64 mapped = 0;
+
+  for (const heap::Heap *heap = heap::heaps_; heap; heap = heap->next) {
+    statistics->allocations += heap->allocations;
+    statistics->deallocations += heap->deallocations;
+    statistics->remote_deallocations += heap->remote_deallocations;
+    statistics->heaps += 1;
+
+    mapped += heap->mapped;
+  }
+
+  statistics->mapped = (mapped > 0) ? (u64)mapped : 0;
+#endif
+}
+
 } // core
 } // yeti
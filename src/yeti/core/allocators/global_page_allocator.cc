@@ -19,6 +19,8 @@
   #include <windows.h>
 #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
       YETI_PLATFORM == YETI_PLATFORM_LINUX
+  #include <unistd.h>
+  #include <sys/mman.h>
 #endif
 
 namespace yeti {
@@ -36,6 +38,12 @@ namespace core {
   static HANDLE global_page_heap_ = INVALID_HANDLE_VALUE;
 #endif
 
+// NOTE(mtwilliams): Elsewhere we map pages directly. Each allocation reserves
+// address space then commits pages as needed, so allocations can grow and
+// shrink in place. The first page of every allocation holds bookkeeping, and
+// memory is handed out from the page after. Since this allocator is meant for
+// large, long-lived allocations the extra page is negligible.
+
 namespace {
   static size_t size_of_pages() {
   #if YETI_PLATFORM == YETI_PLATFORM_WINDOWS
@@ -44,10 +52,86 @@ namespace {
     return system_info.dwPageSize;
   #elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
         YETI_PLATFORM == YETI_PLATFORM_LINUX
+    return (size_t)::sysconf(_SC_PAGESIZE);
+  #endif
+  }
+
+  static size_t round_up_to_multiple(size_t size, size_t multiple) {
+    return ((size + multiple - 1) / multiple) * multiple;
+  }
+}
+
+#if YETI_PLATFORM == YETI_PLATFORM_MAC || \
+    YETI_PLATFORM == YETI_PLATFORM_LINUX
+
+namespace page_allocator {
+  /// \internal Stored in the first page of every allocation.
+  struct Header {
+    /// Bytes of address space reserved, including this page.
+    size_t reserved;
+
+    /// Bytes of address space committed, including this page.
+    size_t committed;
+  };
+
+  /// \internal Allocations at least this large are backed by huge pages,
+  /// if available, to reduce TLB misses when walking them.
+  static const size_t HUGE_PAGE_THRESHOLD = 2 * 1024 * 1024;
+
+  /// \internal Size and alignment of transparent huge pages.
+  static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  static uintptr_t reserve(size_t size, size_t alignment) {
+    // Over reserve so we can trim to the alignment requested.
+    const size_t padded = size + alignment - 1;
+
+    void *address = ::mmap(NULL, padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    yeti_assert_with_reason(address != MAP_FAILED, "Out of address space!");
+
+    const uintptr_t base = (uintptr_t)address;
+    const uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    // Give back what we didn't need.
+    if (aligned > base)
+      ::munmap((void *)base, aligned - base);
+    if (base + padded > aligned + size)
+      ::munmap((void *)(aligned + size), (base + padded) - (aligned + size));
+
+    return aligned;
+  }
+
+  static void commit(uintptr_t address, size_t size) {
+    const int result = ::mprotect((void *)address, size, PROT_READ | PROT_WRITE);
+    yeti_assert_with_reason(result == 0, "Out of memory!");
+  }
+
+  static void decommit(uintptr_t address, size_t size) {
+    // Release physical pages backing range then prevent access, so any use
+    // after shrinking faults rather than silently recommitting.
+    ::madvise((void *)address, size, MADV_DONTNEED);
+    ::mprotect((void *)address, size, PROT_NONE);
+  }
+
+  static void release(uintptr_t address, size_t size) {
+    ::munmap((void *)address, size);
+  }
+
+  static void advise(uintptr_t address, size_t size) {
+  #if defined(MADV_HUGEPAGE)
+    if (size >= HUGE_PAGE_THRESHOLD)
+      // Only a hint; silently ignored if transparent huge pages are disabled.
+      ::madvise((void *)address, size, MADV_HUGEPAGE);
   #endif
   }
+
+  static Header *header_from_pointer(void *ptr, size_t granularity) {
+    return (Header *)((uintptr_t)ptr - granularity);
+  }
 }
 
+#endif
+
 class GlobalPageAllocator : public PageAllocator {
  YETI_DISALLOW_COPYING(GlobalPageAllocator)
 
@@ -59,6 +143,17 @@ class GlobalPageAllocator : public PageAllocator {
   void *allocate(size_t size, size_t alignment = 16);
   void *reallocate(void *ptr, size_t size, size_t alignment = 16);
   void deallocate(void *ptr);
+
+ private:
+#if YETI_PLATFORM == YETI_PLATFORM_MAC || \
+    YETI_PLATFORM == YETI_PLATFORM_LINUX
+  // Reserves enough address space for @reserve bytes, but only commits
+  // enough for @commit bytes.
+  void *map(size_t commit, size_t reserve);
+
+  // Moves an allocation that outgrew its reservation.
+  void *remap(void *ptr, size_t size);
+#endif
 };
 
 GlobalPageAllocator::GlobalPageAllocator()
@@ -80,30 +175,141 @@ void *GlobalPageAllocator::allocate(size_t size, size_t alignment) {
   yeti_assert_debug(YETI_IS_POWER_OF_TWO(alignment));
 
   // Round up to nearest page.
-  size += size % granularity();
+  size = round_up_to_multiple(size, granularity());
 
 #if YETI_PLATFORM == YETI_PLATFORM_WINDOWS
   void *ptr = ::HeapAlloc(global_page_heap_,
                           HEAP_GENERATE_EXCEPTIONS | HEAP_ZERO_MEMORY,
                           size);
+#elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
+      YETI_PLATFORM == YETI_PLATFORM_LINUX
+  void *ptr = this->map(size, size);
 #endif
 
   return ptr;
 }
 
 void *GlobalPageAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
-  // Reallocation not supported.
-  YETI_TRAP();
+  yeti_assert_debug(alignment <= granularity());
+  yeti_assert_debug(YETI_IS_POWER_OF_TWO(alignment));
+
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
 
-  return NULL;
+  if (size == 0) {
+    this->deallocate(ptr);
+    return NULL;
+  }
+
+  // Round up to nearest page.
+  size = round_up_to_multiple(size, granularity());
+
+#if YETI_PLATFORM == YETI_PLATFORM_WINDOWS
+  return ::HeapReAlloc(global_page_heap_,
+                       HEAP_GENERATE_EXCEPTIONS | HEAP_ZERO_MEMORY,
+                       ptr,
+                       size);
+#elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
+      YETI_PLATFORM == YETI_PLATFORM_LINUX
+  page_allocator::Header *header = page_allocator::header_from_pointer(ptr, granularity());
+
+  const uintptr_t base = (uintptr_t)header;
+  const size_t needed = size + granularity();
+
+  if (needed > header->reserved)
+    return this->remap(ptr, size);
+
+  if (needed > header->committed)
+    // Grow in place by committing more of our reservation.
+    page_allocator::commit(base + header->committed, needed - header->committed);
+  else if (needed < header->committed)
+    // Shrink in place, keeping reservation to grow back into.
+    page_allocator::decommit(base + needed, header->committed - needed);
+
+  header->committed = needed;
+
+  return ptr;
+#endif
 }
 
 void GlobalPageAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
 #if YETI_PLATFORM == YETI_PLATFORM_WINDOWS
   ::HeapFree(global_page_heap_, 0, ptr);
+#elif YETI_PLATFORM == YETI_PLATFORM_MAC || \
+      YETI_PLATFORM == YETI_PLATFORM_LINUX
+  page_allocator::Header *header = page_allocator::header_from_pointer(ptr, granularity());
+  page_allocator::release((uintptr_t)header, header->reserved);
 #endif
 }
 
+#if YETI_PLATFORM == YETI_PLATFORM_MAC || \
+    YETI_PLATFORM == YETI_PLATFORM_LINUX
+
+void *GlobalPageAllocator::map(size_t commit, size_t reserve) {
+  yeti_assert_debug(commit <= reserve);
+
+  // Account for bookkeeping.
+  commit += granularity();
+  reserve += granularity();
+
+  // Align large allocations to huge pages so they can be backed by them.
+  const size_t alignment = (reserve >= page_allocator::HUGE_PAGE_THRESHOLD)
+                         ? page_allocator::HUGE_PAGE_SIZE
+                         : granularity();
+
+  const uintptr_t base = page_allocator::reserve(reserve, alignment);
+
+  page_allocator::advise(base, reserve);
+  page_allocator::commit(base, commit);
+
+  page_allocator::Header *header = (page_allocator::Header *)base;
+
+  header->reserved = reserve;
+  header->committed = commit;
+
+  return (void *)(base + granularity());
+}
+
+void *GlobalPageAllocator::remap(void *ptr, size_t size) {
+  page_allocator::Header *header = page_allocator::header_from_pointer(ptr, granularity());
+
+  const size_t needed = size + granularity();
+
+#if YETI_PLATFORM == YETI_PLATFORM_LINUX
+  // Commit the remainder of our reservation so it's a single mapping, which
+  // lets the kernel move pages rather than us copying them.
+  if (header->committed < header->reserved)
+    page_allocator::commit((uintptr_t)header + header->committed,
+                           header->reserved - header->committed);
+
+  void *address = ::mremap((void *)header, header->reserved, needed, MREMAP_MAYMOVE);
+
+  yeti_assert_with_reason(address != MAP_FAILED, "Out of address space!");
+
+  page_allocator::advise((uintptr_t)address, needed);
+
+  header = (page_allocator::Header *)address;
+
+  header->reserved = needed;
+  header->committed = needed;
+
+  return (void *)((uintptr_t)address + granularity());
+#else
+  // No way to move pages, so copy.
+  void *moved = this->map(size, size);
+
+  memory::copy(ptr, moved, header->committed - granularity());
+
+  page_allocator::release((uintptr_t)header, header->reserved);
+
+  return moved;
+#endif
+}
+
+#endif
 
 PageAllocator &global_page_allocator() {
   // HACK(mtwilliams): Force initialization on first call in case static
@@ -0,0 +1,151 @@
+//===-- yeti/core/allocators/pool_allocator.cc ----------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/core/allocators/pool_allocator.h"
+
+// For sanity checks.
+#include "yeti/core/utilities.h"
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+
+namespace pool_allocator {
+  // Blocks double as links when free, and are padded to keep alignment.
+  static size_t size_of_blocks(size_t size, size_t alignment) {
+    size = (size > sizeof(Block)) ? size : sizeof(Block);
+    return ((size + alignment - 1) / alignment) * alignment;
+  }
+}
+
+PoolAllocator::PoolAllocator(Allocator *allocator,
+                             size_t size,
+                             size_t alignment,
+                             size_t size_of_slabs)
+  : Allocator()
+  , backing_(allocator)
+  , size_(pool_allocator::size_of_blocks(size, alignment))
+  , alignment_(alignment)
+  , size_of_slabs_(size_of_slabs)
+{
+  this->initialize();
+}
+
+PoolAllocator::PoolAllocator(Allocator &allocator,
+                             size_t size,
+                             size_t alignment,
+                             size_t size_of_slabs)
+  : Allocator()
+  , backing_(&allocator)
+  , size_(pool_allocator::size_of_blocks(size, alignment))
+  , alignment_(alignment)
+  , size_of_slabs_(size_of_slabs)
+{
+  this->initialize();
+}
+
+PoolAllocator::~PoolAllocator() {
+  yeti_assert_with_reason_development(num_of_allocations_ == 0, "Leaked blocks!");
+
+  while (pool_allocator::Slab *slab = slabs_) {
+    slabs_ = slab->next;
+    backing_->deallocate((void *)slab);
+  }
+}
+
+void PoolAllocator::initialize() {
+  yeti_assert_debug(YETI_IS_POWER_OF_TWO((u64)alignment_));
+
+  slabs_ = NULL;
+  free_ = NULL;
+
+  unused_ = end_ = 0;
+
+  num_of_allocations_ = 0;
+}
+
+void *PoolAllocator::allocate(size_t size, size_t alignment) {
+  yeti_assert_with_reason_debug(size <= size_, "Allocation doesn't fit in a block.");
+  yeti_assert_with_reason_debug(alignment <= alignment_, "Blocks aren't aligned strictly enough.");
+
+  num_of_allocations_ += 1;
+
+  if (pool_allocator::Block *block = free_) {
+    free_ = block->next;
+    return (void *)block;
+  }
+
+  if (unused_ + size_ <= end_) {
+    void *block = (void *)unused_;
+    unused_ += size_;
+    return block;
+  }
+
+  return this->grow();
+}
+
+void *PoolAllocator::grow() {
+  const size_t offset = ((sizeof(pool_allocator::Slab) + alignment_ - 1) / alignment_) * alignment_;
+
+  yeti_assert_with_reason_debug(offset + size_ <= size_of_slabs_, "Slabs are too small to fit a block.");
+
+  pool_allocator::Slab *slab =
+    (pool_allocator::Slab *)backing_->allocate(size_of_slabs_, alignment_);
+
+  slab->next = slabs_;
+  slabs_ = slab;
+
+  const uintptr_t block = (uintptr_t)slab + offset;
+
+  unused_ = block + size_;
+  end_ = block + ((size_of_slabs_ - offset) / size_) * size_;
+
+  return (void *)block;
+}
+
+void *PoolAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
+
+  if (size == 0) {
+    this->deallocate(ptr);
+    return NULL;
+  }
+
+  yeti_assert_with_reason_debug(size <= size_, "Allocation doesn't fit in a block.");
+
+  return ptr;
+}
+
+void PoolAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
+  yeti_assert_debug(num_of_allocations_ > 0);
+
+  pool_allocator::Block *block = (pool_allocator::Block *)ptr;
+
+  block->next = free_;
+  free_ = block;
+
+  num_of_allocations_ -= 1;
+}
+
+size_t PoolAllocator::size_of_blocks() const {
+  return size_;
+}
+
+size_t PoolAllocator::num_of_allocations() const {
+  return num_of_allocations_;
+}
+
+} // core
+} // yeti
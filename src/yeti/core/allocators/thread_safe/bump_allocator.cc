@@ -56,10 +56,10 @@ void *BumpAllocator::allocate(size_t size, size_t alignment) {
   while (true) {
     const uintptr_t unallocated = atomic::load(&unallocated_);
 
-    const size_t padding = unallocated % alignment;
+    const size_t padding = memory::align(unallocated, alignment);
     const size_t length = size + padding;
 
-    if (length >= upper_)
+    if (length > upper_ - unallocated)
       // We don't have enough memory left to fufill the requested allocation.
       return NULL;
 
@@ -79,12 +79,12 @@ void *BumpAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
 }
 
 void BumpAllocator::deallocate(void *ptr) {
-  yeti_assert_debug(((uintptr_t)ptr) > lower_);
+  yeti_assert_debug(((uintptr_t)ptr) >= lower_);
   yeti_assert_debug(((uintptr_t)ptr) < upper_);
 }
 
 void BumpAllocator::reset() {
-  while (atomic::cmp_and_xchg(&unallocated_, unallocated_, lower_) != unallocated_);
+  atomic::store(&unallocated_, lower_);
 }
 
 } // thread_safe
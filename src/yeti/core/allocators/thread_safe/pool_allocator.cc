@@ -0,0 +1,116 @@
+//===-- yeti/core/allocators/thread_safe/pool_allocator.cc ----------------===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/core/allocators/thread_safe/pool_allocator.h"
+
+#include "yeti/core/atomics.h"
+
+// For sanity checks.
+#include "yeti/core/debug/assert.h"
+
+namespace yeti {
+namespace core {
+namespace thread_safe {
+
+PoolAllocator::PoolAllocator(Allocator *allocator,
+                             size_t size,
+                             size_t alignment,
+                             size_t size_of_slabs)
+  : Allocator()
+  , pool_(allocator, size, alignment, size_of_slabs)
+  , lock_(0)
+  , returned_(NULL)
+{
+}
+
+PoolAllocator::PoolAllocator(Allocator &allocator,
+                             size_t size,
+                             size_t alignment,
+                             size_t size_of_slabs)
+  : Allocator()
+  , pool_(allocator, size, alignment, size_of_slabs)
+  , lock_(0)
+  , returned_(NULL)
+{
+}
+
+PoolAllocator::~PoolAllocator() {
+  // So the pool can account for them.
+  this->reclaim();
+}
+
+void PoolAllocator::acquire() {
+  while (atomic::cmp_and_xchg(&lock_, 0, 1) != 0)
+    ;
+}
+
+void PoolAllocator::release() {
+  atomic::barrier();
+  atomic::store(&lock_, (u32)0);
+}
+
+void PoolAllocator::reclaim() {
+  if (!returned_)
+    return;
+
+  void *blocks;
+
+  do {
+    blocks = returned_;
+  } while (atomic::cmp_and_xchg(&returned_, blocks, NULL) != blocks);
+
+  while (pool_allocator::Block *block = (pool_allocator::Block *)blocks) {
+    blocks = (void *)block->next;
+    pool_.deallocate((void *)block);
+  }
+}
+
+void *PoolAllocator::allocate(size_t size, size_t alignment) {
+  this->acquire();
+
+  this->reclaim();
+
+  void *ptr = pool_.allocate(size, alignment);
+
+  this->release();
+
+  return ptr;
+}
+
+void *PoolAllocator::reallocate(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL)
+    return this->allocate(size, alignment);
+
+  if (size == 0) {
+    this->deallocate(ptr);
+    return NULL;
+  }
+
+  yeti_assert_with_reason_debug(size <= pool_.size_of_blocks(), "Allocation doesn't fit in a block.");
+
+  return ptr;
+}
+
+void PoolAllocator::deallocate(void *ptr) {
+  if (ptr == NULL)
+    return;
+
+  void *head;
+
+  do {
+    head = returned_;
+    ((pool_allocator::Block *)ptr)->next = (pool_allocator::Block *)head;
+  } while (atomic::cmp_and_xchg(&returned_, head, ptr) != head);
+}
+
+} // thread_safe
+} // core
+} // yeti
@@ -0,0 +1,95 @@
+//===-- yeti/core/misc/interned_strings.cc --------------*- mode: C++11 -*-===//
+//
+//                 _____               _     _   _
+//                |   __|___ _ _ ___ _| |___| |_|_|___ ___
+//                |   __| . | | |   | . | .'|  _| | . |   |
+//                |__|  |___|___|_|_|___|__,|_| |_|___|_|_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/core/misc/interned_strings.h"
+
+#include "yeti/core/algorithms/hash.h"
+
+#include "yeti/core/allocators/global_heap_allocator.h"
+
+#include "yeti/core/containers/flat_map.h"
+
+#include "yeti/core/platform/lock.h"
+
+// For sanity checks.
+#include "yeti/core/debug/assert.h"
+
+#include <string.h>
+
+namespace yeti {
+namespace core {
+
+#if YETI_CONFIGURATION == YETI_CONFIGURATION_DEBUG || \
+    YETI_CONFIGURATION == YETI_CONFIGURATION_DEVELOPMENT
+
+namespace interned_strings {
+  namespace {
+    // Names can be interned from any thread.
+    static Lock lock_;
+
+    // Hashes are already well distributed, so we don't hash them again.
+    static FlatMap<u32, const char *, map::IdentityHashFunction<u32>::hash> hash_to_string_(global_heap_allocator(), 1024);
+  }
+}
+
+u32 interned_strings::intern(const char *string, size_t length) {
+  yeti_assert_debug(string != NULL);
+
+  const u32 hash = murmur_hash_32((const void *)string, (u32)length);
+
+  YETI_SCOPED_LOCK(lock_);
+
+  if (const char **interned = hash_to_string_.find(hash)) {
+    if ((strncmp(*interned, string, length) != 0) || ((*interned)[length] != '\0'))
+      yeti_assert_with_reason(0, "Hash of '%.*s' collides with '%s'!", (int)length, string, *interned);
+    return hash;
+  }
+
+  // Interned strings live for the lifetime of the process.
+  char *copy = (char *)global_heap_allocator().allocate(length + 1);
+  memcpy((void *)copy, (const void *)string, length);
+  copy[length] = '\0';
+
+  hash_to_string_.insert(hash, (const char *)copy);
+
+  return hash;
+}
+
+const char *interned_strings::lookup(u32 hash) {
+  YETI_SCOPED_LOCK(lock_);
+
+  if (const char **interned = hash_to_string_.find(hash))
+    return *interned;
+
+  return NULL;
+}
+
+#else
+
+u32 interned_strings::intern(const char *string, size_t length) {
+  yeti_assert_debug(string != NULL);
+  return murmur_hash_32((const void *)string, (u32)length);
+}
+
+const char *interned_strings::lookup(u32 hash) {
+  YETI_UNUSED(hash);
+  return NULL;
+}
+
+#endif
+
+u32 interned_strings::intern(const char *string) {
+  yeti_assert_debug(string != NULL);
+  return intern(string, strlen(string));
+}
+
+} // core
+} // yeti
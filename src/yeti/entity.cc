@@ -174,7 +174,8 @@ bool EntityManager::dead(Entity entity) const {
 void EntityManager::name(Entity entity, const char *name) {
   yeti_assert_debug(name != NULL);
 
-  const u32 hash_of_name = core::murmur_hash_32(name);
+  // Remembered so names can be recovered for debugging.
+  const u32 hash_of_name = core::interned_strings::intern(name);
 
   this->name(entity, hash_of_name);
 }
@@ -0,0 +1,421 @@
+//===-- yeti/light_clusters.cc --------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/light_clusters.h"
+
+#include "yeti/task.h"
+#include "yeti/task_scheduler.h"
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Lights are tested four at a time.
+  #include <xmmintrin.h>
+#endif
+
+// PERF(mtwilliams): Cull candidates against rows and columns of tiles prior to
+// testing individual clusters.
+
+namespace yeti {
+
+namespace light_clusters {
+  struct Job {
+    LightClusters *clusters;
+    u32 slice;
+  };
+
+  // View-space bounds of a cluster.
+  struct Bounds {
+    f32 min_x, min_y, min_z;
+    f32 max_x, max_y, max_z;
+
+    // Bounding sphere, for cone tests.
+    f32 x, y, z, radius;
+  };
+
+  // Distances along depth bounding @slice.
+  static void slice_to_depths(const Camera &camera,
+                              const u32 slice,
+                              const u32 depth,
+                              f32 *near,
+                              f32 *far)
+  {
+    const f32 t0 = f32(slice) / f32(depth);
+    const f32 t1 = f32(slice + 1) / f32(depth);
+
+    switch (camera.type) {
+      case Camera::PERSPECTIVE: {
+        // Exponential, so clusters are roughly cubical.
+        const f32 ratio = camera.far / camera.near;
+        *near = camera.near * powf(ratio, t0);
+        *far = camera.near * powf(ratio, t1);
+      } break;
+
+      case Camera::ORTHOGRAPHIC: {
+        const f32 range = camera.far - camera.near;
+        *near = camera.near + range * t0;
+        *far = camera.near + range * t1;
+      } break;
+    }
+  }
+
+  static void cluster_to_bounds(const Camera &camera,
+                                const f32 aspect,
+                                const u32 tile_x,
+                                const u32 tile_y,
+                                const u32 width,
+                                const u32 height,
+                                const f32 near,
+                                const f32 far,
+                                Bounds *bounds)
+  {
+    switch (camera.type) {
+      case Camera::PERSPECTIVE: {
+        const f32 tan_of_horizontal = tanf(degrees_to_radians(camera.perspective.field_of_view) * 0.5f);
+        const f32 tan_of_vertical = tan_of_horizontal / aspect;
+
+        // Slopes of the sides of the tile.
+        const f32 left   = (-1.f + 2.f * f32(tile_x + 0) / f32(width)) * tan_of_horizontal;
+        const f32 right  = (-1.f + 2.f * f32(tile_x + 1) / f32(width)) * tan_of_horizontal;
+        const f32 bottom = (-1.f + 2.f * f32(tile_y + 0) / f32(height)) * tan_of_vertical;
+        const f32 top    = (-1.f + 2.f * f32(tile_y + 1) / f32(height)) * tan_of_vertical;
+
+        bounds->min_x = fminf(left * near, left * far);
+        bounds->max_x = fmaxf(right * near, right * far);
+        bounds->min_y = fminf(bottom * near, bottom * far);
+        bounds->max_y = fmaxf(top * near, top * far);
+      } break;
+
+      case Camera::ORTHOGRAPHIC: {
+        const f32 w = camera.orthographic.right - camera.orthographic.left;
+        const f32 h = camera.orthographic.top - camera.orthographic.bottom;
+
+        bounds->min_x = camera.orthographic.left + w * f32(tile_x + 0) / f32(width);
+        bounds->max_x = camera.orthographic.left + w * f32(tile_x + 1) / f32(width);
+        bounds->min_y = camera.orthographic.bottom + h * f32(tile_y + 0) / f32(height);
+        bounds->max_y = camera.orthographic.bottom + h * f32(tile_y + 1) / f32(height);
+      } break;
+    }
+
+    // Cameras look down negative z.
+    bounds->min_z = -far;
+    bounds->max_z = -near;
+
+    bounds->x = (bounds->min_x + bounds->max_x) * 0.5f;
+    bounds->y = (bounds->min_y + bounds->max_y) * 0.5f;
+    bounds->z = (bounds->min_z + bounds->max_z) * 0.5f;
+
+    const f32 ex = bounds->max_x - bounds->x;
+    const f32 ey = bounds->max_y - bounds->y;
+    const f32 ez = bounds->max_z - bounds->z;
+
+    bounds->radius = sqrtf(ex * ex + ey * ey + ez * ez);
+  }
+}
+
+LightClusters::LightClusters(const Description &desc)
+  : desc_(desc)
+  , aspect_(1.f)
+  , lights_(core::global_heap_allocator())
+  , x_(core::global_heap_allocator())
+  , y_(core::global_heap_allocator())
+  , z_(core::global_heap_allocator())
+  , radii_(core::global_heap_allocator())
+  , axis_x_(core::global_heap_allocator())
+  , axis_y_(core::global_heap_allocator())
+  , axis_z_(core::global_heap_allocator())
+  , cos_of_angles_(core::global_heap_allocator())
+  , sin_of_angles_(core::global_heap_allocator())
+  , candidates_(core::global_heap_allocator())
+  , counts_(core::global_heap_allocator(), num_of_clusters())
+  , assigned_(core::global_heap_allocator(), num_of_clusters() * desc.maximum_lights_per_cluster)
+  , offsets_(core::global_heap_allocator(), num_of_clusters() + 1)
+  , indices_(core::global_heap_allocator())
+{
+  core::memory::zero((void *)&camera_, sizeof(Camera));
+  core::memory::zero((void *)offsets_.raw(), offsets_.size() * sizeof(u32));
+}
+
+LightClusters::~LightClusters() {
+}
+
+LightClusters *LightClusters::create(const Description &desc) {
+  yeti_assert_development(desc.width > 0);
+  yeti_assert_development(desc.height > 0);
+  yeti_assert_development(desc.depth > 0);
+  yeti_assert_development(desc.maximum_lights_per_cluster > 0);
+
+  return YETI_NEW(LightClusters, core::global_heap_allocator())(desc);
+}
+
+void LightClusters::destroy() {
+  YETI_DELETE(LightClusters, core::global_heap_allocator(), this);
+}
+
+void LightClusters::assign(LightSystem *lights,
+                           TransformSystem *transforms,
+                           const Camera &camera,
+                           const Mat4 &pose,
+                           const f32 aspect) {
+  yeti_assert_debug(camera.type == Camera::PERSPECTIVE ||
+                    camera.type == Camera::ORTHOGRAPHIC);
+
+  camera_ = camera;
+  aspect_ = aspect;
+
+  lights_.resize(0);
+  lights->filter(Light::ENABLED, lights_);
+
+  const u32 n = (u32)lights_.size();
+
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  radii_.resize(n);
+  axis_x_.resize(n);
+  axis_y_.resize(n);
+  axis_z_.resize(n);
+  cos_of_angles_.resize(n);
+  sin_of_angles_.resize(n);
+
+  const Mat4 view = pose.inverse_affine();
+
+  // Gather lights into view-space.
+  u32 gathered = 0;
+
+  for (u32 index = 0; index < n; ++index) {
+    const Entity entity = lights_[index];
+
+    if (!transforms->has(entity))
+      // Lights without transforms can't be positioned.
+      continue;
+
+    const Light light = lights->describe(lights->lookup(entity));
+
+    if (light.type != Light::POINT && light.type != Light::SPOT)
+      // Directional lights affect everything, so there's no point binning them.
+      continue;
+
+    const Mat4 world = transforms->get_world_pose(transforms->resolve(transforms->lookup(entity)));
+
+    const Vec3 position = view * translation_from_matrix(world);
+
+    lights_[gathered] = entity;
+
+    x_[gathered] = position.x;
+    y_[gathered] = position.y;
+    z_[gathered] = position.z;
+
+    if (light.type == Light::SPOT) {
+      // Spot lights point down negative z.
+      const Vec3 axis = Vec3(-world(0,2), -world(1,2), -world(2,2));
+
+      const Vec3 axis_in_view_space =
+        Vec3(view(0,0) * axis.x + view(0,1) * axis.y + view(0,2) * axis.z,
+             view(1,0) * axis.x + view(1,1) * axis.y + view(1,2) * axis.z,
+             view(2,0) * axis.x + view(2,1) * axis.y + view(2,2) * axis.z).normalize();
+
+      radii_[gathered] = light.spot.radius;
+
+      axis_x_[gathered] = axis_in_view_space.x;
+      axis_y_[gathered] = axis_in_view_space.y;
+      axis_z_[gathered] = axis_in_view_space.z;
+
+      cos_of_angles_[gathered] = cosf(light.spot.angle);
+      sin_of_angles_[gathered] = sinf(light.spot.angle);
+    } else {
+      radii_[gathered] = light.point.radius;
+
+      axis_x_[gathered] = 0.f;
+      axis_y_[gathered] = 0.f;
+      axis_z_[gathered] = 0.f;
+
+      cos_of_angles_[gathered] = -1.f;
+      sin_of_angles_[gathered] = 0.f;
+    }
+
+    gathered++;
+  }
+
+  lights_.resize(gathered);
+
+  candidates_.resize(desc_.depth * gathered);
+
+  // Bin each slice in parallel.
+  core::Array<light_clusters::Job> jobs(core::global_heap_allocator(), desc_.depth);
+  core::Array<Task::Handle> tasks(core::global_heap_allocator(), desc_.depth);
+
+  for (u32 slice = 0; slice < desc_.depth; ++slice) {
+    jobs[slice].clusters = this;
+    jobs[slice].slice = slice;
+    tasks[slice] = task::describe(&LightClusters::bin_a_slice, (void *)&jobs[slice]);
+  }
+
+  task_scheduler::kick_and_do_work_while_waiting_n(desc_.depth, tasks.raw());
+
+  // Compact into a flat buffer.
+  const u32 clusters = num_of_clusters();
+
+  offsets_[0] = 0;
+
+  for (u32 cluster = 0; cluster < clusters; ++cluster)
+    offsets_[cluster + 1] = offsets_[cluster] + counts_[cluster];
+
+  indices_.resize(offsets_[clusters]);
+
+  for (u32 cluster = 0; cluster < clusters; ++cluster)
+    core::memory::copy((const void *)&assigned_[cluster * desc_.maximum_lights_per_cluster],
+                       (void *)(indices_.raw() + offsets_[cluster]),
+                       counts_[cluster] * sizeof(u32));
+}
+
+void LightClusters::bin_a_slice(void *job) {
+  const light_clusters::Job *j = (const light_clusters::Job *)job;
+  j->clusters->bin(j->slice);
+}
+
+void LightClusters::bin(u32 slice) {
+  const u32 n = (u32)lights_.size();
+  const u32 maximum = desc_.maximum_lights_per_cluster;
+
+  f32 near, far;
+  light_clusters::slice_to_depths(camera_, slice, desc_.depth, &near, &far);
+
+  // Only consider lights that intersect this slice.
+  u32 *candidates = candidates_.raw() + slice * n;
+  u32 m = 0;
+
+  for (u32 light = 0; light < n; ++light)
+    if ((z_[light] - radii_[light] <= -near) && (z_[light] + radii_[light] >= -far))
+      candidates[m++] = light;
+
+  const f32 *x = x_.raw(), *y = y_.raw(), *z = z_.raw(), *r = radii_.raw();
+  const f32 *ax = axis_x_.raw(), *ay = axis_y_.raw(), *az = axis_z_.raw();
+  const f32 *ca = cos_of_angles_.raw(), *sa = sin_of_angles_.raw();
+
+  for (u32 tile_y = 0; tile_y < desc_.height; ++tile_y) {
+    for (u32 tile_x = 0; tile_x < desc_.width; ++tile_x) {
+      const u32 cluster = tile_x + desc_.width * (tile_y + desc_.height * slice);
+
+      light_clusters::Bounds bounds;
+      light_clusters::cluster_to_bounds(camera_, aspect_,
+                                        tile_x, tile_y,
+                                        desc_.width, desc_.height,
+                                        near, far,
+                                        &bounds);
+
+      u32 *assigned = &assigned_[cluster * maximum];
+      u32 count = 0;
+
+    #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+        YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+      const __m128 zero = _mm_setzero_ps();
+
+      const __m128 min_x = _mm_set1_ps(bounds.min_x);
+      const __m128 min_y = _mm_set1_ps(bounds.min_y);
+      const __m128 min_z = _mm_set1_ps(bounds.min_z);
+      const __m128 max_x = _mm_set1_ps(bounds.max_x);
+      const __m128 max_y = _mm_set1_ps(bounds.max_y);
+      const __m128 max_z = _mm_set1_ps(bounds.max_z);
+
+      const __m128 cx = _mm_set1_ps(bounds.x);
+      const __m128 cy = _mm_set1_ps(bounds.y);
+      const __m128 cz = _mm_set1_ps(bounds.z);
+      const __m128 cr = _mm_set1_ps(bounds.radius);
+
+      for (u32 candidate = 0; candidate < m; candidate += 4) {
+        // Pad by repeating the last candidate, then mask out padding.
+        const u32 c0 = candidates[candidate];
+        const u32 c1 = candidates[YETI_MIN(candidate + 1, m - 1)];
+        const u32 c2 = candidates[YETI_MIN(candidate + 2, m - 1)];
+        const u32 c3 = candidates[YETI_MIN(candidate + 3, m - 1)];
+
+        const __m128 lx = _mm_set_ps(x[c3], x[c2], x[c1], x[c0]);
+        const __m128 ly = _mm_set_ps(y[c3], y[c2], y[c1], y[c0]);
+        const __m128 lz = _mm_set_ps(z[c3], z[c2], z[c1], z[c0]);
+        const __m128 lr = _mm_set_ps(r[c3], r[c2], r[c1], r[c0]);
+
+        // Sphere versus box.
+        const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_x, lx), _mm_sub_ps(lx, max_x)), zero);
+        const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_y, ly), _mm_sub_ps(ly, max_y)), zero);
+        const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_z, lz), _mm_sub_ps(lz, max_z)), zero);
+
+        const __m128 distance_squared =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        __m128 hit = _mm_cmple_ps(distance_squared, _mm_mul_ps(lr, lr));
+
+        // Cone versus bounding sphere of cluster.
+        const __m128 lax = _mm_set_ps(ax[c3], ax[c2], ax[c1], ax[c0]);
+        const __m128 lay = _mm_set_ps(ay[c3], ay[c2], ay[c1], ay[c0]);
+        const __m128 laz = _mm_set_ps(az[c3], az[c2], az[c1], az[c0]);
+        const __m128 lca = _mm_set_ps(ca[c3], ca[c2], ca[c1], ca[c0]);
+        const __m128 lsa = _mm_set_ps(sa[c3], sa[c2], sa[c1], sa[c0]);
+
+        const __m128 vx = _mm_sub_ps(cx, lx);
+        const __m128 vy = _mm_sub_ps(cy, ly);
+        const __m128 vz = _mm_sub_ps(cz, lz);
+
+        const __m128 length_squared =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+
+        const __m128 along =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, lax), _mm_mul_ps(vy, lay)), _mm_mul_ps(vz, laz));
+
+        const __m128 closest =
+          _mm_sub_ps(_mm_mul_ps(lca, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(length_squared, _mm_mul_ps(along, along)), zero))),
+                     _mm_mul_ps(along, lsa));
+
+        hit = _mm_and_ps(hit, _mm_cmple_ps(closest, cr));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(along, _mm_add_ps(cr, lr)));
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(along, _mm_sub_ps(zero, cr)));
+
+        u32 mask = (u32)_mm_movemask_ps(hit);
+
+        if (m - candidate < 4)
+          mask &= (1u << (m - candidate)) - 1u;
+
+        if (mask & 1) if (count < maximum) assigned[count++] = c0;
+        if (mask & 2) if (count < maximum) assigned[count++] = c1;
+        if (mask & 4) if (count < maximum) assigned[count++] = c2;
+        if (mask & 8) if (count < maximum) assigned[count++] = c3;
+      }
+    #else
+      for (u32 candidate = 0; candidate < m; ++candidate) {
+        const u32 c = candidates[candidate];
+
+        // Sphere versus box.
+        const f32 dx = fmaxf(fmaxf(bounds.min_x - x[c], x[c] - bounds.max_x), 0.f);
+        const f32 dy = fmaxf(fmaxf(bounds.min_y - y[c], y[c] - bounds.max_y), 0.f);
+        const f32 dz = fmaxf(fmaxf(bounds.min_z - z[c], z[c] - bounds.max_z), 0.f);
+
+        if (dx * dx + dy * dy + dz * dz > r[c] * r[c])
+          continue;
+
+        // Cone versus bounding sphere of cluster.
+        const f32 vx = bounds.x - x[c], vy = bounds.y - y[c], vz = bounds.z - z[c];
+        const f32 length_squared = vx * vx + vy * vy + vz * vz;
+        const f32 along = vx * ax[c] + vy * ay[c] + vz * az[c];
+        const f32 closest = ca[c] * sqrtf(fmaxf(length_squared - along * along, 0.f)) - along * sa[c];
+
+        if (closest > bounds.radius || along > bounds.radius + r[c] || along < -bounds.radius)
+          continue;
+
+        if (count < maximum)
+          assigned[count++] = c;
+      }
+    #endif
+
+      counts_[cluster] = count;
+    }
+  }
+}
+
+} // yeti
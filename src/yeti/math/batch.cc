@@ -0,0 +1,373 @@
+//===-- yeti/math/batch.cc ------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/math/batch.h"
+
+namespace yeti {
+
+namespace batch {
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+
+// Loads four tightly packed vectors, transposing them into three registers,
+// one per component.
+static YETI_INLINE void load_vec3s(const Vec3 *vectors,
+                                   __m128 &x,
+                                   __m128 &y,
+                                   __m128 &z) {
+  // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+  const __m128 a = _mm_loadu_ps(&vectors[0].x);
+  const __m128 b = _mm_loadu_ps(&vectors[0].x + 4);
+  const __m128 c = _mm_loadu_ps(&vectors[0].x + 8);
+
+  x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// Inverse of `load_vec3s`.
+static YETI_INLINE void store_vec3s(Vec3 *vectors,
+                                    const __m128 x,
+                                    const __m128 y,
+                                    const __m128 z) {
+  const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+                                  _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                  _MM_SHUFFLE(2, 0, 2, 0));
+  const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                                  _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                                  _MM_SHUFFLE(2, 0, 2, 0));
+  const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                  _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                                  _MM_SHUFFLE(2, 0, 2, 0));
+
+  _mm_storeu_ps(&vectors[0].x, a);
+  _mm_storeu_ps(&vectors[0].x + 4, b);
+  _mm_storeu_ps(&vectors[0].x + 8, c);
+}
+
+// Loads four quaternions, transposing them into four registers, one per
+// component.
+static YETI_INLINE void load_quaternions(const Quaternion *quaternions,
+                                         __m128 &x,
+                                         __m128 &y,
+                                         __m128 &z,
+                                         __m128 &w) {
+  x = _mm_loadu_ps(&quaternions[0].x);
+  y = _mm_loadu_ps(&quaternions[1].x);
+  z = _mm_loadu_ps(&quaternions[2].x);
+  w = _mm_loadu_ps(&quaternions[3].x);
+
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+// Inverse of `load_quaternions`.
+static YETI_INLINE void store_quaternions(Quaternion *quaternions,
+                                          __m128 x,
+                                          __m128 y,
+                                          __m128 z,
+                                          __m128 w) {
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+
+  _mm_storeu_ps(&quaternions[0].x, x);
+  _mm_storeu_ps(&quaternions[1].x, y);
+  _mm_storeu_ps(&quaternions[2].x, z);
+  _mm_storeu_ps(&quaternions[3].x, w);
+}
+
+// Normalizes four quaternions in place, exactly like `Quaternion::normalize`.
+static YETI_INLINE void normalize(__m128 &x,
+                                  __m128 &y,
+                                  __m128 &z,
+                                  __m128 &w) {
+  __m128 dot = _mm_mul_ps(x, x);
+  dot = _mm_add_ps(dot, _mm_mul_ps(y, y));
+  dot = _mm_add_ps(dot, _mm_mul_ps(z, z));
+  dot = _mm_add_ps(dot, _mm_mul_ps(w, w));
+
+  const __m128 inverse_of_magnitude = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(dot));
+
+  x = _mm_mul_ps(x, inverse_of_magnitude);
+  y = _mm_mul_ps(y, inverse_of_magnitude);
+  z = _mm_mul_ps(z, inverse_of_magnitude);
+  w = _mm_mul_ps(w, inverse_of_magnitude);
+}
+
+// Computes `a * Wa + b * Wb` then normalizes, for four pairs of quaternions.
+static YETI_INLINE void blend(const Quaternion *a,
+                              const Quaternion *b,
+                              const __m128 Wa,
+                              const __m128 Wb,
+                              Quaternion *blended) {
+  __m128 ax, ay, az, aw;
+  __m128 bx, by, bz, bw;
+
+  load_quaternions(a, ax, ay, az, aw);
+  load_quaternions(b, bx, by, bz, bw);
+
+  __m128 x = _mm_add_ps(_mm_mul_ps(ax, Wa), _mm_mul_ps(bx, Wb));
+  __m128 y = _mm_add_ps(_mm_mul_ps(ay, Wa), _mm_mul_ps(by, Wb));
+  __m128 z = _mm_add_ps(_mm_mul_ps(az, Wa), _mm_mul_ps(bz, Wb));
+  __m128 w = _mm_add_ps(_mm_mul_ps(aw, Wa), _mm_mul_ps(bw, Wb));
+
+  normalize(x, y, z, w);
+
+  store_quaternions(blended, x, y, z, w);
+}
+
+#endif
+
+void transform_points(const Mat4 &matrix,
+                      const Vec3 *points,
+                      Vec3 *transformed,
+                      size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  __m128 M[4][4];
+
+  for (unsigned r = 0; r < 4; ++r)
+    for (unsigned c = 0; c < 4; ++c)
+      M[r][c] = _mm_set1_ps(matrix(r, c));
+
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, z;
+    load_vec3s(&points[i], x, y, z);
+
+    __m128 t[4];
+
+    for (unsigned r = 0; r < 4; ++r) {
+      t[r] = _mm_mul_ps(M[r][0], x);
+      t[r] = _mm_add_ps(t[r], _mm_mul_ps(M[r][1], y));
+      t[r] = _mm_add_ps(t[r], _mm_mul_ps(M[r][2], z));
+      t[r] = _mm_add_ps(t[r], M[r][3]);
+    }
+
+    const __m128 w = _mm_div_ps(_mm_set1_ps(1.f), t[3]);
+
+    store_vec3s(&transformed[i],
+                _mm_mul_ps(t[0], w),
+                _mm_mul_ps(t[1], w),
+                _mm_mul_ps(t[2], w));
+  }
+#endif
+
+  for (; i < n; ++i)
+    transformed[i] = matrix * points[i];
+}
+
+void rotate_vectors(const Quaternion *rotations,
+                    const Vec3 *vectors,
+                    Vec3 *rotated,
+                    size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  const __m128 two = _mm_set1_ps(2.f);
+
+  for (; i + 4 <= n; i += 4) {
+    __m128 qx, qy, qz, qw;
+    load_quaternions(&rotations[i], qx, qy, qz, qw);
+
+    __m128 vx, vy, vz;
+    load_vec3s(&vectors[i], vx, vy, vz);
+
+    // Mirrors `Quaternion * Vec3` operation for operation.
+    __m128 uvx = _mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy));
+    __m128 uvy = _mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz));
+    __m128 uvz = _mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx));
+
+    __m128 uuvx = _mm_sub_ps(_mm_mul_ps(qy, uvz), _mm_mul_ps(qz, uvy));
+    __m128 uuvy = _mm_sub_ps(_mm_mul_ps(qz, uvx), _mm_mul_ps(qx, uvz));
+    __m128 uuvz = _mm_sub_ps(_mm_mul_ps(qx, uvy), _mm_mul_ps(qy, uvx));
+
+    uvx = _mm_mul_ps(_mm_mul_ps(uvx, two), qw);
+    uvy = _mm_mul_ps(_mm_mul_ps(uvy, two), qw);
+    uvz = _mm_mul_ps(_mm_mul_ps(uvz, two), qw);
+
+    uuvx = _mm_mul_ps(uuvx, two);
+    uuvy = _mm_mul_ps(uuvy, two);
+    uuvz = _mm_mul_ps(uuvz, two);
+
+    store_vec3s(&rotated[i],
+                _mm_add_ps(_mm_add_ps(vx, uvx), uuvx),
+                _mm_add_ps(_mm_add_ps(vy, uvy), uuvy),
+                _mm_add_ps(_mm_add_ps(vz, uvz), uuvz));
+  }
+#endif
+
+  for (; i < n; ++i)
+    rotated[i] = rotations[i] * vectors[i];
+}
+
+void normalize_quaternions(const Quaternion *quaternions,
+                           Quaternion *normalized,
+                           size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, z, w;
+    load_quaternions(&quaternions[i], x, y, z, w);
+    normalize(x, y, z, w);
+    store_quaternions(&normalized[i], x, y, z, w);
+  }
+#endif
+
+  for (; i < n; ++i)
+    normalized[i] = quaternions[i].normalize();
+}
+
+void nlerp(const Quaternion *a,
+           const Quaternion *b,
+           const f32 t,
+           Quaternion *interpolated,
+           size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  const __m128 Wa = _mm_set1_ps(1.f - t);
+  const __m128 Wb = _mm_set1_ps(t);
+
+  for (; i + 4 <= n; i += 4)
+    blend(&a[i], &b[i], Wa, Wb, &interpolated[i]);
+#endif
+
+  for (; i < n; ++i)
+    interpolated[i] = Quaternion::nlerp(a[i], b[i], t);
+}
+
+void slerp(const Quaternion *a,
+           const Quaternion *b,
+           const f32 t,
+           Quaternion *interpolated,
+           size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  const f32 one_minus_t = 1.f - t;
+
+  for (; i + 4 <= n; i += 4) {
+    // PERF(mtwilliams): Vectorize weights. We'd need our own `acosf` and
+    // `sinf` to remain identical to `Quaternion::slerp` so they're left
+    // scalar for now.
+    YETI_ALIGNED(16) f32 Wa[4];
+    YETI_ALIGNED(16) f32 Wb[4];
+
+    for (unsigned j = 0; j < 4; ++j) {
+      const f32 cos_of_theta = a[i + j].dot(b[i + j]);
+
+      if (cos_of_theta > QUATERNION_SLERP_THRESHOLD) {
+        // Nearly parallel, so fall back to `nlerp` like `Quaternion::slerp`.
+        Wa[j] = one_minus_t;
+        Wb[j] = t;
+      } else {
+        const f32 theta = acosf(cos_of_theta);
+        const f32 sin_of_theta = sinf(theta);
+        const f32 inverse_of_sin_of_theta = 1.f / sin_of_theta;
+
+        Wa[j] = sinf(one_minus_t * theta) * inverse_of_sin_of_theta;
+        Wb[j] = sinf(t * theta) * inverse_of_sin_of_theta;
+      }
+    }
+
+    blend(&a[i], &b[i], _mm_load_ps(Wa), _mm_load_ps(Wb), &interpolated[i]);
+  }
+#endif
+
+  for (; i < n; ++i)
+    interpolated[i] = Quaternion::slerp(a[i], b[i], t);
+}
+
+void compose(const Vec3 *positions,
+             const Quaternion *rotations,
+             const Vec3 *scales,
+             Mat4 *matrices,
+             size_t n) {
+  size_t i = 0;
+
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 two = _mm_set1_ps(2.f);
+
+  const __m128 last = _mm_set_ps(1.f, 0.f, 0.f, 0.f);
+
+  for (; i + 4 <= n; i += 4) {
+    __m128 tx, ty, tz;
+    load_vec3s(&positions[i], tx, ty, tz);
+
+    __m128 x, y, z, w;
+    load_quaternions(&rotations[i], x, y, z, w);
+
+    __m128 sx, sy, sz;
+    load_vec3s(&scales[i], sx, sy, sz);
+
+    // Mirrors `Mat4::compose` operation for operation.
+    const __m128 xx = _mm_mul_ps(two, _mm_mul_ps(x, x));
+    const __m128 yy = _mm_mul_ps(two, _mm_mul_ps(y, y));
+    const __m128 zz = _mm_mul_ps(two, _mm_mul_ps(z, z));
+    const __m128 xy = _mm_mul_ps(two, _mm_mul_ps(x, y));
+    const __m128 xz = _mm_mul_ps(two, _mm_mul_ps(x, z));
+    const __m128 yz = _mm_mul_ps(two, _mm_mul_ps(y, z));
+    const __m128 xw = _mm_mul_ps(two, _mm_mul_ps(x, w));
+    const __m128 yw = _mm_mul_ps(two, _mm_mul_ps(y, w));
+    const __m128 zw = _mm_mul_ps(two, _mm_mul_ps(z, w));
+
+    __m128 r0c0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), sx);
+    __m128 r0c1 = _mm_mul_ps(_mm_sub_ps(xy, zw), sy);
+    __m128 r0c2 = _mm_mul_ps(_mm_add_ps(xz, yw), sz);
+
+    __m128 r1c0 = _mm_mul_ps(_mm_add_ps(xy, zw), sx);
+    __m128 r1c1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), sy);
+    __m128 r1c2 = _mm_mul_ps(_mm_sub_ps(yz, xw), sz);
+
+    __m128 r2c0 = _mm_mul_ps(_mm_sub_ps(xz, yw), sx);
+    __m128 r2c1 = _mm_mul_ps(_mm_add_ps(yz, xw), sy);
+    __m128 r2c2 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), sz);
+
+    // Each register now holds one element from four matrices. Transposing
+    // gives us rows.
+    _MM_TRANSPOSE4_PS(r0c0, r0c1, r0c2, tx);
+    _MM_TRANSPOSE4_PS(r1c0, r1c1, r1c2, ty);
+    _MM_TRANSPOSE4_PS(r2c0, r2c1, r2c2, tz);
+
+    _mm_storeu_ps(&matrices[i + 0](0, 0), r0c0);
+    _mm_storeu_ps(&matrices[i + 0](1, 0), r1c0);
+    _mm_storeu_ps(&matrices[i + 0](2, 0), r2c0);
+    _mm_storeu_ps(&matrices[i + 0](3, 0), last);
+
+    _mm_storeu_ps(&matrices[i + 1](0, 0), r0c1);
+    _mm_storeu_ps(&matrices[i + 1](1, 0), r1c1);
+    _mm_storeu_ps(&matrices[i + 1](2, 0), r2c1);
+    _mm_storeu_ps(&matrices[i + 1](3, 0), last);
+
+    _mm_storeu_ps(&matrices[i + 2](0, 0), r0c2);
+    _mm_storeu_ps(&matrices[i + 2](1, 0), r1c2);
+    _mm_storeu_ps(&matrices[i + 2](2, 0), r2c2);
+    _mm_storeu_ps(&matrices[i + 2](3, 0), last);
+
+    _mm_storeu_ps(&matrices[i + 3](0, 0), tx);
+    _mm_storeu_ps(&matrices[i + 3](1, 0), ty);
+    _mm_storeu_ps(&matrices[i + 3](2, 0), tz);
+    _mm_storeu_ps(&matrices[i + 3](3, 0), last);
+  }
+#endif
+
+  for (; i < n; ++i)
+    matrices[i] = Mat4::compose(positions[i], rotations[i], scales[i]);
+}
+
+} // batch
+
+} // yeti
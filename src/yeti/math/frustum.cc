@@ -0,0 +1,249 @@
+//===-- yeti/math/frustum.cc ----------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/math/frustum.h"
+
+#include "yeti/math/conversions.h"
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Culling is batched four bounding volumes at a time.
+  #include <xmmintrin.h>
+#endif
+
+// PERF(mtwilliams): Use AVX to cull eight bounding volumes at a time.
+// PERF(mtwilliams): Exploit temporal coherence by testing the plane that
+// culled an object last frame first.
+
+namespace yeti {
+
+Frustum Frustum::perspective(const f32 field_of_view,
+                             const f32 aspect,
+                             const f32 near,
+                             const f32 far)
+{
+  yeti_assert_with_reason_debug(field_of_view > 0.f, "Horizontal field-of-view must be greater than 0°!");
+  yeti_assert_with_reason_debug(field_of_view <= 180.f, "Horizontal field-of-view must be no greater than 180°!");
+
+  // Derive vertical field-of-view the same way `Mat4::perspective` does.
+  const f32 horizontal = degrees_to_radians(field_of_view) * 0.5f;
+  const f32 vertical = atanf(tanf(horizontal) / aspect);
+
+  const f32 ch = cosf(horizontal), sh = sinf(horizontal);
+  const f32 cv = cosf(vertical), sv = sinf(vertical);
+
+  Frustum frustum;
+
+  frustum.planes[LEFT_PLANE]   = Plane(Vec3( ch, 0.f, -sh), 0.f);
+  frustum.planes[RIGHT_PLANE]  = Plane(Vec3(-ch, 0.f, -sh), 0.f);
+  frustum.planes[TOP_PLANE]    = Plane(Vec3(0.f, -cv, -sv), 0.f);
+  frustum.planes[BOTTOM_PLANE] = Plane(Vec3(0.f,  cv, -sv), 0.f);
+  frustum.planes[NEAR_PLANE]   = Plane(Vec3(0.f, 0.f, -1.f), -near);
+  frustum.planes[FAR_PLANE]    = Plane(Vec3(0.f, 0.f,  1.f), far);
+
+  return frustum;
+}
+
+Frustum Frustum::orthographic(const f32 top,
+                              const f32 left,
+                              const f32 bottom,
+                              const f32 right,
+                              const f32 near,
+                              const f32 far)
+{
+  Frustum frustum;
+
+  frustum.planes[LEFT_PLANE]   = Plane(Vec3( 1.f, 0.f, 0.f), -left);
+  frustum.planes[RIGHT_PLANE]  = Plane(Vec3(-1.f, 0.f, 0.f), right);
+  frustum.planes[TOP_PLANE]    = Plane(Vec3(0.f, -1.f, 0.f), top);
+  frustum.planes[BOTTOM_PLANE] = Plane(Vec3(0.f,  1.f, 0.f), -bottom);
+  frustum.planes[NEAR_PLANE]   = Plane(Vec3(0.f, 0.f, -1.f), -near);
+  frustum.planes[FAR_PLANE]    = Plane(Vec3(0.f, 0.f,  1.f), far);
+
+  return frustum;
+}
+
+Frustum Frustum::transform(const Mat4 &pose) const {
+  Frustum transformed;
+
+  for (unsigned plane = 0; plane < 6; ++plane) {
+    const Vec3 &n = planes[plane].normal;
+
+    // Transform a point on the plane and its normal, then rederive.
+    const Vec3 point = pose * (n * -planes[plane].distance);
+
+    const Vec3 normal = Vec3(pose(0,0) * n.x + pose(0,1) * n.y + pose(0,2) * n.z,
+                             pose(1,0) * n.x + pose(1,1) * n.y + pose(1,2) * n.z,
+                             pose(2,0) * n.x + pose(2,1) * n.y + pose(2,2) * n.z).normalize();
+
+    transformed.planes[plane] = Plane::from_point_and_normal(point, normal);
+  }
+
+  return transformed;
+}
+
+namespace frustum {
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Planes broadcast across lanes.
+  struct Planes {
+    __m128 x[6];
+    __m128 y[6];
+    __m128 z[6];
+    __m128 d[6];
+  };
+
+  static YETI_INLINE void broadcast(const Frustum &frustum, Planes *planes) {
+    for (unsigned plane = 0; plane < 6; ++plane) {
+      planes->x[plane] = _mm_set1_ps(frustum.planes[plane].normal.x);
+      planes->y[plane] = _mm_set1_ps(frustum.planes[plane].normal.y);
+      planes->z[plane] = _mm_set1_ps(frustum.planes[plane].normal.z);
+      planes->d[plane] = _mm_set1_ps(frustum.planes[plane].distance);
+    }
+  }
+
+  // Appends indices of lanes set in @mask without branching.
+  static YETI_INLINE u32 compact(const u32 mask, const u32 base, u32 *visible) {
+    u32 count = 0;
+
+    visible[count] = base + 0; count += (mask >> 0) & 1;
+    visible[count] = base + 1; count += (mask >> 1) & 1;
+    visible[count] = base + 2; count += (mask >> 2) & 1;
+    visible[count] = base + 3; count += (mask >> 3) & 1;
+
+    return count;
+  }
+#endif
+
+  u32 cull(const Frustum &frustum,
+           const Spheres &spheres,
+           const u32 n,
+           u32 *visible)
+  {
+    u32 index = 0;
+    u32 count = 0;
+
+  #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+      YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+    Planes planes;
+    broadcast(frustum, &planes);
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; index + 4 <= n; index += 4) {
+      const __m128 x = _mm_loadu_ps(&spheres.x[index]);
+      const __m128 y = _mm_loadu_ps(&spheres.y[index]);
+      const __m128 z = _mm_loadu_ps(&spheres.z[index]);
+      const __m128 r = _mm_loadu_ps(&spheres.radius[index]);
+
+      __m128 inside = _mm_cmpeq_ps(zero, zero);
+
+      for (unsigned plane = 0; plane < 6; ++plane) {
+        const __m128 distance =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.x[plane], x),
+                                _mm_mul_ps(planes.y[plane], y)),
+                     _mm_add_ps(_mm_mul_ps(planes.z[plane], z),
+                                planes.d[plane]));
+
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, r), zero));
+      }
+
+      count += compact((u32)_mm_movemask_ps(inside), index, &visible[count]);
+    }
+  #endif
+
+    for (; index < n; ++index) {
+      const Sphere sphere(Vec3(spheres.x[index], spheres.y[index], spheres.z[index]),
+                          spheres.radius[index]);
+
+      if (frustum.test(sphere))
+        visible[count++] = index;
+    }
+
+    return count;
+  }
+
+  u32 cull(const Frustum &frustum,
+           const Boxes &boxes,
+           const u32 n,
+           u32 *visible)
+  {
+    u32 index = 0;
+    u32 count = 0;
+
+  #if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+      YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+    Planes planes;
+    broadcast(frustum, &planes);
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign = _mm_set1_ps(-0.f);
+
+    // Absolute normals are used to project extents.
+    __m128 ax[6], ay[6], az[6];
+
+    for (unsigned plane = 0; plane < 6; ++plane) {
+      ax[plane] = _mm_andnot_ps(sign, planes.x[plane]);
+      ay[plane] = _mm_andnot_ps(sign, planes.y[plane]);
+      az[plane] = _mm_andnot_ps(sign, planes.z[plane]);
+    }
+
+    for (; index + 4 <= n; index += 4) {
+      const __m128 min_x = _mm_loadu_ps(&boxes.min_x[index]);
+      const __m128 min_y = _mm_loadu_ps(&boxes.min_y[index]);
+      const __m128 min_z = _mm_loadu_ps(&boxes.min_z[index]);
+      const __m128 max_x = _mm_loadu_ps(&boxes.max_x[index]);
+      const __m128 max_y = _mm_loadu_ps(&boxes.max_y[index]);
+      const __m128 max_z = _mm_loadu_ps(&boxes.max_z[index]);
+
+      const __m128 cx = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+      const __m128 cy = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+      const __m128 cz = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+
+      const __m128 ex = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+      const __m128 ey = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+      const __m128 ez = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+      __m128 inside = _mm_cmpeq_ps(zero, zero);
+
+      for (unsigned plane = 0; plane < 6; ++plane) {
+        const __m128 distance =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.x[plane], cx),
+                                _mm_mul_ps(planes.y[plane], cy)),
+                     _mm_add_ps(_mm_mul_ps(planes.z[plane], cz),
+                                planes.d[plane]));
+
+        const __m128 radius =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[plane], ex),
+                                _mm_mul_ps(ay[plane], ey)),
+                     _mm_mul_ps(az[plane], ez));
+
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+      }
+
+      count += compact((u32)_mm_movemask_ps(inside), index, &visible[count]);
+    }
+  #endif
+
+    for (; index < n; ++index) {
+      const AABB box(Vec3(boxes.min_x[index], boxes.min_y[index], boxes.min_z[index]),
+                     Vec3(boxes.max_x[index], boxes.max_y[index], boxes.max_z[index]));
+
+      if (frustum.test(box))
+        visible[count++] = index;
+    }
+
+    return count;
+  }
+}
+
+} // yeti
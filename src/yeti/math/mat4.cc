@@ -156,6 +156,40 @@ Mat4 Mat4::compose(const Vec3 &translation,
   return matrix;
 }
 
+namespace mat4 {
+  // Extracts rotation from the upper 3x3 of @m after dividing each column by
+  // the corresponding component of @scale. Since the result is orthonormal,
+  // the determinant is one, which saves us a `powf`.
+  static Quaternion rotation_from_unscaled(const Mat4 &m, const Vec3 &scale) {
+    const f32 inverse_of_scale_x = 1.f / scale.x;
+    const f32 inverse_of_scale_y = 1.f / scale.y;
+    const f32 inverse_of_scale_z = 1.f / scale.z;
+
+    const f32 m00 = m(0,0) * inverse_of_scale_x,
+              m01 = m(0,1) * inverse_of_scale_y,
+              m02 = m(0,2) * inverse_of_scale_z;
+    const f32 m10 = m(1,0) * inverse_of_scale_x,
+              m11 = m(1,1) * inverse_of_scale_y,
+              m12 = m(1,2) * inverse_of_scale_z;
+    const f32 m20 = m(2,0) * inverse_of_scale_x,
+              m21 = m(2,1) * inverse_of_scale_y,
+              m22 = m(2,2) * inverse_of_scale_z;
+
+    Quaternion rotation;
+
+    rotation.w = sqrtf(fmaxf(0.f, 1.f + m00 + m11 + m22)) * 0.5f;
+    rotation.x = sqrtf(fmaxf(0.f, 1.f + m00 - m11 - m22)) * 0.5f;
+    rotation.y = sqrtf(fmaxf(0.f, 1.f - m00 + m11 - m22)) * 0.5f;
+    rotation.z = sqrtf(fmaxf(0.f, 1.f - m00 - m11 + m22)) * 0.5f;
+
+    rotation.x = copysignf(rotation.x, m21 - m12);
+    rotation.y = copysignf(rotation.y, m02 - m20);
+    rotation.z = copysignf(rotation.z, m10 - m01);
+
+    return rotation.normalize();
+  }
+}
+
 void Mat4::decompose(const Mat4 &matrix,
                      Vec3 *translation,
                      Quaternion *rotation,
@@ -169,6 +203,21 @@ void Mat4::decompose(const Mat4 &matrix,
   *rotation = rotation_from_matrix(matrix);
 }
 
+void Mat4::decompose_affine(const Mat4 &matrix,
+                            Vec3 *translation,
+                            Quaternion *rotation,
+                            Vec3 *scale) {
+  yeti_assert_debug(translation != NULL);
+  yeti_assert_debug(rotation != NULL);
+  yeti_assert_debug(scale != NULL);
+
+  yeti_assert_debug(matrix.is_affine());
+
+  *translation = translation_from_matrix(matrix);
+  *scale = scale_from_matrix(matrix);
+  *rotation = mat4::rotation_from_unscaled(matrix, *scale);
+}
+
 #define MINOR(r0, r1, r2, c0, c1, c2) \
   (M[r0][c0] * (M[r1][c1] * M[r2][c2] - M[r2][c1] * M[r1][c2]) - \
    M[r0][c1] * (M[r1][c0] * M[r2][c2] - M[r2][c0] * M[r1][c2]) + \
@@ -181,7 +230,96 @@ f32 Mat4::determinant() const {
          M[0][3] * MINOR(1, 2, 3, 0, 1, 2);
 }
 
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+namespace mat4 {
+  // Computes six 2x2 determinants from rows @p and @q, returned as
+  // `(v0, v1, v2, v3)` in @lo and `(v4, v5, _, _)` in @hi.
+  static YETI_INLINE void minors(const __m128 p,
+                                 const __m128 q,
+                                 __m128 *lo,
+                                 __m128 *hi) {
+    *lo = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 0, 0)),
+                                _mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 3, 2, 1))),
+                     _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 2, 1)),
+                                _mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 0, 0))));
+
+    *hi = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 1)),
+                                _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3))),
+                     _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)),
+                                _mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 2, 2, 1))));
+  }
+
+  // Combines minors with @row into a column of cofactors, sans sign.
+  static YETI_INLINE __m128 cofactors(const __m128 lo,
+                                      const __m128 hi,
+                                      const __m128 row) {
+    // (v5, v5, v4, v3)
+    const __m128 t = _mm_shuffle_ps(hi, lo, _MM_SHUFFLE(3, 3, 0, 1));
+    const __m128 a = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 1, 0, 0));
+
+    // (v4, v2, v2, v1)
+    const __m128 u = _mm_shuffle_ps(hi, lo, _MM_SHUFFLE(2, 1, 0, 0));
+    const __m128 b = _mm_shuffle_ps(u, u, _MM_SHUFFLE(2, 3, 3, 0));
+
+    // (v3, v1, v0, v0)
+    const __m128 c = _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(0, 0, 1, 3));
+
+    return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 1))),
+                                 _mm_mul_ps(b, _mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 2, 2)))),
+                      _mm_mul_ps(c, _mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 3, 3, 3))));
+  }
+}
+#endif
+
 Mat4 Mat4::inverse() const {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  // Vectorized form of the below, computing a column of the inverse at a
+  // time. Operations are performed in exactly the same order.
+  const __m128 r0 = _mm_loadu_ps(M[0]);
+  const __m128 r1 = _mm_loadu_ps(M[1]);
+  const __m128 r2 = _mm_loadu_ps(M[2]);
+  const __m128 r3 = _mm_loadu_ps(M[3]);
+
+  const __m128 odd = _mm_set_ps(-0.f, 0.f, -0.f, 0.f);
+  const __m128 even = _mm_set_ps(0.f, -0.f, 0.f, -0.f);
+
+  __m128 lo, hi;
+
+  mat4::minors(r2, r3, &lo, &hi);
+
+  __m128 c0 = _mm_xor_ps(mat4::cofactors(lo, hi, r1), odd);
+  __m128 c1 = _mm_xor_ps(mat4::cofactors(lo, hi, r0), even);
+
+  mat4::minors(r1, r3, &lo, &hi);
+
+  __m128 c2 = _mm_xor_ps(mat4::cofactors(lo, hi, r0), odd);
+
+  mat4::minors(r1, r2, &lo, &hi);
+
+  __m128 c3 = _mm_xor_ps(mat4::cofactors(lo, hi, r0), even);
+
+  f32 products[4];
+  _mm_storeu_ps(products, _mm_mul_ps(c0, r0));
+
+  const __m128 inverse_of_determinant =
+    _mm_set1_ps(1.f / (products[0] + products[1] + products[2] + products[3]));
+
+  c0 = _mm_mul_ps(c0, inverse_of_determinant);
+  c1 = _mm_mul_ps(c1, inverse_of_determinant);
+  c2 = _mm_mul_ps(c2, inverse_of_determinant);
+  c3 = _mm_mul_ps(c3, inverse_of_determinant);
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+  Mat4 inverse;
+
+  _mm_storeu_ps(inverse.M[0], c0);
+  _mm_storeu_ps(inverse.M[1], c1);
+  _mm_storeu_ps(inverse.M[2], c2);
+  _mm_storeu_ps(inverse.M[3], c3);
+
+  return inverse;
+#else
   const f32 m00 = M[0][0], m01 = M[0][1], m02 = M[0][2], m03 = M[0][3];
   const f32 m10 = M[1][0], m11 = M[1][1], m12 = M[1][2], m13 = M[1][3];
   const f32 m20 = M[2][0], m21 = M[2][1], m22 = M[2][2], m23 = M[2][3];
@@ -239,13 +377,81 @@ Mat4 Mat4::inverse() const {
               d10, d11, d12, d13,
               d20, d21, d22, d23,
               d30, d31, d32, d33);
+#endif
+}
+
+Mat4 Mat4::inverse_affine() const {
+  yeti_assert_debug(this->is_affine());
+
+  const f32 m00 = M[0][0], m01 = M[0][1], m02 = M[0][2];
+  const f32 m10 = M[1][0], m11 = M[1][1], m12 = M[1][2];
+  const f32 m20 = M[2][0], m21 = M[2][1], m22 = M[2][2];
+
+  // Cofactors of the upper 3x3, transposed.
+  const f32 c00 = m11 * m22 - m12 * m21;
+  const f32 c01 = m02 * m21 - m01 * m22;
+  const f32 c02 = m01 * m12 - m02 * m11;
+  const f32 c10 = m12 * m20 - m10 * m22;
+  const f32 c11 = m00 * m22 - m02 * m20;
+  const f32 c12 = m02 * m10 - m00 * m12;
+  const f32 c20 = m10 * m21 - m11 * m20;
+  const f32 c21 = m01 * m20 - m00 * m21;
+  const f32 c22 = m00 * m11 - m01 * m10;
+
+  const f32 inverse_of_determinant = 1.f / (m00 * c00 + m01 * c10 + m02 * c20);
+
+  const f32 d00 = c00 * inverse_of_determinant;
+  const f32 d01 = c01 * inverse_of_determinant;
+  const f32 d02 = c02 * inverse_of_determinant;
+  const f32 d10 = c10 * inverse_of_determinant;
+  const f32 d11 = c11 * inverse_of_determinant;
+  const f32 d12 = c12 * inverse_of_determinant;
+  const f32 d20 = c20 * inverse_of_determinant;
+  const f32 d21 = c21 * inverse_of_determinant;
+  const f32 d22 = c22 * inverse_of_determinant;
+
+  const f32 tx = M[0][3], ty = M[1][3], tz = M[2][3];
+
+  return Mat4(d00, d01, d02, -(d00 * tx + d01 * ty + d02 * tz),
+              d10, d11, d12, -(d10 * tx + d11 * ty + d12 * tz),
+              d20, d21, d22, -(d20 * tx + d21 * ty + d22 * tz),
+              0.f, 0.f, 0.f, 1.f);
+}
+
+Mat4 Mat4::inverse_rigid() const {
+  yeti_assert_debug(this->is_affine());
+
+  const f32 tx = M[0][3], ty = M[1][3], tz = M[2][3];
+
+  return Mat4(M[0][0], M[1][0], M[2][0], -(M[0][0] * tx + M[1][0] * ty + M[2][0] * tz),
+              M[0][1], M[1][1], M[2][1], -(M[0][1] * tx + M[1][1] * ty + M[2][1] * tz),
+              M[0][2], M[1][2], M[2][2], -(M[0][2] * tx + M[1][2] * ty + M[2][2] * tz),
+              0.f, 0.f, 0.f, 1.f);
 }
 
 Mat4 Mat4::transpose() const {
+#if YETI_MATH_BACKEND == YETI_MATH_BACKEND_SSE
+  __m128 r0 = _mm_loadu_ps(M[0]);
+  __m128 r1 = _mm_loadu_ps(M[1]);
+  __m128 r2 = _mm_loadu_ps(M[2]);
+  __m128 r3 = _mm_loadu_ps(M[3]);
+
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+  Mat4 transposed;
+
+  _mm_storeu_ps(transposed.M[0], r0);
+  _mm_storeu_ps(transposed.M[1], r1);
+  _mm_storeu_ps(transposed.M[2], r2);
+  _mm_storeu_ps(transposed.M[3], r3);
+
+  return transposed;
+#else
   return Mat4(M[0][0], M[1][0], M[2][0], M[3][0],
               M[0][1], M[1][1], M[2][1], M[3][1],
               M[0][2], M[1][2], M[2][2], M[3][2],
               M[0][3], M[1][3], M[2][3], M[3][3]);
+#endif
 }
 
 Vec3 translation_from_matrix(const Mat4 &m) {
@@ -291,4 +497,9 @@ Quaternion rotation_from_matrix(const Mat4 &m) {
   return rotation.normalize();
 }
 
+Quaternion rotation_from_affine_matrix(const Mat4 &m) {
+  yeti_assert_debug(m.is_affine());
+  return mat4::rotation_from_unscaled(m, scale_from_matrix(m));
+}
+
 } // yeti
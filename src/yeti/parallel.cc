@@ -0,0 +1,224 @@
+//===-- yeti/parallel.cc --------------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/parallel.h"
+
+#include "yeti/task.h"
+#include "yeti/task_scheduler.h"
+
+namespace yeti {
+
+namespace parallel {
+  namespace radix {
+    // Splitting any finer costs more in scheduling than it saves.
+    static const size_t MINIMUM_KEYS_PER_CHUNK = 16384;
+
+    static const unsigned MAXIMUM_NUM_OF_CHUNKS = 64;
+
+    static const unsigned RADIX = core::radix::RADIX;
+
+    template <typename K>
+    struct Sort {
+      const K *from_keys;
+      const u32 *from_values;
+
+      K *to_keys;
+      u32 *to_values;
+
+      size_t n;
+      unsigned chunks;
+
+      // Digit being sorted by.
+      unsigned pass;
+
+      // Occurrences of every digit in each chunk. Only counts for the pass
+      // being sorted by are kept up to date once keys start moving.
+      u32 (*counts)[sizeof(K)][RADIX];
+
+      // Where each chunk scatters each digit to.
+      u32 (*offsets)[RADIX];
+    };
+
+    template <typename K>
+    struct Job {
+      Sort<K> *sort;
+      unsigned chunk;
+
+      size_t first() const { return (sort->n * chunk) / sort->chunks; }
+      size_t last() const { return (sort->n * (chunk + 1)) / sort->chunks; }
+    };
+
+    template <typename K>
+    static void count_every_pass(void *job) {
+      const Job<K> *j = (const Job<K> *)job;
+      const Sort<K> *s = j->sort;
+
+      u32 (*counts)[RADIX] = s->counts[j->chunk];
+
+      core::memory::zero((void *)counts, sizeof(K) * RADIX * sizeof(u32));
+      core::radix::count(s->from_keys + j->first(), j->last() - j->first(), counts);
+    }
+
+    template <typename K>
+    static void count_a_pass(void *job) {
+      const Job<K> *j = (const Job<K> *)job;
+      const Sort<K> *s = j->sort;
+
+      u32 *counts = s->counts[j->chunk][s->pass];
+
+      core::memory::zero((void *)counts, RADIX * sizeof(u32));
+      core::radix::count(s->from_keys + j->first(), j->last() - j->first(), s->pass, counts);
+    }
+
+    template <typename K, bool Values>
+    static void scatter(void *job) {
+      const Job<K> *j = (const Job<K> *)job;
+      const Sort<K> *s = j->sort;
+
+      const size_t first = j->first();
+
+      core::radix::scatter<K, Values>(s->from_keys + first,
+                                      Values ? s->from_values + first : NULL,
+                                      s->to_keys,
+                                      s->to_values,
+                                      j->last() - first,
+                                      s->pass,
+                                      s->offsets[j->chunk]);
+    }
+
+    // Runs @kernel over every chunk, helping out until all are done.
+    template <typename K>
+    static void run(Task::Kernel kernel, Job<K> *jobs, unsigned chunks) {
+      Task::Handle tasks[MAXIMUM_NUM_OF_CHUNKS];
+
+      for (unsigned chunk = 0; chunk < chunks; ++chunk)
+        tasks[chunk] = task::describe(kernel, (void *)&jobs[chunk]);
+
+      task_scheduler::kick_and_do_work_while_waiting_n(chunks, tasks);
+    }
+
+    template <typename K, bool Values>
+    static void sort(K *keys,
+                     u32 *values,
+                     K *keys_scratch,
+                     u32 *values_scratch,
+                     size_t n) {
+      yeti_assert_debug(n <= 0xFFFFFFFFull);
+
+      const unsigned chunks = (unsigned)core::utility::min<size_t>(n / MINIMUM_KEYS_PER_CHUNK, MAXIMUM_NUM_OF_CHUNKS);
+
+      if (chunks <= 1) {
+        core::radix_sort(keys, values, keys_scratch, values_scratch, n);
+        return;
+      }
+
+      core::Allocator &allocator = core::global_heap_allocator();
+
+      Sort<K> s;
+
+      s.from_keys = keys;
+      s.from_values = values;
+      s.to_keys = keys_scratch;
+      s.to_values = values_scratch;
+      s.n = n;
+      s.chunks = chunks;
+      s.pass = 0;
+
+      s.counts = (u32 (*)[sizeof(K)][RADIX])allocator.allocate(chunks * sizeof(*s.counts));
+      s.offsets = (u32 (*)[RADIX])allocator.allocate(chunks * sizeof(*s.offsets));
+
+      Job<K> jobs[MAXIMUM_NUM_OF_CHUNKS];
+
+      for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+        jobs[chunk].sort = &s;
+        jobs[chunk].chunk = chunk;
+      }
+
+      run(&count_every_pass<K>, jobs, chunks);
+
+      // Totals don't change as keys are reordered, so passes that wouldn't
+      // change order can be determined upfront.
+      u32 totals[sizeof(K)][RADIX];
+      core::memory::zero((void *)totals, sizeof(totals));
+
+      for (unsigned chunk = 0; chunk < chunks; ++chunk)
+        for (unsigned pass = 0; pass < sizeof(K); ++pass)
+          for (unsigned d = 0; d < RADIX; ++d)
+            totals[pass][d] += s.counts[chunk][pass][d];
+
+      // Counts are only accurate for the first pass we sort by.
+      bool moved = false;
+
+      for (unsigned pass = 0; pass < sizeof(K); ++pass) {
+        if (core::radix::trivial(totals[pass], n))
+          continue;
+
+        s.pass = pass;
+
+        if (moved)
+          run(&count_a_pass<K>, jobs, chunks);
+
+        // Each chunk scatters a digit after all chunks before it have.
+        for (unsigned d = 0, offset = 0; d < RADIX; ++d) {
+          for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+            s.offsets[chunk][d] = offset;
+            offset += s.counts[chunk][pass][d];
+          }
+        }
+
+        run(&scatter<K, Values>, jobs, chunks);
+
+        moved = true;
+
+        K *swap_keys = (K *)s.from_keys;
+        s.from_keys = s.to_keys;
+        s.to_keys = swap_keys;
+
+        u32 *swap_values = (u32 *)s.from_values;
+        s.from_values = s.to_values;
+        s.to_values = swap_values;
+      }
+
+      if (s.from_keys != keys) {
+        // Ended up in scratch after an odd number of passes.
+        core::memory::copy((const void *)s.from_keys, (void *)keys, n * sizeof(K));
+
+        if (Values)
+          core::memory::copy((const void *)s.from_values, (void *)values, n * sizeof(u32));
+      }
+
+      allocator.deallocate((void *)s.counts);
+      allocator.deallocate((void *)s.offsets);
+    }
+  }
+}
+
+void parallel::radix_sort(u32 *keys, u32 *values, u32 *keys_scratch, u32 *values_scratch, size_t n) {
+  yeti_assert_debug(!n || (keys != NULL && keys_scratch != NULL));
+  yeti_assert_debug((values == NULL) == (values_scratch == NULL));
+
+  if (values)
+    radix::sort<u32, true>(keys, values, keys_scratch, values_scratch, n);
+  else
+    radix::sort<u32, false>(keys, values, keys_scratch, values_scratch, n);
+}
+
+void parallel::radix_sort(u64 *keys, u32 *values, u64 *keys_scratch, u32 *values_scratch, size_t n) {
+  yeti_assert_debug(!n || (keys != NULL && keys_scratch != NULL));
+  yeti_assert_debug((values == NULL) == (values_scratch == NULL));
+
+  if (values)
+    radix::sort<u64, true>(keys, values, keys_scratch, values_scratch, n);
+  else
+    radix::sort<u64, false>(keys, values, keys_scratch, values_scratch, n);
+}
+
+} // yeti
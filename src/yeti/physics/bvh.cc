@@ -0,0 +1,895 @@
+//===-- yeti/physics/bvh.cc -----------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/physics/bvh.h"
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  #include <xmmintrin.h>
+#endif
+
+#include <float.h>
+
+namespace yeti {
+
+namespace bvh {
+  // Number of bins used to evaluate candidate splits along an axis.
+  static const u32 NUM_OF_BINS = 16;
+
+  // Leaves with more primitives than this are split even if the surface area
+  // heuristic suggests otherwise.
+  static const u32 MAXIMUM_PRIMITIVES_PER_LEAF = 8;
+
+  // Bounds the size of stacks used to build and traverse.
+  static const u32 MAXIMUM_DEPTH = 64;
+
+  // Relative cost of traversing a node compared to testing a primitive.
+  static const f32 TRAVERSAL_COST = 1.f;
+
+  // Rebuild once refitting has increased cost by this factor.
+  static const f32 REBUILD_THRESHOLD = 1.5f;
+
+  static const u32 NONE = 0xFFFFFFFFul;
+
+  typedef BoundingVolumeHierarchy::Node Node;
+
+  static YETI_INLINE AABB empty() {
+    return AABB(Vec3( FLT_MAX,  FLT_MAX,  FLT_MAX),
+                Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+  }
+
+  static YETI_INLINE AABB bounds_of_a_node(const Node &node) {
+    return AABB(Vec3(node.min[0], node.min[1], node.min[2]),
+                Vec3(node.max[0], node.max[1], node.max[2]));
+  }
+
+  static YETI_INLINE void set_bounds_of_a_node(Node &node, const AABB &bounds) {
+    node.min[0] = bounds.min.x; node.min[1] = bounds.min.y; node.min[2] = bounds.min.z;
+    node.max[0] = bounds.max.x; node.max[1] = bounds.max.y; node.max[2] = bounds.max.z;
+  }
+
+  static YETI_INLINE bool dead(const Entity entity) {
+    return (entity.id == 0xFFFFFFFFul);
+  }
+
+  struct Bin {
+    AABB bounds;
+    u32 count;
+  };
+
+  // Maps centroids to bins along an axis.
+  struct Binner {
+    u32 axis;
+    f32 origin;
+    f32 scale;
+
+    YETI_INLINE u32 operator()(const AABB &bounds) const {
+      const f32 centroid = ((&bounds.min.x)[axis] + (&bounds.max.x)[axis]) * 0.5f;
+      const u32 bin = (u32)((centroid - origin) * scale);
+      return (bin < NUM_OF_BINS) ? bin : (NUM_OF_BINS - 1);
+    }
+  };
+
+  // Queries are traversed in packets of four, laid out so each attribute can
+  // be loaded straight into a register.
+
+  struct Rays {
+    f32 ox[4], oy[4], oz[4];
+
+    // Reciprocal of direction.
+    f32 ix[4], iy[4], iz[4];
+
+    // Distance to closest intersection so far. Negative for unused lanes so
+    // they never intersect anything.
+    f32 t[4];
+  };
+
+  struct Spheres {
+    f32 x[4], y[4], z[4];
+
+    // Square of radius. Negative for unused lanes.
+    f32 r2[4];
+  };
+
+  struct Boxes {
+    // Inverted for unused lanes.
+    f32 min_x[4], min_y[4], min_z[4];
+    f32 max_x[4], max_y[4], max_z[4];
+  };
+
+  // Avoids infinities, and thus NaNs, when a ray runs parallel to a slab.
+  static YETI_INLINE f32 reciprocal(const f32 d) {
+    static const f32 EPSILON = 1e-20f;
+    if (d >= 0.f)
+      return 1.f / (d > EPSILON ? d : EPSILON);
+    else
+      return 1.f / (d < -EPSILON ? d : -EPSILON);
+  }
+
+#if YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86 || \
+    YETI_ARCHITECTURE == YETI_ARCHITECTURE_X86_64
+  // Slab test. Returns a mask of the rays that intersect and stores the
+  // distance of entry in |distances|.
+  static YETI_INLINE u32 test(const Rays &rays,
+                              const f32 *min,
+                              const f32 *max,
+                              f32 *distances) {
+    const __m128 ox = _mm_loadu_ps(rays.ox);
+    const __m128 oy = _mm_loadu_ps(rays.oy);
+    const __m128 oz = _mm_loadu_ps(rays.oz);
+
+    const __m128 ix = _mm_loadu_ps(rays.ix);
+    const __m128 iy = _mm_loadu_ps(rays.iy);
+    const __m128 iz = _mm_loadu_ps(rays.iz);
+
+    const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min[0]), ox), ix);
+    const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min[1]), oy), iy);
+    const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min[2]), oz), iz);
+
+    const __m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max[0]), ox), ix);
+    const __m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max[1]), oy), iy);
+    const __m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max[2]), oz), iz);
+
+    const __m128 t_entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x),
+                                               _mm_min_ps(t1y, t2y)),
+                                    _mm_max_ps(_mm_min_ps(t1z, t2z),
+                                               _mm_setzero_ps()));
+
+    const __m128 t_exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x),
+                                              _mm_max_ps(t1y, t2y)),
+                                   _mm_min_ps(_mm_max_ps(t1z, t2z),
+                                              _mm_loadu_ps(rays.t)));
+
+    _mm_storeu_ps(distances, t_entry);
+
+    return (u32)_mm_movemask_ps(_mm_cmple_ps(t_entry, t_exit));
+  }
+
+  static YETI_INLINE u32 test(const Spheres &spheres,
+                              const f32 *min,
+                              const f32 *max) {
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 x = _mm_loadu_ps(spheres.x);
+    const __m128 y = _mm_loadu_ps(spheres.y);
+    const __m128 z = _mm_loadu_ps(spheres.z);
+
+    // Distance from center to closest point on box along each axis.
+    const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min[0]), x),
+                                            _mm_sub_ps(x, _mm_set1_ps(max[0]))), zero);
+    const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min[1]), y),
+                                            _mm_sub_ps(y, _mm_set1_ps(max[1]))), zero);
+    const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(min[2]), z),
+                                            _mm_sub_ps(z, _mm_set1_ps(max[2]))), zero);
+
+    const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+                                            _mm_mul_ps(dy, dy)),
+                                 _mm_mul_ps(dz, dz));
+
+    return (u32)_mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(spheres.r2)));
+  }
+
+  static YETI_INLINE u32 test(const Boxes &boxes,
+                              const f32 *min,
+                              const f32 *max) {
+    const __m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.min_x), _mm_set1_ps(max[0])),
+                                _mm_cmpge_ps(_mm_loadu_ps(boxes.max_x), _mm_set1_ps(min[0])));
+    const __m128 y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.min_y), _mm_set1_ps(max[1])),
+                                _mm_cmpge_ps(_mm_loadu_ps(boxes.max_y), _mm_set1_ps(min[1])));
+    const __m128 z = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.min_z), _mm_set1_ps(max[2])),
+                                _mm_cmpge_ps(_mm_loadu_ps(boxes.max_z), _mm_set1_ps(min[2])));
+
+    return (u32)_mm_movemask_ps(_mm_and_ps(_mm_and_ps(x, y), z));
+  }
+#else
+  static YETI_INLINE u32 test(const Rays &rays,
+                              const f32 *min,
+                              const f32 *max,
+                              f32 *distances) {
+    u32 mask = 0;
+
+    for (u32 lane = 0; lane < 4; ++lane) {
+      const f32 t1x = (min[0] - rays.ox[lane]) * rays.ix[lane];
+      const f32 t1y = (min[1] - rays.oy[lane]) * rays.iy[lane];
+      const f32 t1z = (min[2] - rays.oz[lane]) * rays.iz[lane];
+
+      const f32 t2x = (max[0] - rays.ox[lane]) * rays.ix[lane];
+      const f32 t2y = (max[1] - rays.oy[lane]) * rays.iy[lane];
+      const f32 t2z = (max[2] - rays.oz[lane]) * rays.iz[lane];
+
+      const f32 t_entry = core::utility::max(core::utility::max(core::utility::min(t1x, t2x), core::utility::min(t1y, t2y)),
+                                  core::utility::max(core::utility::min(t1z, t2z), 0.f));
+      const f32 t_exit = core::utility::min(core::utility::min(core::utility::max(t1x, t2x), core::utility::max(t1y, t2y)),
+                                 core::utility::min(core::utility::max(t1z, t2z), rays.t[lane]));
+
+      distances[lane] = t_entry;
+
+      mask |= (t_entry <= t_exit) << lane;
+    }
+
+    return mask;
+  }
+
+  static YETI_INLINE u32 test(const Spheres &spheres,
+                              const f32 *min,
+                              const f32 *max) {
+    u32 mask = 0;
+
+    for (u32 lane = 0; lane < 4; ++lane) {
+      const f32 dx = core::utility::max(core::utility::max(min[0] - spheres.x[lane], spheres.x[lane] - max[0]), 0.f);
+      const f32 dy = core::utility::max(core::utility::max(min[1] - spheres.y[lane], spheres.y[lane] - max[1]), 0.f);
+      const f32 dz = core::utility::max(core::utility::max(min[2] - spheres.z[lane], spheres.z[lane] - max[2]), 0.f);
+
+      mask |= ((dx * dx + dy * dy + dz * dz) <= spheres.r2[lane]) << lane;
+    }
+
+    return mask;
+  }
+
+  static YETI_INLINE u32 test(const Boxes &boxes,
+                              const f32 *min,
+                              const f32 *max) {
+    u32 mask = 0;
+
+    for (u32 lane = 0; lane < 4; ++lane)
+      mask |= ((boxes.min_x[lane] <= max[0]) && (boxes.max_x[lane] >= min[0])
+            && (boxes.min_y[lane] <= max[1]) && (boxes.max_y[lane] >= min[1])
+            && (boxes.min_z[lane] <= max[2]) && (boxes.max_z[lane] >= min[2])) << lane;
+
+    return mask;
+  }
+#endif
+
+  // Nearest entry of rays given by |mask|.
+  static YETI_INLINE f32 nearest(const f32 *distances, const u32 mask) {
+    f32 nearest = FLT_MAX;
+
+    for (u32 lane = 0; lane < 4; ++lane)
+      if (mask & (1 << lane))
+        nearest = core::utility::min(nearest, distances[lane]);
+
+    return nearest;
+  }
+
+  struct Overlap {
+    u32 lane;
+    Entity entity;
+  };
+
+  // Walks the hierarchy collecting entities overlapping each query in
+  // |packet|.
+  template <typename Packet>
+  static void overlap(const Node *nodes,
+                      const u32 *order,
+                      const AABB *bounds,
+                      const Entity *entities,
+                      const Packet &packet,
+                      core::Array<Overlap> &overlapping) {
+    u32 stack[2 * MAXIMUM_DEPTH];
+    u32 top = 0;
+
+    if (test(packet, nodes[0].min, nodes[0].max))
+      stack[top++] = 0;
+
+    while (top) {
+      const Node &node = nodes[stack[--top]];
+
+      if (node.count) {
+        for (u32 index = node.left_or_first; index < node.left_or_first + node.count; ++index) {
+          const u32 primitive = order[index];
+
+          if (dead(entities[primitive]))
+            continue;
+
+          const u32 mask = test(packet, &bounds[primitive].min.x, &bounds[primitive].max.x);
+
+          for (u32 lane = 0; lane < 4; ++lane)
+            if (mask & (1 << lane))
+              overlapping.push({ lane, entities[primitive] });
+        }
+      } else {
+        const u32 left = node.left_or_first;
+        const u32 right = left + 1;
+
+        if (test(packet, nodes[left].min, nodes[left].max))
+          stack[top++] = left;
+        if (test(packet, nodes[right].min, nodes[right].max))
+          stack[top++] = right;
+      }
+    }
+  }
+
+  // Appends entities collected for a packet to |overlaps| in order.
+  static void flush(const core::Array<Overlap> &overlapping,
+                    size_t first,
+                    size_t lanes,
+                    Overlaps *overlaps) {
+    for (u32 lane = 0; lane < lanes; ++lane) {
+      overlaps->offsets[first + lane] = overlaps->entities.size();
+
+      for (const Overlap *overlap = overlapping.begin(); overlap != overlapping.end(); ++overlap)
+        if (overlap->lane == lane)
+          overlaps->entities.push(overlap->entity);
+    }
+
+    overlaps->offsets[first + lanes] = overlaps->entities.size();
+  }
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(EntityManager *entities)
+  : entities_(entities)
+  , callback_(0)
+  , limit_(entities->limit())
+  , entity_to_primitive_(core::global_page_allocator(), limit_)
+  , primitive_to_entity_(core::global_heap_allocator())
+  , local_bounds_(core::global_heap_allocator())
+  , world_bounds_(core::global_heap_allocator())
+  , order_(core::global_heap_allocator())
+  , nodes_(core::global_heap_allocator())
+  , num_of_nodes_(0)
+  , restructured_(false)
+  , moved_(false)
+  , cost_after_build_(0.f)
+{
+  for (unsigned index = 0; index < limit_; ++index)
+    entity_to_primitive_[index] = bvh::NONE;
+
+  callback_ = entities_->register_lifecycle_callback(&lifecycle_callback_shim,
+                                                     (void *)this);
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy() {
+  entities_->unregister_lifecycle_callback(callback_);
+}
+
+BoundingVolumeHierarchy *BoundingVolumeHierarchy::create(EntityManager *entities) {
+  return YETI_NEW(BoundingVolumeHierarchy, core::global_heap_allocator())(entities);
+}
+
+void BoundingVolumeHierarchy::destroy() {
+  YETI_DELETE(BoundingVolumeHierarchy, core::global_heap_allocator(), this);
+}
+
+void BoundingVolumeHierarchy::insert(Entity entity,
+                                     const AABB &bounds,
+                                     const Mat4 &pose) {
+  yeti_assert_debug(!this->has(entity));
+
+  const u32 primitive = primitive_to_entity_.size();
+
+  entity_to_primitive_[entity.index()] = primitive;
+  primitive_to_entity_.push(entity);
+
+  local_bounds_.push(bounds);
+  world_bounds_.push(AABB::transform(bounds, pose));
+
+  // Picked up by the next rebuild.
+  restructured_ = true;
+}
+
+void BoundingVolumeHierarchy::remove(Entity entity) {
+  yeti_assert_debug(this->has(entity));
+
+  const u32 primitive = entity_to_primitive_[entity.index()];
+
+  // Primitives are referenced by leaves, so we can't move them around until
+  // we rebuild. Instead, we mark the primitive dead so it's skipped.
+  primitive_to_entity_[primitive] = Entity();
+  entity_to_primitive_[entity.index()] = bvh::NONE;
+
+  restructured_ = true;
+}
+
+void BoundingVolumeHierarchy::move(Entity entity, const Mat4 &pose) {
+  yeti_assert_debug(this->has(entity));
+
+  const u32 primitive = entity_to_primitive_[entity.index()];
+
+  world_bounds_[primitive] = AABB::transform(local_bounds_[primitive], pose);
+
+  moved_ = true;
+}
+
+void BoundingVolumeHierarchy::update() {
+  if (restructured_) {
+    this->build();
+    return;
+  }
+
+  if (!moved_)
+    return;
+
+  this->refit();
+
+  if (this->cost() > cost_after_build_ * bvh::REBUILD_THRESHOLD)
+    // Quality has degraded enough that it's worth rebuilding.
+    this->build();
+}
+
+void BoundingVolumeHierarchy::build() {
+  // Remove dead primitives by swapping with the last.
+  for (u32 primitive = 0; primitive < primitive_to_entity_.size();) {
+    if (!bvh::dead(primitive_to_entity_[primitive])) {
+      ++primitive;
+      continue;
+    }
+
+    const u32 last = primitive_to_entity_.size() - 1;
+
+    if (primitive != last) {
+      const Entity moved = primitive_to_entity_[last];
+
+      primitive_to_entity_[primitive] = moved;
+      local_bounds_[primitive] = local_bounds_[last];
+      world_bounds_[primitive] = world_bounds_[last];
+
+      if (!bvh::dead(moved))
+        entity_to_primitive_[moved.index()] = primitive;
+    }
+
+    primitive_to_entity_.pop();
+    local_bounds_.pop();
+    world_bounds_.pop();
+  }
+
+  restructured_ = false;
+  moved_ = false;
+
+  num_of_nodes_ = 0;
+  cost_after_build_ = 0.f;
+
+  const u32 n = primitive_to_entity_.size();
+
+  if (n == 0)
+    return;
+
+  order_.resize(n);
+
+  for (u32 primitive = 0; primitive < n; ++primitive)
+    order_[primitive] = primitive;
+
+  // A binary tree with a primitive per leaf has at most this many nodes.
+  if (nodes_.size() < (2 * n - 1))
+    nodes_.resize(2 * n - 1);
+
+  AABB bounds = bvh::empty();
+
+  for (u32 primitive = 0; primitive < n; ++primitive)
+    bounds = AABB::merge(bounds, world_bounds_[primitive]);
+
+  bvh::set_bounds_of_a_node(nodes_[0], bounds);
+  nodes_[0].left_or_first = 0;
+  nodes_[0].count = n;
+
+  num_of_nodes_ = 1;
+
+  struct Work {
+    u32 node;
+    u32 depth;
+  };
+
+  Work stack[2 * bvh::MAXIMUM_DEPTH];
+  u32 top = 0;
+
+  stack[top++] = { 0, 0 };
+
+  while (top) {
+    const Work work = stack[--top];
+
+    if (work.depth >= bvh::MAXIMUM_DEPTH)
+      // Give up on splitting rather than overflow our stacks. Pathological
+      // distributions are the only way to get here.
+      continue;
+
+    if (!this->split(work.node))
+      continue;
+
+    const u32 left = nodes_[work.node].left_or_first;
+
+    stack[top++] = { left + 1, work.depth + 1 };
+    stack[top++] = { left, work.depth + 1 };
+  }
+
+  cost_after_build_ = this->cost();
+}
+
+bool BoundingVolumeHierarchy::split(u32 index) {
+  Node &node = nodes_[index];
+
+  const u32 first = node.left_or_first;
+  const u32 count = node.count;
+
+  if (count <= 1)
+    return false;
+
+  // Bin along the axis with the greatest spread of centroids.
+  Vec3 lower(FLT_MAX, FLT_MAX, FLT_MAX), upper(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+  for (u32 i = first; i < first + count; ++i) {
+    const Vec3 centroid = world_bounds_[order_[i]].center();
+    lower = Vec3::min(lower, centroid);
+    upper = Vec3::max(upper, centroid);
+  }
+
+  const Vec3 spread = upper - lower;
+
+  u32 axis = 0;
+  if (spread.y > (&spread.x)[axis]) axis = 1;
+  if (spread.z > (&spread.x)[axis]) axis = 2;
+
+  if ((&spread.x)[axis] <= 0.f)
+    // All centroids coincide, so there's no way to split.
+    return false;
+
+  const bvh::Binner binner = {
+    axis,
+    (&lower.x)[axis],
+    bvh::NUM_OF_BINS / (&spread.x)[axis]
+  };
+
+  bvh::Bin bins[bvh::NUM_OF_BINS];
+
+  for (u32 bin = 0; bin < bvh::NUM_OF_BINS; ++bin) {
+    bins[bin].bounds = bvh::empty();
+    bins[bin].count = 0;
+  }
+
+  for (u32 i = first; i < first + count; ++i) {
+    const AABB &bounds = world_bounds_[order_[i]];
+    bvh::Bin &bin = bins[binner(bounds)];
+    bin.bounds = AABB::merge(bin.bounds, bounds);
+    bin.count += 1;
+  }
+
+  // Sweep from the left then the right to evaluate a split between each pair
+  // of bins.
+  f32 left_areas[bvh::NUM_OF_BINS];
+  u32 left_counts[bvh::NUM_OF_BINS];
+
+  AABB left_bounds = bvh::empty();
+  u32 left_count = 0;
+
+  for (u32 bin = 0; bin < bvh::NUM_OF_BINS - 1; ++bin) {
+    left_bounds = AABB::merge(left_bounds, bins[bin].bounds);
+    left_count += bins[bin].count;
+    left_areas[bin] = left_count ? left_bounds.surface_area() : 0.f;
+    left_counts[bin] = left_count;
+  }
+
+  AABB right_bounds = bvh::empty();
+  u32 right_count = 0;
+
+  f32 best_cost = FLT_MAX;
+  u32 best = bvh::NONE;
+
+  for (u32 bin = bvh::NUM_OF_BINS - 1; bin > 0; --bin) {
+    right_bounds = AABB::merge(right_bounds, bins[bin].bounds);
+    right_count += bins[bin].count;
+
+    if (!left_counts[bin - 1] || !right_count)
+      continue;
+
+    const f32 cost = left_areas[bin - 1] * left_counts[bin - 1]
+                   + right_bounds.surface_area() * right_count;
+
+    if (cost < best_cost) {
+      best_cost = cost;
+      best = bin;
+    }
+  }
+
+  if (best == bvh::NONE)
+    return false;
+
+  const f32 area = bvh::bounds_of_a_node(node).surface_area();
+
+  const f32 cost_if_split = bvh::TRAVERSAL_COST + (area > 0.f ? best_cost / area : 0.f);
+  const f32 cost_if_leaf = (f32)count;
+
+  if ((cost_if_split >= cost_if_leaf) && (count <= bvh::MAXIMUM_PRIMITIVES_PER_LEAF))
+    return false;
+
+  // Partition primitives to either side of the split.
+  u32 i = first;
+  u32 j = first + count;
+
+  while (i < j) {
+    if (binner(world_bounds_[order_[i]]) < best) {
+      ++i;
+    } else {
+      const u32 swap = order_[i];
+      order_[i] = order_[--j];
+      order_[j] = swap;
+    }
+  }
+
+  left_bounds = bvh::empty();
+  right_bounds = bvh::empty();
+
+  for (u32 bin = 0; bin < best; ++bin)
+    left_bounds = AABB::merge(left_bounds, bins[bin].bounds);
+  for (u32 bin = best; bin < bvh::NUM_OF_BINS; ++bin)
+    right_bounds = AABB::merge(right_bounds, bins[bin].bounds);
+
+  const u32 left = num_of_nodes_;
+  const u32 right = left + 1;
+
+  num_of_nodes_ += 2;
+
+  bvh::set_bounds_of_a_node(nodes_[left], left_bounds);
+  nodes_[left].left_or_first = first;
+  nodes_[left].count = i - first;
+
+  bvh::set_bounds_of_a_node(nodes_[right], right_bounds);
+  nodes_[right].left_or_first = i;
+  nodes_[right].count = first + count - i;
+
+  node.left_or_first = left;
+  node.count = 0;
+
+  return true;
+}
+
+void BoundingVolumeHierarchy::refit() {
+  // Children always follow their parent, so walking backwards visits
+  // children before their parent.
+  for (u32 index = num_of_nodes_; index-- > 0;) {
+    Node &node = nodes_[index];
+
+    AABB bounds = bvh::empty();
+
+    if (node.count) {
+      for (u32 i = node.left_or_first; i < node.left_or_first + node.count; ++i)
+        bounds = AABB::merge(bounds, world_bounds_[order_[i]]);
+    } else {
+      bounds = AABB::merge(bvh::bounds_of_a_node(nodes_[node.left_or_first + 0]),
+                           bvh::bounds_of_a_node(nodes_[node.left_or_first + 1]));
+    }
+
+    bvh::set_bounds_of_a_node(node, bounds);
+  }
+
+  moved_ = false;
+}
+
+f32 BoundingVolumeHierarchy::cost() const {
+  if (num_of_nodes_ == 0)
+    return 0.f;
+
+  const f32 area_of_root = bvh::bounds_of_a_node(nodes_[0]).surface_area();
+
+  if (area_of_root <= 0.f)
+    return 0.f;
+
+  f32 cost = 0.f;
+
+  for (u32 index = 0; index < num_of_nodes_; ++index) {
+    const Node &node = nodes_[index];
+    const f32 area = bvh::bounds_of_a_node(node).surface_area();
+
+    if (node.count)
+      cost += area * node.count;
+    else
+      cost += area * bvh::TRAVERSAL_COST;
+  }
+
+  return cost / area_of_root;
+}
+
+void BoundingVolumeHierarchy::raycast_n(const Raycast *raycasts,
+                                        RaycastHit *hits,
+                                        size_t n) const {
+  for (size_t i = 0; i < n; ++i) {
+    hits[i].entity = Entity();
+    hits[i].distance = raycasts[i].distance;
+  }
+
+  if (num_of_nodes_ == 0)
+    return;
+
+  const Node *nodes = nodes_.raw();
+  const u32 *order = order_.raw();
+  const AABB *bounds = world_bounds_.raw();
+  const Entity *entities = primitive_to_entity_.raw();
+
+  for (size_t first = 0; first < n; first += 4) {
+    const size_t lanes = (n - first) < 4 ? (n - first) : 4;
+
+    bvh::Rays rays;
+
+    for (u32 lane = 0; lane < 4; ++lane) {
+      if (lane < lanes) {
+        const Raycast &raycast = raycasts[first + lane];
+
+        rays.ox[lane] = raycast.ray.origin.x;
+        rays.oy[lane] = raycast.ray.origin.y;
+        rays.oz[lane] = raycast.ray.origin.z;
+
+        rays.ix[lane] = bvh::reciprocal(raycast.ray.direction.x);
+        rays.iy[lane] = bvh::reciprocal(raycast.ray.direction.y);
+        rays.iz[lane] = bvh::reciprocal(raycast.ray.direction.z);
+
+        rays.t[lane] = raycast.distance;
+      } else {
+        rays.ox[lane] = rays.oy[lane] = rays.oz[lane] = 0.f;
+        rays.ix[lane] = rays.iy[lane] = rays.iz[lane] = 1.f;
+        rays.t[lane] = -1.f;
+      }
+    }
+
+    u32 closest[4] = { bvh::NONE, bvh::NONE, bvh::NONE, bvh::NONE };
+
+    f32 distances[4];
+
+    u32 stack[2 * bvh::MAXIMUM_DEPTH];
+    u32 top = 0;
+
+    if (bvh::test(rays, nodes[0].min, nodes[0].max, distances))
+      stack[top++] = 0;
+
+    while (top) {
+      const Node &node = nodes[stack[--top]];
+
+      if (node.count) {
+        for (u32 index = node.left_or_first; index < node.left_or_first + node.count; ++index) {
+          const u32 primitive = order[index];
+
+          if (bvh::dead(entities[primitive]))
+            continue;
+
+          // Only closer intersections pass, since t_the exit distance is clamped to the
+          // closest intersection so far.
+          const u32 mask = bvh::test(rays, &bounds[primitive].min.x, &bounds[primitive].max.x, distances);
+
+          for (u32 lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) {
+              rays.t[lane] = distances[lane];
+              closest[lane] = primitive;
+            }
+          }
+        }
+      } else {
+        const u32 left = node.left_or_first;
+        const u32 right = left + 1;
+
+        f32 distances_to_left[4], distances_to_right[4];
+
+        const u32 hit_left = bvh::test(rays, nodes[left].min, nodes[left].max, distances_to_left);
+        const u32 hit_right = bvh::test(rays, nodes[right].min, nodes[right].max, distances_to_right);
+
+        if (hit_left && hit_right) {
+          // Visit whichever child is nearer first so that we can cull more
+          // of the other.
+          if (bvh::nearest(distances_to_left, hit_left) <= bvh::nearest(distances_to_right, hit_right)) {
+            stack[top++] = right;
+            stack[top++] = left;
+          } else {
+            stack[top++] = left;
+            stack[top++] = right;
+          }
+        } else if (hit_left) {
+          stack[top++] = left;
+        } else if (hit_right) {
+          stack[top++] = right;
+        }
+      }
+    }
+
+    for (u32 lane = 0; lane < lanes; ++lane) {
+      if (closest[lane] != bvh::NONE) {
+        hits[first + lane].entity = entities[closest[lane]];
+        hits[first + lane].distance = rays.t[lane];
+      }
+    }
+  }
+}
+
+void BoundingVolumeHierarchy::overlap_sphere_n(const Sphere *spheres,
+                                               size_t n,
+                                               Overlaps *overlaps) const {
+  overlaps->offsets.resize(n + 1);
+  overlaps->entities.resize(0);
+
+  if (num_of_nodes_ == 0) {
+    core::memory::zero((void *)overlaps->offsets.raw(), (n + 1) * sizeof(u32));
+    return;
+  }
+
+  core::Array<bvh::Overlap> overlapping(core::global_heap_allocator());
+
+  for (size_t first = 0; first < n; first += 4) {
+    const size_t lanes = (n - first) < 4 ? (n - first) : 4;
+
+    bvh::Spheres packet;
+
+    for (u32 lane = 0; lane < 4; ++lane) {
+      if (lane < lanes) {
+        const Sphere &sphere = spheres[first + lane];
+        packet.x[lane] = sphere.center.x;
+        packet.y[lane] = sphere.center.y;
+        packet.z[lane] = sphere.center.z;
+        packet.r2[lane] = sphere.radius * sphere.radius;
+      } else {
+        packet.x[lane] = packet.y[lane] = packet.z[lane] = 0.f;
+        packet.r2[lane] = -1.f;
+      }
+    }
+
+    overlapping.resize(0);
+
+    bvh::overlap(nodes_.raw(),
+                 order_.raw(),
+                 world_bounds_.raw(),
+                 primitive_to_entity_.raw(),
+                 packet,
+                 overlapping);
+
+    bvh::flush(overlapping, first, lanes, overlaps);
+  }
+}
+
+void BoundingVolumeHierarchy::overlap_aabb_n(const AABB *boxes,
+                                             size_t n,
+                                             Overlaps *overlaps) const {
+  overlaps->offsets.resize(n + 1);
+  overlaps->entities.resize(0);
+
+  if (num_of_nodes_ == 0) {
+    core::memory::zero((void *)overlaps->offsets.raw(), (n + 1) * sizeof(u32));
+    return;
+  }
+
+  core::Array<bvh::Overlap> overlapping(core::global_heap_allocator());
+
+  for (size_t first = 0; first < n; first += 4) {
+    const size_t lanes = (n - first) < 4 ? (n - first) : 4;
+
+    bvh::Boxes packet;
+
+    for (u32 lane = 0; lane < 4; ++lane) {
+      if (lane < lanes) {
+        const AABB &box = boxes[first + lane];
+        packet.min_x[lane] = box.min.x;
+        packet.min_y[lane] = box.min.y;
+        packet.min_z[lane] = box.min.z;
+        packet.max_x[lane] = box.max.x;
+        packet.max_y[lane] = box.max.y;
+        packet.max_z[lane] = box.max.z;
+      } else {
+        packet.min_x[lane] = packet.min_y[lane] = packet.min_z[lane] = FLT_MAX;
+        packet.max_x[lane] = packet.max_y[lane] = packet.max_z[lane] = -FLT_MAX;
+      }
+    }
+
+    overlapping.resize(0);
+
+    bvh::overlap(nodes_.raw(),
+                 order_.raw(),
+                 world_bounds_.raw(),
+                 primitive_to_entity_.raw(),
+                 packet,
+                 overlapping);
+
+    bvh::flush(overlapping, first, lanes, overlaps);
+  }
+}
+
+void BoundingVolumeHierarchy::lifecycle_callback_shim(Entity::LifecycleEvent event,
+                                                      Entity entity,
+                                                      void *bvh) {
+  BoundingVolumeHierarchy *self = (BoundingVolumeHierarchy *)bvh;
+
+  if (event == Entity::DESTROYED)
+    if (self->has(entity))
+      self->remove(entity);
+}
+
+} // yeti
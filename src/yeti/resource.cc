@@ -81,7 +81,7 @@ Resource::Type::Id resource::register_a_type(const Resource::Type *type) {
 #endif
 
   const Resource::Type::Id id =
-    (Resource::Type::Id)core::murmur_hash_32(type->name);
+    (Resource::Type::Id)core::interned_strings::intern(type->name);
 
   id_for_types_.push(id);
   types_.push(type);
@@ -36,8 +36,8 @@ namespace resource_manager {
     // Signaled whenever some work is added to one of the four queues.
     core::Event work_to_be_done_;
 
-    core::Map<Resource::Id, Resource *> resources_(core::global_heap_allocator(), 131072);
-    core::Map<Resource::Id, Resource::State> states_(core::global_heap_allocator(), 131072);
+    core::FlatMap<Resource::Id, Resource *> resources_(core::global_heap_allocator(), 131072);
+    core::FlatMap<Resource::Id, Resource::State> states_(core::global_heap_allocator(), 131072);
 
     core::Queue<Resource *> to_be_loaded_(core::global_heap_allocator(), 16384);
     core::Queue<Resource *> to_be_unloaded_(core::global_heap_allocator(), 16384);
@@ -512,7 +512,7 @@ bool EntityCompiler::bake()
     const u32 n_instances = cdef->count;
 
     // Mapping from instances to entities is built in memory and then written wholesale.
-    core::Array<u32> mappings(core::global_heap_allocator());
+    core::SmallArray<u32, 256> mappings(core::global_heap_allocator());
 
     for (u32 index = cdef->head; index != -1; index = instance_definitions_[index].next)
       mappings.push(instance_definitions_[index].index_of_entity);
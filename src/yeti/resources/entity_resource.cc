@@ -47,8 +47,7 @@ const Resource::Type *EntityResource::type() {
 }
 
 Resource *EntityResource::prepare(Resource::Id id) {
-  // TODO(mtwilliams): Use an arena allocator.
-  return (Resource *)YETI_NEW(EntityResource, core::global_heap_allocator())(id);
+  return (Resource *)YETI_NEW(EntityResource, resource::pool<EntityResource>())(id);
 }
 
 void EntityResource::load(Resource *resource, const Resource::Data &data) {
@@ -57,7 +56,7 @@ void EntityResource::load(Resource *resource, const Resource::Data &data) {
 void EntityResource::unload(Resource *resource) {
   EntityResource *entity_resource = (EntityResource *)resource;
 
-  YETI_DELETE(EntityResource, core::global_heap_allocator(), entity_resource);
+  YETI_DELETE(EntityResource, resource::pool<EntityResource>(), entity_resource);
 }
 
 bool EntityResource::compile(const resource_compiler::Environment *env,
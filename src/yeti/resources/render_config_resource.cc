@@ -45,8 +45,7 @@ const Resource::Type *RenderConfigResource::type() {
 }
 
 Resource *RenderConfigResource::prepare(Resource::Id id) {
-  // TODO(mtwilliams): Use an arena allocator.
-  return (Resource *)YETI_NEW(RenderConfigResource, core::global_heap_allocator())(id);
+  return (Resource *)YETI_NEW(RenderConfigResource, resource::pool<RenderConfigResource>())(id);
 }
 
 void RenderConfigResource::load(Resource *resource, const Resource::Data &data) {
@@ -87,7 +86,7 @@ void RenderConfigResource::unload(Resource *resource) {
 
   core::global_heap_allocator().deallocate(render_config_resource->memory_resident_data_);
 
-  YETI_DELETE(RenderConfigResource, core::global_heap_allocator(), render_config_resource);
+  YETI_DELETE(RenderConfigResource, resource::pool<RenderConfigResource>(), render_config_resource);
 }
 
 bool RenderConfigResource::compile(const resource_compiler::Environment *env,
@@ -53,8 +53,7 @@ const Resource::Type *ScriptResource::type() {
 }
 
 Resource *ScriptResource::prepare(Resource::Id id) {
-  // TODO(mtwilliams): Use an arena allocator.
-  return (Resource *)YETI_NEW(ScriptResource, core::global_heap_allocator())(id);
+  return (Resource *)YETI_NEW(ScriptResource, resource::pool<ScriptResource>())(id);
 }
 
 void ScriptResource::load(Resource *resource, const Resource::Data &data) {
@@ -79,7 +78,7 @@ void ScriptResource::unload(Resource *resource) {
 
   core::global_heap_allocator().deallocate((void *)script_resource->bytecode_);
 
-  YETI_DELETE(ScriptResource, core::global_heap_allocator(), script_resource);
+  YETI_DELETE(ScriptResource, resource::pool<ScriptResource>(), script_resource);
 }
 
 bool ScriptResource::compile(const resource_compiler::Environment *env,
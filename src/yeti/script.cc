@@ -134,11 +134,7 @@ void *Script::__alloc(Script *script, void *ptr, size_t, size_t size) {
 int Script::__require(lua_State *L) {
   const char *script_name = luaL_checkstring(L, 1);
 
-  static const Resource::Type *script_resource_type =
-    resource::type_from_name("script");
-
-  static const Resource::Type::Id script_resource_type_id =
-    resource::id_from_type(script_resource_type);
+  static const Resource::Type::Id script_resource_type_id = YETI_HASH("script");
 
   const Resource::Id script_id =
     resource::id_from_name(script_resource_type_id, script_name);
@@ -41,8 +41,8 @@ template <> Camera::Handle Script::to_a<Camera::Handle>(int index) {
   return {to_a<Reference>(index).opaque};
 }
 
-template <> void Script::push<Camera::Handle>(Camera::Handle camera) {
-  push<Reference>({camera.instance});
+template <> void Script::push<Camera::Handle>(const Camera::Handle &camera) {
+  push<Reference>({camera.opaque});
 }
 
 namespace camera_if {
@@ -85,16 +85,10 @@ namespace camera_if {
       World *world = script->to_a<World *>(1);
       const Entity entity = script->to_a<Entity>(2);
 
-      Camera::Handle handle;
-
-      if (lua_gettop(L) >= 3) {
-        const unsigned instance = (unsigned)luaL_checkinteger(L, 3);
-        handle = world->cameras()->lookup(entity, instance);
-      } else {
-        handle = world->cameras()->lookup(entity);
-      }
-
-      script->push<Camera::Handle>(handle);
+      if (world->cameras()->has(entity))
+        script->push<Camera::Handle>(world->cameras()->lookup(entity));
+      else
+        lua_pushnil(L);
 
       return 1;
     }
@@ -185,7 +179,7 @@ namespace camera_if {
       if (field_of_view <= 0.f)
         return luaL_argerror(L, 3, "Field-of-view must be greater than 0°!");
 
-      if (fov > 180.f)
+      if (field_of_view > 180.f)
         return luaL_argerror(L, 3, "Field-of-view must be lesser than 180°!");
 
       world->cameras()->set_field_of_view(handle, field_of_view);
@@ -270,7 +264,7 @@ namespace camera_if {
       lua_setfield(L, -2, "type");
 
       if (camera.type == Camera::PERSPECTIVE) {
-        lua_pushinteger(L, (lua_Integer)camera.perspective.fov);
+        lua_pushinteger(L, (lua_Integer)camera.perspective.field_of_view);
         lua_setfield(L, -2, "field_of_view");
       } else if (camera.type == Camera::ORTHOGRAPHIC) {
         lua_createtable(L, 0, 4);
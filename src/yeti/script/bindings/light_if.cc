@@ -41,8 +41,8 @@ template <> Light::Handle Script::to_a<Light::Handle>(int index) {
   return {to_a<Reference>(index).opaque};
 }
 
-template <> void Script::push<Light::Handle>(Light::Handle light) {
-  push<Reference>({light.instance});
+template <> void Script::push<Light::Handle>(const Light::Handle &light) {
+  push<Reference>({light.opaque});
 }
 
 namespace light_if {
@@ -85,16 +85,10 @@ namespace light_if {
       World *world = script->to_a<World *>(1);
       const Entity entity = script->to_a<Entity>(2);
 
-      Light::Handle handle;
-
-      if (lua_gettop(L) >= 3) {
-        const unsigned instance = (unsigned)luaL_checkinteger(L, 3);
-        handle = world->lights()->lookup(entity, instance);
-      } else {
-        handle = world->lights()->lookup(entity);
-      }
-
-      script->push<Light::Handle>(handle);
+      if (world->lights()->has(entity))
+        script->push<Light::Handle>(world->lights()->lookup(entity));
+      else
+        lua_pushnil(L);
 
       return 1;
     }
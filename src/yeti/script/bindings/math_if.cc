@@ -17,7 +17,7 @@
 
 namespace yeti {
 
-template <> void Script::push<Vec2>(Vec2 v) {
+template <> void Script::push<Vec2>(const Vec2 &v) {
   // Allocate temporary storage.
   Vec2 *storage = E->allocate<Vec2>();
 
@@ -51,7 +51,7 @@ template <> Vec2 Script::to_a<Vec2>(int index) {
   return *ptr_to_v;
 }
 
-template <> void Script::push<Vec3>(Vec3 v) {
+template <> void Script::push<Vec3>(const Vec3 &v) {
   // Allocate temporary storage.
   Vec3 *storage = E->allocate<Vec3>();
 
@@ -85,7 +85,7 @@ template <> Vec3 Script::to_a<Vec3>(int index) {
   return *ptr_to_v;
 }
 
-template <> void Script::push<Vec4>(Vec4 v) {
+template <> void Script::push<Vec4>(const Vec4 &v) {
   // Allocate temporary storage.
   Vec4 *storage = E->allocate<Vec4>();
 
@@ -119,7 +119,7 @@ template <> Vec4 Script::to_a<Vec4>(int index) {
   return *ptr_to_v;
 }
 
-template <> void Script::push<Quaternion>(Quaternion v) {
+template <> void Script::push<Quaternion>(const Quaternion &v) {
   // Allocate temporary storage.
   Quaternion *storage = E->allocate<Quaternion>();
 
@@ -153,7 +153,7 @@ template <> Quaternion Script::to_a<Quaternion>(int index) {
   return *ptr_to_v;
 }
 
-template <> void Script::push<Mat4>(Mat4 v) {
+template <> void Script::push<Mat4>(const Mat4 &v) {
   // Allocate temporary storage.
   Mat4 *storage = E->allocate<Mat4>();
 
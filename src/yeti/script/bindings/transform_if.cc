@@ -30,7 +30,7 @@
 namespace yeti {
 
 namespace transform_if {
-  static const u32 TYPE = component_registry::id_from_name("transform");
+  static const u32 TYPE = YETI_HASH("transform");
 
   static bool check(lua_State *L, int idx) {
     return component_if::check(L, idx, TYPE);
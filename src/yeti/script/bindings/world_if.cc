@@ -27,6 +27,8 @@
 
 #include "yeti/world.h"
 
+#include <float.h>
+
 namespace yeti {
 
 namespace world_if {
@@ -143,8 +145,7 @@ namespace world_if {
 
           name = lua_tostring(L, 2);
 
-          static const Resource::Type::Id type =
-            resource::id_from_type(resource::type_from_name("entity"));
+          static const Resource::Type::Id type = YETI_HASH("entity");
 
           resource = resource::id_from_name(type, name);
 
@@ -176,6 +177,214 @@ namespace world_if {
       return 0;
     }
 
+    static int track(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      // TODO(mtwilliams): Vaildate handle against |world|.
+      const Entity entity = entity_if::cast(L, 2).entity;
+
+      // Bounds are relative to the entity's transform.
+      const AABB bounds(script->to_a<Vec3>(3), script->to_a<Vec3>(4));
+
+      world->track(entity, bounds);
+
+      return 0;
+    }
+
+    static int untrack(lua_State *L) {
+      World *world = world_if::cast(L, 1);
+
+      // TODO(mtwilliams): Vaildate handle against |world|.
+      const Entity entity = entity_if::cast(L, 2).entity;
+
+      world->untrack(entity);
+
+      return 0;
+    }
+
+    static int raycast(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      Raycast raycast;
+      raycast.ray.origin = script->to_a<Vec3>(2);
+      raycast.ray.direction = script->to_a<Vec3>(3).normalize();
+      raycast.distance = (f32)luaL_optnumber(L, 4, FLT_MAX);
+
+      RaycastHit hit;
+      world->raycast_n(&raycast, &hit, 1);
+
+      if (hit.entity.id == Entity().id) {
+        lua_pushnil(L);
+        return 1;
+      }
+
+      entity_if::push(L, { world, hit.entity });
+      lua_pushnumber(L, hit.distance);
+
+      return 2;
+    }
+
+    static int raycast_n(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      luaL_checktype(L, 2, LUA_TTABLE);
+      luaL_checktype(L, 3, LUA_TTABLE);
+
+      const size_t n = lua_objlen(L, 2);
+
+      if (lua_objlen(L, 3) != n)
+        return luaL_argerror(L, 3, "Expected as many directions as origins.");
+
+      const f32 distance = (f32)luaL_optnumber(L, 4, FLT_MAX);
+
+      core::Array<Raycast> raycasts(core::global_heap_allocator(), n);
+      core::Array<RaycastHit> hits(core::global_heap_allocator(), n);
+
+      for (size_t i = 0; i < n; ++i) {
+        lua_rawgeti(L, 2, (int)i + 1);
+        lua_rawgeti(L, 3, (int)i + 1);
+        raycasts[i].ray.origin = script->to_a<Vec3>(-2);
+        raycasts[i].ray.direction = script->to_a<Vec3>(-1).normalize();
+        raycasts[i].distance = distance;
+        lua_pop(L, 2);
+      }
+
+      world->raycast_n(raycasts.raw(), hits.raw(), n);
+
+      // Returns entities hit, or false, and distances to each.
+      lua_createtable(L, (int)n, 0);
+      lua_createtable(L, (int)n, 0);
+
+      for (size_t i = 0; i < n; ++i) {
+        if (hits[i].entity.id != Entity().id)
+          entity_if::push(L, { world, hits[i].entity });
+        else
+          lua_pushboolean(L, 0);
+
+        lua_rawseti(L, -3, (int)i + 1);
+
+        lua_pushnumber(L, hits[i].distance);
+        lua_rawseti(L, -2, (int)i + 1);
+      }
+
+      return 2;
+    }
+
+    // Pushes a table of entities overlapping the @query-th query.
+    static int push_overlaps(lua_State *L, World *world, const Overlaps &overlaps, size_t query = 0) {
+      const u32 first = overlaps.offsets[query];
+      const u32 n = overlaps.offsets[query + 1] - first;
+
+      lua_createtable(L, (int)n, 0);
+
+      for (u32 i = 0; i < n; ++i) {
+        entity_if::push(L, { world, overlaps.entities[first + i] });
+        lua_rawseti(L, -2, (int)i + 1);
+      }
+
+      return 1;
+    }
+
+    // Pushes a table with a table of overlapping entities per query.
+    static int push_overlaps_n(lua_State *L, World *world, const Overlaps &overlaps, size_t n) {
+      lua_createtable(L, (int)n, 0);
+
+      for (size_t query = 0; query < n; ++query) {
+        push_overlaps(L, world, overlaps, query);
+        lua_rawseti(L, -2, (int)query + 1);
+      }
+
+      return 1;
+    }
+
+    static int overlap_sphere(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      const Sphere sphere(script->to_a<Vec3>(2), (f32)luaL_checknumber(L, 3));
+
+      Overlaps overlaps;
+      world->overlap_sphere_n(&sphere, 1, &overlaps);
+
+      return push_overlaps(L, world, overlaps);
+    }
+
+    static int overlap_sphere_n(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      luaL_checktype(L, 2, LUA_TTABLE);
+      luaL_checktype(L, 3, LUA_TTABLE);
+
+      const size_t n = lua_objlen(L, 2);
+
+      if (lua_objlen(L, 3) != n)
+        return luaL_argerror(L, 3, "Expected as many radii as centers.");
+
+      core::Array<Sphere> spheres(core::global_heap_allocator(), n);
+
+      for (size_t i = 0; i < n; ++i) {
+        lua_rawgeti(L, 2, (int)i + 1);
+        lua_rawgeti(L, 3, (int)i + 1);
+        spheres[i] = Sphere(script->to_a<Vec3>(-2), (f32)luaL_checknumber(L, -1));
+        lua_pop(L, 2);
+      }
+
+      Overlaps overlaps;
+      world->overlap_sphere_n(spheres.raw(), n, &overlaps);
+
+      return push_overlaps_n(L, world, overlaps, n);
+    }
+
+    static int overlap_aabb(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      const AABB box(script->to_a<Vec3>(2), script->to_a<Vec3>(3));
+
+      Overlaps overlaps;
+      world->overlap_aabb_n(&box, 1, &overlaps);
+
+      return push_overlaps(L, world, overlaps);
+    }
+
+    static int overlap_aabb_n(lua_State *L) {
+      Script *script = Script::recover(L);
+
+      World *world = world_if::cast(L, 1);
+
+      luaL_checktype(L, 2, LUA_TTABLE);
+      luaL_checktype(L, 3, LUA_TTABLE);
+
+      const size_t n = lua_objlen(L, 2);
+
+      if (lua_objlen(L, 3) != n)
+        return luaL_argerror(L, 3, "Expected as many maximums as minimums.");
+
+      core::Array<AABB> boxes(core::global_heap_allocator(), n);
+
+      for (size_t i = 0; i < n; ++i) {
+        lua_rawgeti(L, 2, (int)i + 1);
+        lua_rawgeti(L, 3, (int)i + 1);
+        boxes[i] = AABB(script->to_a<Vec3>(-2), script->to_a<Vec3>(-1));
+        lua_pop(L, 2);
+      }
+
+      Overlaps overlaps;
+      world->overlap_aabb_n(boxes.raw(), n, &overlaps);
+
+      return push_overlaps_n(L, world, overlaps, n);
+    }
+
     // static int entity_by_id(lua_State *L) {
     //   return luaL_error(L, "Not implemented yet.");
     // }
@@ -210,6 +419,16 @@ void world_if::expose(Script *script) {
   script->add_module_function("World", "spawn", &spawn);
   script->add_module_function("World", "kill", &kill);
 
+  script->add_module_function("World", "track", &track);
+  script->add_module_function("World", "untrack", &untrack);
+
+  script->add_module_function("World", "raycast", &raycast);
+  script->add_module_function("World", "raycast_n", &raycast_n);
+  script->add_module_function("World", "overlap_sphere", &overlap_sphere);
+  script->add_module_function("World", "overlap_sphere_n", &overlap_sphere_n);
+  script->add_module_function("World", "overlap_aabb", &overlap_aabb);
+  script->add_module_function("World", "overlap_aabb_n", &overlap_aabb_n);
+
   // script->add_module_function("World", "entity_by_id", &entity_by_id);
   // script->add_module_function("World", "entity_by_name", &entity_by_name);
 
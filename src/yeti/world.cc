@@ -28,10 +28,13 @@ World::World()
   , transforms_((TransformSystem *)systems_.lookup("transform"))
   , cameras_((CameraSystem *)systems_.lookup("camera"))
   , lights_((LightSystem *)systems_.lookup("light"))
+  , spatial_(BoundingVolumeHierarchy::create(&entities_))
+  , moved_(core::global_heap_allocator())
 {
 }
 
 World::~World() {
+  spatial_->destroy();
 }
 
 World *World::create() {
@@ -44,6 +47,68 @@ void World::update(const f32 delta_time) {
 
   // Build task graph.
   // Kick and wait.
+
+  // Changes are forgotten after updating, so grab them first.
+  moved_.resize(0);
+  transforms_->changed(moved_);
+
+  transforms_->update();
+
+  // Keep spatial index in sync.
+  for (const Entity *entity = moved_.begin(); entity != moved_.end(); ++entity) {
+    if (!spatial_->has(*entity))
+      continue;
+
+    const Transform::Instance instance =
+      transforms_->resolve(transforms_->lookup(*entity));
+
+    spatial_->move(*entity, transforms_->get_world_pose(instance));
+  }
+
+  spatial_->update();
+}
+
+void World::track(Entity entity, const AABB &bounds) {
+  if (spatial_->has(entity))
+    // Replace bounds.
+    spatial_->remove(entity);
+
+  if (transforms_->has(entity)) {
+    const Transform::Instance instance =
+      transforms_->resolve(transforms_->lookup(entity));
+
+    spatial_->insert(entity, bounds, transforms_->get_world_pose(instance));
+  } else {
+    // Picked up once a transform is created, as creation counts as a change.
+    spatial_->insert(entity, bounds);
+  }
+}
+
+void World::untrack(Entity entity) {
+  if (spatial_->has(entity))
+    spatial_->remove(entity);
+}
+
+void World::interpolate(const f32 alpha) {
+  transforms_->interpolate(alpha);
+}
+
+void World::raycast_n(const Raycast *raycasts,
+                      RaycastHit *hits,
+                      size_t n) const {
+  spatial_->raycast_n(raycasts, hits, n);
+}
+
+void World::overlap_sphere_n(const Sphere *spheres,
+                             size_t n,
+                             Overlaps *overlaps) const {
+  spatial_->overlap_sphere_n(spheres, n, overlaps);
+}
+
+void World::overlap_aabb_n(const AABB *boxes,
+                           size_t n,
+                           Overlaps *overlaps) const {
+  spatial_->overlap_aabb_n(boxes, n, overlaps);
 }
 
 void World::destroy() {
@@ -0,0 +1,197 @@
+//===-- yeti/benchmarks/benchmark.h ---------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Micro-benchmark harness.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_BENCHMARKS_BENCHMARK_H_
+#define _YETI_BENCHMARKS_BENCHMARK_H_
+
+#include "yeti.h"
+
+namespace yeti {
+namespace benchmarks {
+
+/// \brief Drives a single run of a benchmark.
+///
+/// \details Benchmarks loop while `running`, performing the operation under
+/// measurement once per iteration. Time is measured from the first call to
+/// `running` until the last, less any time spent paused.
+///
+class State {
+ YETI_DISALLOW_COPYING(State)
+
+ public:
+  explicit State(u64 iterations);
+  ~State();
+
+ public:
+  /// \brief Returns true while iterations remain.
+  bool running();
+
+  /// \brief Stops measuring time, so that setup isn't measured.
+  void pause();
+
+  /// \brief Resumes measuring time.
+  void resume();
+
+ public:
+  /// \brief Returns the number of iterations to run.
+  u64 iterations() const;
+
+  /// \brief Records the number of items processed across all iterations.
+  void set_items_processed(u64 items);
+
+  /// \brief Records the number of bytes processed across all iterations.
+  void set_bytes_processed(u64 bytes);
+
+ public:
+  /// \brief Returns the number of nanoseconds elapsed, less any spent paused.
+  u64 elapsed() const;
+
+  /// \brief Returns the number of items processed across all iterations.
+  u64 items() const;
+
+  /// \brief Returns the number of bytes processed across all iterations.
+  u64 bytes() const;
+
+ private:
+  void start();
+  void stop();
+
+ private:
+  core::Timer timer_;
+
+  u64 iterations_;
+  u64 remaining_;
+
+  u64 paused_at_;
+  u64 paused_for_;
+
+  u64 elapsed_;
+
+  u64 items_;
+  u64 bytes_;
+};
+
+YETI_INLINE bool State::running() {
+  if (YETI_UNLIKELY(remaining_ == iterations_))
+    this->start();
+
+  if (YETI_LIKELY(remaining_ != 0)) {
+    --remaining_;
+    return true;
+  }
+
+  this->stop();
+
+  return false;
+}
+
+/// \brief A benchmark.
+struct Benchmark {
+  /// Name used to identify results, and to match against baselines.
+  const char *name;
+
+  /// Performs the benchmark.
+  void (*function)(State &state);
+
+  /// \internal Next registered benchmark.
+  Benchmark *next;
+};
+
+/// \brief Returns the first registered benchmark, in order of registration.
+extern Benchmark *registered();
+
+/// \internal Registers @benchmark.
+extern void register_a_benchmark(Benchmark *benchmark);
+
+/// \internal Automatically registers a benchmark upon construction.
+class AutoRegisterBenchmark {
+ YETI_DISALLOW_COPYING(AutoRegisterBenchmark)
+
+ public:
+  AutoRegisterBenchmark(Benchmark *benchmark) {
+    register_a_benchmark(benchmark);
+  }
+
+  ~AutoRegisterBenchmark()
+  {}
+};
+
+/// \def YETI_BENCHMARK
+/// \brief Defines and automatically registers a benchmark named @Name.
+#define YETI_BENCHMARK(Name) \
+  static void YETI_PASTE(__benchmark__, Name)(::yeti::benchmarks::State &state); \
+  static ::yeti::benchmarks::Benchmark YETI_PASTE(__benchmark_description__, Name) = { #Name, &YETI_PASTE(__benchmark__, Name), NULL }; \
+  static const ::yeti::benchmarks::AutoRegisterBenchmark YETI_PASTE(__automatic_benchmark_registration__, __COUNTER__)(&YETI_PASTE(__benchmark_description__, Name)); \
+  static void YETI_PASTE(__benchmark__, Name)(::yeti::benchmarks::State &state)
+
+/// \brief Prevents the compiler from optimizing away computation of @value.
+///
+/// \details On GCC and Clang, an empty assembly block claims to read @value
+/// from memory. Elsewhere, every byte of @value is read through a volatile,
+/// which is slower but just as effective.
+///
+#if YETI_COMPILER == YETI_COMPILER_GCC || \
+    YETI_COMPILER == YETI_COMPILER_CLANG
+  template <typename T>
+  YETI_INLINE void keep(const T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+  }
+#else
+  /// \internal Where `keep` sinks bytes.
+  extern volatile u8 sink;
+
+  template <typename T>
+  YETI_INLINE void keep(const T &value) {
+    const volatile u8 *bytes = (const volatile u8 *)&value;
+    for (size_t byte = 0; byte < sizeof(T); ++byte)
+      sink = bytes[byte];
+  }
+#endif
+
+/// \brief A deterministic pseudo-random number generator.
+///
+/// \details Benchmarks use this rather than `core::random` so that inputs are
+/// identical from run to run, and thus comparable to a baseline.
+///
+class Random {
+ public:
+  explicit Random(u32 seed = 0x9e3779b9)
+    : state_(seed)
+  {}
+
+ public:
+  /// \brief Returns the next number in the sequence.
+  u32 next() {
+    // Marsaglia's xorshift.
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+    return state_;
+  }
+
+  /// \brief Returns the next number in the sequence, mapped to [@min, @max].
+  f32 next(const f32 min, const f32 max) {
+    return min + (max - min) * (f32(next() >> 8) / f32(1 << 24));
+  }
+
+ private:
+  u32 state_;
+};
+
+} // benchmarks
+} // yeti
+
+#endif // _YETI_BENCHMARKS_BENCHMARK_H_
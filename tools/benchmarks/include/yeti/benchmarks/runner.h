@@ -0,0 +1,104 @@
+//===-- yeti/benchmarks/runner.h ------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Runs registered benchmarks, reporting and comparing results.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef _YETI_BENCHMARKS_RUNNER_H_
+#define _YETI_BENCHMARKS_RUNNER_H_
+
+#include "yeti.h"
+
+#include "yeti/benchmarks/benchmark.h"
+
+namespace yeti {
+namespace benchmarks {
+
+/// \brief Measurements of a benchmark.
+///
+/// \note Times are in nanoseconds per iteration.
+///
+struct Result {
+  const char *name;
+
+  u64 iterations;
+  u32 samples;
+
+  f64 minimum;
+  f64 median;
+  f64 mean;
+  f64 maximum;
+
+  f64 items_per_second;
+  f64 bytes_per_second;
+};
+
+/// \brief A previously saved result to compare against.
+struct Baseline {
+  char name[64];
+  f64 median;
+};
+
+class Runner {
+ YETI_DISALLOW_COPYING(Runner)
+
+ public:
+  Runner();
+  ~Runner();
+
+ public:
+  void setup(const char *args[], const u32 num_args);
+
+  /// \brief Runs all benchmarks that match our filter.
+  ///
+  /// \return Number of benchmarks that regressed relative to our baseline.
+  ///
+  u32 run();
+
+ private:
+  // Determines the number of iterations needed to take at least our minimum
+  // time, then measures a number of samples.
+  void measure(const Benchmark *benchmark, Result *result) const;
+
+  // Prints @result to console, comparing it to @baseline if available.
+  //
+  // Returns true if @result regressed.
+  bool report(const Result &result, const Baseline *baseline) const;
+
+  // Loads baseline results from @path.
+  bool load(const char *path);
+
+  // Writes @results to @path as JSON.
+  bool save(const char *path, const core::Array<Result> &results) const;
+
+ private:
+  const char *filter_;
+  const char *output_;
+  const char *baseline_;
+
+  // Percentage slower than baseline tolerated before considering a
+  // benchmark to have regressed.
+  f64 threshold_;
+
+  u32 samples_;
+
+  // Minimum time, in nanoseconds, each sample should take.
+  u64 minimum_;
+
+  core::Array<Baseline> baselines_;
+};
+
+} // benchmarks
+} // yeti
+
+#endif // _YETI_BENCHMARKS_RUNNER_H_
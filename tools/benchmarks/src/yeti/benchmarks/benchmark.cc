@@ -0,0 +1,100 @@
+//===-- yeti/benchmarks/benchmark.cc --------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+namespace yeti {
+namespace benchmarks {
+
+State::State(u64 iterations)
+  : iterations_(iterations)
+  , remaining_(iterations)
+  , paused_at_(0)
+  , paused_for_(0)
+  , elapsed_(0)
+  , items_(0)
+  , bytes_(0)
+{
+  yeti_assert_debug(iterations > 0);
+}
+
+State::~State() {
+}
+
+void State::start() {
+  paused_for_ = 0;
+  timer_.reset();
+}
+
+void State::stop() {
+  elapsed_ = timer_.nsecs() - paused_for_;
+}
+
+void State::pause() {
+  paused_at_ = timer_.nsecs();
+}
+
+void State::resume() {
+  paused_for_ += timer_.nsecs() - paused_at_;
+}
+
+u64 State::iterations() const {
+  return iterations_;
+}
+
+void State::set_items_processed(u64 items) {
+  items_ = items;
+}
+
+void State::set_bytes_processed(u64 bytes) {
+  bytes_ = bytes;
+}
+
+u64 State::elapsed() const {
+  return elapsed_;
+}
+
+u64 State::items() const {
+  return items_;
+}
+
+u64 State::bytes() const {
+  return bytes_;
+}
+
+#if YETI_COMPILER != YETI_COMPILER_GCC && \
+    YETI_COMPILER != YETI_COMPILER_CLANG
+  volatile u8 sink = 0;
+#endif
+
+// Benchmarks are registered by static initializers, so these must be
+// zero-initialized rather than constructed.
+static Benchmark *first_ = NULL;
+static Benchmark *last_ = NULL;
+
+Benchmark *registered() {
+  return first_;
+}
+
+void register_a_benchmark(Benchmark *benchmark) {
+  yeti_assert_debug(benchmark != NULL);
+  yeti_assert_debug(benchmark->next == NULL);
+
+  if (last_)
+    last_->next = benchmark;
+  else
+    first_ = benchmark;
+
+  last_ = benchmark;
+}
+
+} // benchmarks
+} // yeti
@@ -0,0 +1,349 @@
+//===-- yeti/benchmarks/containers.cc -------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+// Compared against.
+#include <deque>
+#include <list>
+#include <stack>
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Number of slots in maps. Load factors are relative to this.
+  static const u32 MAP_CAPACITY = 4096;
+
+  // Map types compared against one another.
+  typedef core::Map<u32, u32> Map;
+  typedef core::FlatMap<u32, u32> FlatMap;
+
+  // Number of elements pushed then popped per iteration.
+  static const u32 QUEUE_CAPACITY = 1024;
+
+  // Number of elements pushed then popped per iteration.
+  static const u32 SEQUENCE_LENGTH = 4096;
+
+  // Number of bits in bitsets. Densities are relative to this.
+  static const u32 BITSET_SIZE = 65536;
+
+  static void array_push(State &state, const u32 n) {
+    while (state.running()) {
+      core::Array<u32> array(core::global_heap_allocator());
+
+      for (u32 i = 0; i < n; ++i)
+        array.push(i);
+
+      keep(array[n - 1]);
+    }
+
+    state.set_items_processed(state.iterations() * n);
+  }
+
+  // Distinct, non-zero, and scattered so probing isn't trivially sequential.
+  static u32 key_for_index(const u32 index) {
+    return (index + 1) * 2654435761u;
+  }
+
+  template <typename M>
+  static void map_insert(State &state, const u32 load) {
+    const u32 n = (MAP_CAPACITY * load) / 100;
+
+    M map(core::global_heap_allocator(), MAP_CAPACITY);
+
+    while (state.running()) {
+      state.pause();
+      map.clear();
+      state.resume();
+
+      for (u32 i = 0; i < n; ++i)
+        map.insert(key_for_index(i), i);
+    }
+
+    state.set_items_processed(state.iterations() * n);
+  }
+
+  template <typename M>
+  static void map_find(State &state, const u32 load) {
+    const u32 n = (MAP_CAPACITY * load) / 100;
+
+    M map(core::global_heap_allocator(), MAP_CAPACITY);
+
+    for (u32 i = 0; i < n; ++i)
+      map.insert(key_for_index(i), i);
+
+    while (state.running()) {
+      u32 sum = 0;
+
+      for (u32 i = 0; i < n; ++i)
+        sum += *map.find(key_for_index(i));
+
+      keep(sum);
+    }
+
+    state.set_items_processed(state.iterations() * n);
+  }
+
+  template <typename M>
+  static void map_remove(State &state, const u32 load) {
+    const u32 n = (MAP_CAPACITY * load) / 100;
+
+    M map(core::global_heap_allocator(), MAP_CAPACITY);
+
+    while (state.running()) {
+      state.pause();
+
+      map.clear();
+
+      for (u32 i = 0; i < n; ++i)
+        map.insert(key_for_index(i), i);
+
+      state.resume();
+
+      for (u32 i = 0; i < n; ++i)
+        map.remove(key_for_index(i));
+    }
+
+    state.set_items_processed(state.iterations() * n);
+  }
+
+  // Works with `core::Dequeue` and `std::deque` alike.
+  template <typename D>
+  static void dequeue_fifo(State &state, D &dequeue) {
+    while (state.running()) {
+      for (u32 i = 0; i < SEQUENCE_LENGTH; ++i)
+        dequeue.push_back(i);
+
+      u32 sum = 0;
+
+      for (u32 i = 0; i < SEQUENCE_LENGTH; ++i) {
+        sum += dequeue.front();
+        dequeue.pop_front();
+      }
+
+      keep(sum);
+    }
+
+    state.set_items_processed(state.iterations() * SEQUENCE_LENGTH);
+  }
+
+  template <typename D>
+  static void dequeue_both_ends(State &state, D &dequeue) {
+    while (state.running()) {
+      for (u32 i = 0; i < SEQUENCE_LENGTH; i += 2) {
+        dequeue.push_front(i);
+        dequeue.push_back(i);
+      }
+
+      u32 sum = 0;
+
+      for (u32 i = 0; i < SEQUENCE_LENGTH; i += 2) {
+        sum += dequeue.front() + dequeue.back();
+        dequeue.pop_front();
+        dequeue.pop_back();
+      }
+
+      keep(sum);
+    }
+
+    state.set_items_processed(state.iterations() * SEQUENCE_LENGTH);
+  }
+
+  struct Linked : public core::list::Node<> {
+    u32 value;
+  };
+
+  // Works with `core::Stack` and `std::stack` alike.
+  template <typename S>
+  static void stack_push_pop(State &state, S &stack) {
+    while (state.running()) {
+      for (u32 i = 0; i < SEQUENCE_LENGTH; ++i)
+        stack.push(i);
+
+      u32 sum = 0;
+
+      for (u32 i = 0; i < SEQUENCE_LENGTH; ++i) {
+        sum += stack.top();
+        stack.pop();
+      }
+
+      keep(sum);
+    }
+
+    state.set_items_processed(state.iterations() * SEQUENCE_LENGTH);
+  }
+
+  // Sets roughly @density percent of bits, scattered.
+  static void populate(core::Bitset &bitset, const u32 density) {
+    for (u32 i = 0; i < BITSET_SIZE; ++i)
+      if ((key_for_index(i) >> 16) % 100 < density)
+        bitset.set(i);
+  }
+
+  static void bitset_scan(State &state, const u32 density) {
+    core::Bitset bitset(core::global_heap_allocator(), BITSET_SIZE);
+    populate(bitset, density);
+
+    core::Array<u32> indices(core::global_heap_allocator(), BITSET_SIZE);
+
+    while (state.running())
+      keep(bitset.scan(indices.raw()));
+
+    state.set_items_processed(state.iterations() * BITSET_SIZE);
+  }
+
+  static void bitset_find_next_set(State &state, const u32 density) {
+    core::Bitset bitset(core::global_heap_allocator(), BITSET_SIZE);
+    populate(bitset, density);
+
+    while (state.running()) {
+      size_t sum = 0;
+
+      for (size_t i = bitset.find_next_set(); i != core::bitset::NONE; i = bitset.find_next_set(i + 1))
+        sum += i;
+
+      keep(sum);
+    }
+
+    state.set_items_processed(state.iterations() * BITSET_SIZE);
+  }
+}
+
+YETI_BENCHMARK(array_push_1k) { array_push(state, 1024); }
+YETI_BENCHMARK(array_push_16k) { array_push(state, 16384); }
+
+YETI_BENCHMARK(map_insert_25) { map_insert<Map>(state, 25); }
+YETI_BENCHMARK(map_insert_50) { map_insert<Map>(state, 50); }
+YETI_BENCHMARK(map_insert_75) { map_insert<Map>(state, 75); }
+
+YETI_BENCHMARK(map_find_25) { map_find<Map>(state, 25); }
+YETI_BENCHMARK(map_find_50) { map_find<Map>(state, 50); }
+YETI_BENCHMARK(map_find_75) { map_find<Map>(state, 75); }
+
+YETI_BENCHMARK(map_remove_25) { map_remove<Map>(state, 25); }
+YETI_BENCHMARK(map_remove_50) { map_remove<Map>(state, 50); }
+YETI_BENCHMARK(map_remove_75) { map_remove<Map>(state, 75); }
+
+YETI_BENCHMARK(flat_map_insert_25) { map_insert<FlatMap>(state, 25); }
+YETI_BENCHMARK(flat_map_insert_50) { map_insert<FlatMap>(state, 50); }
+YETI_BENCHMARK(flat_map_insert_75) { map_insert<FlatMap>(state, 75); }
+
+YETI_BENCHMARK(flat_map_find_25) { map_find<FlatMap>(state, 25); }
+YETI_BENCHMARK(flat_map_find_50) { map_find<FlatMap>(state, 50); }
+YETI_BENCHMARK(flat_map_find_75) { map_find<FlatMap>(state, 75); }
+
+YETI_BENCHMARK(flat_map_remove_25) { map_remove<FlatMap>(state, 25); }
+YETI_BENCHMARK(flat_map_remove_50) { map_remove<FlatMap>(state, 50); }
+YETI_BENCHMARK(flat_map_remove_75) { map_remove<FlatMap>(state, 75); }
+
+YETI_BENCHMARK(dequeue_fifo) {
+  core::Dequeue<u32> dequeue(core::global_heap_allocator());
+  dequeue_fifo(state, dequeue);
+}
+
+YETI_BENCHMARK(std_deque_fifo) {
+  std::deque<u32> dequeue;
+  dequeue_fifo(state, dequeue);
+}
+
+YETI_BENCHMARK(dequeue_both_ends) {
+  core::Dequeue<u32> dequeue(core::global_heap_allocator());
+  dequeue_both_ends(state, dequeue);
+}
+
+YETI_BENCHMARK(std_deque_both_ends) {
+  std::deque<u32> dequeue;
+  dequeue_both_ends(state, dequeue);
+}
+
+YETI_BENCHMARK(list_push_walk_pop) {
+  // Elements are owned elsewhere, so linking never allocates.
+  core::Array<Linked> elements(core::global_heap_allocator(), SEQUENCE_LENGTH);
+  core::List<Linked> list;
+
+  while (state.running()) {
+    for (u32 i = 0; i < SEQUENCE_LENGTH; ++i) {
+      elements[i].value = i;
+      list.push_back(&elements[i]);
+    }
+
+    u32 sum = 0;
+
+    for (const Linked *element = list.first(); element; element = list.next(element))
+      sum += element->value;
+
+    while (list.pop_front());
+
+    keep(sum);
+  }
+
+  state.set_items_processed(state.iterations() * SEQUENCE_LENGTH);
+}
+
+YETI_BENCHMARK(std_list_push_walk_pop) {
+  std::list<u32> list;
+
+  while (state.running()) {
+    for (u32 i = 0; i < SEQUENCE_LENGTH; ++i)
+      list.push_back(i);
+
+    u32 sum = 0;
+
+    for (std::list<u32>::const_iterator I = list.begin(); I != list.end(); ++I)
+      sum += *I;
+
+    while (!list.empty())
+      list.pop_front();
+
+    keep(sum);
+  }
+
+  state.set_items_processed(state.iterations() * SEQUENCE_LENGTH);
+}
+
+YETI_BENCHMARK(stack_push_pop) {
+  core::Stack<u32> stack(core::global_heap_allocator(), SEQUENCE_LENGTH);
+  stack_push_pop(state, stack);
+}
+
+YETI_BENCHMARK(std_stack_push_pop) {
+  std::stack<u32> stack;
+  stack_push_pop(state, stack);
+}
+
+YETI_BENCHMARK(bitset_scan_1) { bitset_scan(state, 1); }
+YETI_BENCHMARK(bitset_scan_10) { bitset_scan(state, 10); }
+YETI_BENCHMARK(bitset_scan_50) { bitset_scan(state, 50); }
+
+YETI_BENCHMARK(bitset_find_next_set_1) { bitset_find_next_set(state, 1); }
+YETI_BENCHMARK(bitset_find_next_set_10) { bitset_find_next_set(state, 10); }
+YETI_BENCHMARK(bitset_find_next_set_50) { bitset_find_next_set(state, 50); }
+
+
+YETI_BENCHMARK(queue_push_pop) {
+  core::Queue<u32> queue(core::global_heap_allocator(), QUEUE_CAPACITY);
+
+  u32 element;
+
+  while (state.running()) {
+    for (u32 i = 0; i < QUEUE_CAPACITY; ++i)
+      queue.push(i);
+
+    while (queue.pop(&element))
+      keep(element);
+  }
+
+  state.set_items_processed(state.iterations() * QUEUE_CAPACITY);
+}
+
+} // benchmarks
+} // yeti
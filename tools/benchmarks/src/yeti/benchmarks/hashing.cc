@@ -0,0 +1,62 @@
+//===-- yeti/benchmarks/hashing.cc ----------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Largest buffer hashed.
+  static const u32 MAXIMUM_LENGTH_OF_BUFFER = 4096;
+
+  // Adapts hash functions to a common signature.
+  typedef u64 (*Hasher)(const void *buf, u32 buf_len);
+
+  static u64 fnv1a_32(const void *buf, u32 buf_len) { return core::fnv1a_hash_32(buf, buf_len); }
+  static u64 fnv1a_64(const void *buf, u32 buf_len) { return core::fnv1a_hash_64(buf, buf_len); }
+  static u64 murmur_32(const void *buf, u32 buf_len) { return core::murmur_hash_32(buf, buf_len); }
+  static u64 murmur_64(const void *buf, u32 buf_len) { return core::murmur_hash_64(buf, buf_len); }
+
+  static void hash(State &state, Hasher hasher, const u32 length) {
+    yeti_assert_debug(length <= MAXIMUM_LENGTH_OF_BUFFER);
+
+    u8 buffer[MAXIMUM_LENGTH_OF_BUFFER];
+
+    Random random;
+    for (u32 i = 0; i < length; ++i)
+      buffer[i] = (u8)random.next();
+
+    while (state.running())
+      keep(hasher((const void *)&buffer[0], length));
+
+    state.set_bytes_processed(state.iterations() * length);
+  }
+}
+
+YETI_BENCHMARK(fnv1a_32_16) { hash(state, &fnv1a_32, 16); }
+YETI_BENCHMARK(fnv1a_32_256) { hash(state, &fnv1a_32, 256); }
+YETI_BENCHMARK(fnv1a_32_4096) { hash(state, &fnv1a_32, 4096); }
+
+YETI_BENCHMARK(fnv1a_64_16) { hash(state, &fnv1a_64, 16); }
+YETI_BENCHMARK(fnv1a_64_256) { hash(state, &fnv1a_64, 256); }
+YETI_BENCHMARK(fnv1a_64_4096) { hash(state, &fnv1a_64, 4096); }
+
+YETI_BENCHMARK(murmur_32_16) { hash(state, &murmur_32, 16); }
+YETI_BENCHMARK(murmur_32_256) { hash(state, &murmur_32, 256); }
+YETI_BENCHMARK(murmur_32_4096) { hash(state, &murmur_32, 4096); }
+
+YETI_BENCHMARK(murmur_64_16) { hash(state, &murmur_64, 16); }
+YETI_BENCHMARK(murmur_64_256) { hash(state, &murmur_64, 256); }
+YETI_BENCHMARK(murmur_64_4096) { hash(state, &murmur_64, 4096); }
+
+} // benchmarks
+} // yeti
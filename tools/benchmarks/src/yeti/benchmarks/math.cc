@@ -0,0 +1,246 @@
+//===-- yeti/benchmarks/math.cc -------------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+#include "yeti/math.h"
+#include "yeti/math/batch.h"
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Number of values operated on per iteration. Small enough to stay in
+  // cache, so we measure arithmetic rather than memory bandwidth.
+  static const u32 NUM_OF_VALUES = 1024;
+
+  static Quaternion random_rotation(Random &random) {
+    return Quaternion(random.next(-1.f, 1.f),
+                      random.next(-1.f, 1.f),
+                      random.next(-1.f, 1.f),
+                      random.next(-1.f, 1.f)).normalize();
+  }
+
+  static Vec3 random_vector(Random &random, const f32 min, const f32 max) {
+    return Vec3(random.next(min, max),
+                random.next(min, max),
+                random.next(min, max));
+  }
+
+  // Fills @poses with affine transformations with non-uniform scale.
+  static void random_poses(Random &random, Mat4 *poses, const u32 n) {
+    for (u32 i = 0; i < n; ++i)
+      poses[i] = Mat4::compose(random_vector(random, -100.f, 100.f),
+                               random_rotation(random),
+                               random_vector(random, 0.5f, 2.f));
+  }
+
+  // Fills @poses with rigid transformations.
+  static void random_rigid_poses(Random &random, Mat4 *poses, const u32 n) {
+    for (u32 i = 0; i < n; ++i)
+      poses[i] = Mat4::compose(random_vector(random, -100.f, 100.f),
+                               random_rotation(random),
+                               Vec3(1.f, 1.f, 1.f));
+  }
+}
+
+YETI_BENCHMARK(mat4_multiply) {
+  core::Array<Mat4> a(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> b(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> c(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_poses(random, &a[0], NUM_OF_VALUES);
+  random_poses(random, &b[0], NUM_OF_VALUES);
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      c[i] = a[i] * b[i];
+    keep(c[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_inverse) {
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> inverses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_poses(random, &poses[0], NUM_OF_VALUES);
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      inverses[i] = poses[i].inverse();
+    keep(inverses[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_inverse_affine) {
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> inverses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_poses(random, &poses[0], NUM_OF_VALUES);
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      inverses[i] = poses[i].inverse_affine();
+    keep(inverses[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_inverse_rigid) {
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> inverses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_rigid_poses(random, &poses[0], NUM_OF_VALUES);
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      inverses[i] = poses[i].inverse_rigid();
+    keep(inverses[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_compose) {
+  core::Array<Vec3> positions(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> rotations(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Vec3> scales(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+
+  for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+    positions[i] = random_vector(random, -100.f, 100.f);
+    rotations[i] = random_rotation(random);
+    scales[i] = random_vector(random, 0.5f, 2.f);
+  }
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      poses[i] = Mat4::compose(positions[i], rotations[i], scales[i]);
+    keep(poses[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_compose_batched) {
+  core::Array<Vec3> positions(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> rotations(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Vec3> scales(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+
+  for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+    positions[i] = random_vector(random, -100.f, 100.f);
+    rotations[i] = random_rotation(random);
+    scales[i] = random_vector(random, 0.5f, 2.f);
+  }
+
+  while (state.running()) {
+    batch::compose(&positions[0], &rotations[0], &scales[0], &poses[0], NUM_OF_VALUES);
+    keep(poses[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_decompose) {
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_poses(random, &poses[0], NUM_OF_VALUES);
+
+  Vec3 position, scale;
+  Quaternion rotation;
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+      Mat4::decompose(poses[i], &position, &rotation, &scale);
+      keep(rotation);
+    }
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(mat4_decompose_affine) {
+  core::Array<Mat4> poses(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+  random_poses(random, &poses[0], NUM_OF_VALUES);
+
+  Vec3 position, scale;
+  Quaternion rotation;
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+      Mat4::decompose_affine(poses[i], &position, &rotation, &scale);
+      keep(rotation);
+    }
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(quaternion_slerp) {
+  core::Array<Quaternion> a(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> b(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> c(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+
+  for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+    a[i] = random_rotation(random);
+    b[i] = random_rotation(random);
+  }
+
+  while (state.running()) {
+    for (u32 i = 0; i < NUM_OF_VALUES; ++i)
+      c[i] = Quaternion::slerp(a[i], b[i], 0.25f);
+    keep(c[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+YETI_BENCHMARK(quaternion_slerp_batched) {
+  core::Array<Quaternion> a(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> b(core::global_heap_allocator(), NUM_OF_VALUES);
+  core::Array<Quaternion> c(core::global_heap_allocator(), NUM_OF_VALUES);
+
+  Random random;
+
+  for (u32 i = 0; i < NUM_OF_VALUES; ++i) {
+    a[i] = random_rotation(random);
+    b[i] = random_rotation(random);
+  }
+
+  while (state.running()) {
+    batch::slerp(&a[0], &b[0], 0.25f, &c[0], NUM_OF_VALUES);
+    keep(c[0]);
+  }
+
+  state.set_items_processed(state.iterations() * NUM_OF_VALUES);
+}
+
+} // benchmarks
+} // yeti
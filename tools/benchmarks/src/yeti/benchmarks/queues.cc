@@ -0,0 +1,169 @@
+//===-- yeti/benchmarks/queues.cc -----------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Number of elements pushed then popped per iteration when uncontended.
+  static const u32 NUM_OF_ELEMENTS_UNCONTENDED = 1024;
+
+  // Number of elements transferred between threads per iteration.
+  static const u32 NUM_OF_ELEMENTS_TRANSFERRED = 65536;
+
+  // Kept small so producers and consumers regularly find queues full and
+  // empty, which is where things go wrong.
+  static const u32 SIZE_OF_CONTENDED_QUEUES = 256;
+
+  template <typename Q>
+  static void push_pop(State &state) {
+    Q queue(core::global_heap_allocator(), NUM_OF_ELEMENTS_UNCONTENDED);
+
+    u32 element;
+
+    while (state.running()) {
+      for (u32 i = 0; i < NUM_OF_ELEMENTS_UNCONTENDED; ++i)
+        queue.push(i);
+
+      while (queue.pop(&element))
+        keep(element);
+    }
+
+    state.set_items_processed(state.iterations() * NUM_OF_ELEMENTS_UNCONTENDED);
+  }
+
+  template <typename Q>
+  struct Producer {
+    Q *queue;
+
+    // Pushes [first, first + count).
+    u32 first;
+    u32 count;
+  };
+
+  template <typename Q>
+  struct Consumer {
+    Q *queue;
+
+    // Pops exactly this many.
+    u32 count;
+
+    // Checked once joined.
+    u64 sum;
+    bool ordered;
+  };
+
+  template <typename Q>
+  static void produce(void *argument) {
+    Producer<Q> *producer = (Producer<Q> *)argument;
+
+    for (u32 element = producer->first; element < producer->first + producer->count; ++element)
+      while (!producer->queue->push(element))
+        core::Thread::yield();
+  }
+
+  template <typename Q>
+  static void consume(void *argument) {
+    Consumer<Q> *consumer = (Consumer<Q> *)argument;
+
+    u64 sum = 0;
+    bool ordered = true;
+
+    u32 previous = 0;
+
+    for (u32 popped = 0; popped < consumer->count; ++popped) {
+      u32 element;
+
+      while (!consumer->queue->pop(&element))
+        core::Thread::yield();
+
+      // Only meaningful with a single producer.
+      ordered &= (element > previous);
+      previous = element;
+
+      sum += element;
+    }
+
+    consumer->sum = sum;
+    consumer->ordered = ordered;
+  }
+
+  // Transfers elements from @P producers to @C consumers through a queue of
+  // type @Q, checking that every element makes it through exactly once.
+  template <typename Q, u32 P, u32 C>
+  static void transfer(State &state) {
+    Q queue(core::global_heap_allocator(), SIZE_OF_CONTENDED_QUEUES);
+
+    Producer<Q> producers[P];
+    Consumer<Q> consumers[C];
+
+    core::Thread *threads[P + C];
+
+    const u32 per_producer = NUM_OF_ELEMENTS_TRANSFERRED / P;
+    const u32 per_consumer = NUM_OF_ELEMENTS_TRANSFERRED / C;
+
+    const u64 n = (u64)per_producer * P;
+    const u64 expected = (n * (n + 1)) / 2;
+
+    while (state.running()) {
+      for (u32 i = 0; i < C; ++i) {
+        consumers[i].queue = &queue;
+        consumers[i].count = per_consumer;
+        threads[P + i] = core::Thread::spawn(&consume<Q>, (void *)&consumers[i]);
+      }
+
+      for (u32 i = 0; i < P; ++i) {
+        producers[i].queue = &queue;
+        // Start at one so the first element popped is always in order.
+        producers[i].first = 1 + i * per_producer;
+        producers[i].count = per_producer;
+        threads[i] = core::Thread::spawn(&produce<Q>, (void *)&producers[i]);
+      }
+
+      for (u32 i = 0; i < P + C; ++i)
+        threads[i]->join();
+
+      u64 sum = 0;
+      for (u32 i = 0; i < C; ++i)
+        sum += consumers[i].sum;
+
+      yeti_assert_with_reason(sum == expected,
+                              "Elements were lost or duplicated in transit.");
+
+      if (P == 1 && C == 1)
+        yeti_assert_with_reason(consumers[0].ordered,
+                                "Elements were reordered in transit.");
+
+      yeti_assert_with_reason(queue.empty(),
+                              "Elements were left behind.");
+    }
+
+    state.set_items_processed(state.iterations() * n);
+  }
+
+  typedef core::SpscQueue<u32> SpscQueue;
+  typedef core::MpmcQueue<u32> MpmcQueue;
+}
+
+YETI_BENCHMARK(spsc_queue_push_pop) { push_pop<SpscQueue>(state); }
+YETI_BENCHMARK(mpmc_queue_push_pop) { push_pop<MpmcQueue>(state); }
+
+YETI_BENCHMARK(spsc_queue_transfer_1x1) { transfer<SpscQueue, 1, 1>(state); }
+
+YETI_BENCHMARK(mpmc_queue_transfer_1x1) { transfer<MpmcQueue, 1, 1>(state); }
+YETI_BENCHMARK(mpmc_queue_transfer_4x1) { transfer<MpmcQueue, 4, 1>(state); }
+YETI_BENCHMARK(mpmc_queue_transfer_1x4) { transfer<MpmcQueue, 1, 4>(state); }
+YETI_BENCHMARK(mpmc_queue_transfer_4x4) { transfer<MpmcQueue, 4, 4>(state); }
+
+} // benchmarks
+} // yeti
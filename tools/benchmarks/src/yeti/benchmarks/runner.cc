@@ -0,0 +1,285 @@
+//===-- yeti/benchmarks/runner.cc -----------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/runner.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Upper bound on the number of samples taken per benchmark.
+  static const u32 MAXIMUM_SAMPLES = 64;
+
+  static void writef(core::File *file, const char *format, ...) {
+    char buffer[512];
+
+    va_list ap;
+    va_start(ap, format);
+    const int length = vsnprintf(&buffer[0], sizeof(buffer), format, ap);
+    va_end(ap);
+
+    yeti_assert_debug(length >= 0 && length < (int)sizeof(buffer));
+
+    core::fs::write(file, (const void *)&buffer[0], length);
+  }
+}
+
+Runner::Runner()
+  : filter_(NULL)
+  , output_(NULL)
+  , baseline_(NULL)
+  , threshold_(5.0)
+  , samples_(10)
+  , minimum_(20000000ull)
+  , baselines_(core::global_heap_allocator())
+{
+  YETI_NEW(core::log::ConsoleBackend, core::global_heap_allocator())();
+}
+
+Runner::~Runner() {
+}
+
+void Runner::setup(const char *args[], const u32 num_args) {
+  for (const char **arg = &args[0], **end = &args[num_args]; arg < end; ++arg) {
+    if ((strcmp(*arg, "--filter") == 0) && (arg + 1 < end))
+      filter_ = *++arg;
+    else if ((strcmp(*arg, "--output") == 0) && (arg + 1 < end))
+      output_ = *++arg;
+    else if ((strcmp(*arg, "--baseline") == 0) && (arg + 1 < end))
+      baseline_ = *++arg;
+    else if ((strcmp(*arg, "--threshold") == 0) && (arg + 1 < end))
+      threshold_ = strtod(*++arg, NULL);
+    else if ((strcmp(*arg, "--samples") == 0) && (arg + 1 < end))
+      samples_ = (u32)strtoul(*++arg, NULL, 10);
+    else if ((strcmp(*arg, "--minimum-time") == 0) && (arg + 1 < end))
+      minimum_ = strtoull(*++arg, NULL, 10) * 1000000ull;
+    else
+      core::logf(core::log::GENERAL, core::log::WARNING, "Passed unknown command-line argument `%s`.", *arg);
+  }
+
+  if (samples_ < 1 || samples_ > MAXIMUM_SAMPLES) {
+    core::logf(core::log::GENERAL, core::log::WARNING, "Number of samples must be between 1 and %u.", MAXIMUM_SAMPLES);
+    samples_ = core::utility::clamp(samples_, 1u, MAXIMUM_SAMPLES);
+  }
+
+  if (baseline_)
+    if (!this->load(baseline_))
+      core::logf(core::log::GENERAL, core::log::WARNING, "Could not load baseline from `%s`.", baseline_);
+}
+
+u32 Runner::run() {
+  core::Array<Result> results(core::global_heap_allocator());
+
+  u32 regressions = 0;
+
+  for (const Benchmark *benchmark = registered(); benchmark; benchmark = benchmark->next) {
+    if (filter_ && !strstr(benchmark->name, filter_))
+      continue;
+
+    Result result;
+    this->measure(benchmark, &result);
+
+    const Baseline *baseline = NULL;
+
+    for (const Baseline *candidate = baselines_.begin(); candidate != baselines_.end(); ++candidate) {
+      if (strcmp(candidate->name, benchmark->name) == 0) {
+        baseline = candidate;
+        break;
+      }
+    }
+
+    if (this->report(result, baseline))
+      regressions += 1;
+
+    results.push(result);
+  }
+
+  if (output_)
+    if (!this->save(output_, results))
+      core::logf(core::log::GENERAL, core::log::ERROR, "Could not save results to `%s`.", output_);
+
+  if (regressions)
+    core::logf(core::log::GENERAL, core::log::WARNING, "%u benchmark(s) regressed by more than %.1f%%.", regressions, threshold_);
+
+  return regressions;
+}
+
+void Runner::measure(const Benchmark *benchmark, Result *result) const {
+  // Calibrate, which has the nice side-effect of warming caches.
+  u64 iterations = 1;
+
+  for (;;) {
+    State state(iterations);
+    benchmark->function(state);
+
+    const u64 elapsed = state.elapsed();
+
+    if (elapsed >= minimum_)
+      break;
+
+    // Aim to overshoot slightly, but grow by no more than an order of
+    // magnitude at a time in case of noise.
+    const u64 estimate = elapsed ? (u64)((f64)iterations * 1.4 * (f64)minimum_ / (f64)elapsed) : 0;
+
+    iterations = core::utility::clamp(estimate, iterations * 2, iterations * 10);
+  }
+
+  f64 times[MAXIMUM_SAMPLES];
+
+  u64 items = 0;
+  u64 bytes = 0;
+
+  for (u32 sample = 0; sample < samples_; ++sample) {
+    State state(iterations);
+    benchmark->function(state);
+
+    times[sample] = (f64)state.elapsed() / (f64)iterations;
+
+    items = state.items();
+    bytes = state.bytes();
+  }
+
+  // Sort so we can pick out the median.
+  for (u32 i = 1; i < samples_; ++i)
+    for (u32 j = i; j > 0 && times[j - 1] > times[j]; --j) {
+      const f64 time = times[j];
+      times[j] = times[j - 1];
+      times[j - 1] = time;
+    }
+
+  f64 sum = 0.0;
+  for (u32 sample = 0; sample < samples_; ++sample)
+    sum += times[sample];
+
+  result->name = benchmark->name;
+
+  result->iterations = iterations;
+  result->samples = samples_;
+
+  result->minimum = times[0];
+  result->maximum = times[samples_ - 1];
+  result->mean = sum / samples_;
+  result->median = (samples_ % 2) ? times[samples_ / 2]
+                                  : (times[samples_ / 2 - 1] + times[samples_ / 2]) * 0.5;
+
+  const f64 iterations_per_second = (result->median > 0.0) ? 1e9 / result->median : 0.0;
+
+  result->items_per_second = ((f64)items / (f64)iterations) * iterations_per_second;
+  result->bytes_per_second = ((f64)bytes / (f64)iterations) * iterations_per_second;
+}
+
+bool Runner::report(const Result &result, const Baseline *baseline) const {
+  char throughput[32] = { 0, };
+
+  if (result.bytes_per_second > 0.0)
+    sprintf(&throughput[0], "%10.2f MiB/s", result.bytes_per_second / (1024.0 * 1024.0));
+  else if (result.items_per_second > 0.0)
+    sprintf(&throughput[0], "%10.2f M/s", result.items_per_second / 1e6);
+
+  if (!baseline) {
+    printf("%-40s %14.2f ns %20s\n", result.name, result.median, &throughput[0]);
+    return false;
+  }
+
+  const f64 change = ((result.median - baseline->median) / baseline->median) * 100.0;
+
+  const bool regressed = (change > threshold_);
+  const bool improved = (change < -threshold_);
+
+  printf("%-40s %14.2f ns %20s %+8.1f%% %s\n",
+         result.name, result.median, &throughput[0], change,
+         regressed ? "(regressed)" : (improved ? "(improved)" : ""));
+
+  return regressed;
+}
+
+bool Runner::load(const char *path) {
+  core::File *file = core::fs::open(path, core::File::READ);
+
+  if (!file)
+    return false;
+
+  core::Array<u8> buffer(core::global_heap_allocator());
+  core::fs::read_into_buffer(file, buffer);
+  core::fs::close(file);
+
+  // So we can treat it as a string.
+  buffer.push(0);
+
+  // We only ever load what we save, so rather than parse JSON we pick out
+  // names and medians, which always appear in that order.
+  static const char NAME[] = "\"name\": \"";
+  static const char MEDIAN[] = "\"median\": ";
+
+  const char *cursor = (const char *)&buffer[0];
+
+  while ((cursor = strstr(cursor, NAME)) != NULL) {
+    const char *name = cursor + sizeof(NAME) - 1;
+    const char *end_of_name = strchr(name, '"');
+
+    if (!end_of_name)
+      return false;
+
+    const char *median = strstr(end_of_name, MEDIAN);
+
+    if (!median)
+      return false;
+
+    Baseline baseline;
+
+    const size_t length = core::utility::min((size_t)(end_of_name - name), sizeof(baseline.name) - 1);
+    core::memory::copy((const void *)name, (void *)&baseline.name[0], length);
+    baseline.name[length] = '\0';
+
+    baseline.median = strtod(median + sizeof(MEDIAN) - 1, (char **)&cursor);
+
+    baselines_.push(baseline);
+  }
+
+  return true;
+}
+
+bool Runner::save(const char *path, const core::Array<Result> &results) const {
+  core::File *file = core::fs::create_or_open(path, core::File::WRITE);
+
+  if (!file)
+    return false;
+
+  writef(file, "{\n  \"benchmarks\": [\n");
+
+  for (const Result *result = results.begin(); result != results.end(); ++result) {
+    writef(file, "    {\n");
+    writef(file, "      \"name\": \"%s\",\n", result->name);
+    writef(file, "      \"iterations\": %llu,\n", (unsigned long long)result->iterations);
+    writef(file, "      \"samples\": %u,\n", result->samples);
+    writef(file, "      \"minimum\": %.3f,\n", result->minimum);
+    writef(file, "      \"median\": %.3f,\n", result->median);
+    writef(file, "      \"mean\": %.3f,\n", result->mean);
+    writef(file, "      \"maximum\": %.3f,\n", result->maximum);
+    writef(file, "      \"items_per_second\": %.3f,\n", result->items_per_second);
+    writef(file, "      \"bytes_per_second\": %.3f\n", result->bytes_per_second);
+    writef(file, (result + 1 != results.end()) ? "    },\n" : "    }\n");
+  }
+
+  writef(file, "  ]\n}\n");
+
+  core::fs::close(file);
+
+  return true;
+}
+
+} // benchmarks
+} // yeti
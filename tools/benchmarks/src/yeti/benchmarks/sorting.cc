@@ -0,0 +1,108 @@
+//===-- yeti/benchmarks/sorting.cc ----------------------*- mode: C++11 -*-===//
+//
+//                             __ __     _   _
+//                            |  |  |___| |_|_|
+//                            |_   _| -_|  _| |
+//                              |_| |___|_| |_|
+//
+//       This file is distributed under the terms described in LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "yeti/benchmarks/benchmark.h"
+
+// Compared against.
+#include <algorithm>
+
+namespace yeti {
+namespace benchmarks {
+
+namespace {
+  // Number of keys sorted per iteration.
+  static const u32 NUM_OF_KEYS = 1048576;
+
+  // Adapts radix sorts to a common signature.
+  template <typename K>
+  struct Sorter {
+    typedef void (*Fn)(K *keys, u32 *values, K *keys_scratch, u32 *values_scratch, size_t n);
+  };
+
+  template <typename K>
+  static K random_key(Random &random) {
+    return (K)(((u64)random.next() << 32) | random.next());
+  }
+
+  template <typename K>
+  static void radix_sort(State &state, typename Sorter<K>::Fn sorter) {
+    core::Array<K> unsorted(core::global_heap_allocator(), NUM_OF_KEYS);
+    core::Array<K> keys(core::global_heap_allocator(), NUM_OF_KEYS);
+    core::Array<K> keys_scratch(core::global_heap_allocator(), NUM_OF_KEYS);
+    core::Array<u32> values(core::global_heap_allocator(), NUM_OF_KEYS);
+    core::Array<u32> values_scratch(core::global_heap_allocator(), NUM_OF_KEYS);
+
+    Random random;
+    for (u32 i = 0; i < NUM_OF_KEYS; ++i)
+      unsorted[i] = random_key<K>(random);
+
+    while (state.running()) {
+      state.pause();
+
+      core::memory::copy((const void *)unsorted.begin(), (void *)keys.begin(), NUM_OF_KEYS * sizeof(K));
+
+      for (u32 i = 0; i < NUM_OF_KEYS; ++i)
+        values[i] = i;
+
+      state.resume();
+
+      sorter(keys.begin(), values.begin(), keys_scratch.begin(), values_scratch.begin(), NUM_OF_KEYS);
+
+      keep(keys[0]);
+    }
+
+    state.set_items_processed(state.iterations() * NUM_OF_KEYS);
+  }
+
+  template <typename K>
+  struct Pair {
+    K key;
+    u32 value;
+
+    bool operator<(const Pair<K> &rhs) const { return key < rhs.key; }
+  };
+
+  template <typename K>
+  static void std_sort(State &state) {
+    core::Array< Pair<K> > unsorted(core::global_heap_allocator(), NUM_OF_KEYS);
+    core::Array< Pair<K> > pairs(core::global_heap_allocator(), NUM_OF_KEYS);
+
+    Random random;
+    for (u32 i = 0; i < NUM_OF_KEYS; ++i) {
+      unsorted[i].key = random_key<K>(random);
+      unsorted[i].value = i;
+    }
+
+    while (state.running()) {
+      state.pause();
+      core::memory::copy((const void *)unsorted.begin(), (void *)pairs.begin(), NUM_OF_KEYS * sizeof(Pair<K>));
+      state.resume();
+
+      std::sort(pairs.begin(), pairs.end());
+
+      keep(pairs[0].key);
+    }
+
+    state.set_items_processed(state.iterations() * NUM_OF_KEYS);
+  }
+}
+
+YETI_BENCHMARK(radix_sort_32) { radix_sort<u32>(state, &core::radix_sort); }
+YETI_BENCHMARK(radix_sort_64) { radix_sort<u64>(state, &core::radix_sort); }
+
+YETI_BENCHMARK(parallel_radix_sort_32) { radix_sort<u32>(state, &parallel::radix_sort); }
+YETI_BENCHMARK(parallel_radix_sort_64) { radix_sort<u64>(state, &parallel::radix_sort); }
+
+YETI_BENCHMARK(std_sort_32) { std_sort<u32>(state); }
+YETI_BENCHMARK(std_sort_64) { std_sort<u64>(state); }
+
+} // benchmarks
+} // yeti